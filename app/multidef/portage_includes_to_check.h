@@ -18,6 +18,7 @@ Please see the license file at the root of this repository, or at:
 // have it's own copy of the function
 
 #include "portage/accumulate/accumulate.h"
+#include "portage/accumulate/swarm_weights.h"
 
 #include "portage/distributed/mpi_bounding_boxes.h"
 #include "portage/distributed/mpi_particle_distribute.h"
@@ -39,6 +40,8 @@ Please see the license file at the root of this repository, or at:
 #include "portage/interpolate/interpolate_1st_order.h"
 #include "portage/interpolate/interpolate_2nd_order.h"
 #include "portage/interpolate/interpolate_nth_order.h"
+#include "portage/interpolate/remap_operator.h"
+#include "portage/interpolate/compressed_weights.h"
 
 #include "portage/intersect/dummy_interface_reconstructor.h"
 #include "portage/intersect/intersect_clipper.h"
@@ -47,19 +50,25 @@ Please see the license file at the root of this repository, or at:
 #include "portage/intersect/intersect_r2d.h"
 #include "portage/intersect/intersect_r3d.h"
 #include "portage/intersect/intersect_rNd.h"
+#include "portage/intersect/matpoly_cache.h"
+#include "portage/intersect/dual_cell_cache.h"
 
 #include "portage/search/BoundBox.h"
 #include "portage/search/kdtree.h"
 #include "portage/search/search_direct_product.h"
 #include "portage/search/search_kdtree.h"
+#include "portage/search/search_particle_parts.h"
 #include "portage/search/search_points_by_cells.h"
+#include "portage/search/search_points_knn.h"
 #include "portage/search/search_simple.h"
 #include "portage/search/search_simple_points.h"
 
 #include "portage/support/basis.h"
+#include "portage/support/bucket_sort.h"
 #include "portage/support/faceted_setup.h"
 #include "portage/support/mpi_collate.h"
 #include "portage/support/operator.h"
 #include "portage/support/portage.h"
+#include "portage/support/smoothing_lengths.h"
 #include "portage/support/timer.h"
 #include "portage/support/weight.h"
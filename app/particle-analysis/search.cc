@@ -0,0 +1,121 @@
+/*
+ * This file is part of the Ristra portage project.
+ * Please see the license file at the root of this repository, or at:
+ * https://github.com/laristra/portage/blob/master/LICENSE
+ */
+
+#include <chrono>
+#include <cstdio>
+
+#ifdef _OPENMP
+  #include <omp.h>
+#endif
+
+#include "wonton/support/wonton.h"
+#include "wonton/swarm/swarm.h"
+#include "portage/support/portage.h"
+#include "portage/search/search_points_by_cells.h"
+#include "portage/search/search_points_bins.h"
+
+#include "particles.h"
+#include "params.h"
+
+// aliases
+constexpr int dim = 2;
+using Extents = Wonton::vector<Wonton::Point<dim>>;
+using Bins = Portage::SearchPointsBins<dim, Wonton::Swarm<dim>, Wonton::Swarm<dim>>;
+using Cells = Portage::SearchPointsByCells<dim, Wonton::Swarm<dim>, Wonton::Swarm<dim>>;
+
+/**
+ * @brief Measure the build time of the swarm search grids.
+ *
+ * It reads the same input file as the remap analysis application and
+ * generates the source and target points the same way. It then builds
+ * the helper grids of 'SearchPointsBins' and 'SearchPointsByCells'
+ * several times and prints their mean build time. Since the bins are
+ * filled in parallel, thread scaling is measured by running it for an
+ * increasing number of threads, for instance:
+ *
+ *   for t in 1 2 4 8 16 32 64; do
+ *     OMP_NUM_THREADS=$t mpirun -np 1 ./particle-search input.json
+ *   done
+ *
+ * @param argc: arguments count
+ * @param argv: arguments values
+ * @return status code
+ */
+int main(int argc, char* argv[]) {
+
+  Params params;
+  if (not params.parse(argc, argv))
+    return EXIT_FAILURE;
+
+  auto source_swarm = particles::init(params.source.file,
+                                      params.source.size, params.source.distrib,
+                                      params.source.min, params.source.max,
+                                      params.source.span, params.source.width,
+                                      params.source.radius, params.source.center,
+                                      params.scale.coords, params.source.frame);
+
+  auto target_swarm = particles::init(params.target.file,
+                                      params.target.size, params.target.distrib,
+                                      params.target.min, params.target.max,
+                                      params.target.span, params.target.width,
+                                      params.target.radius, params.target.center,
+                                      params.scale.coords, params.target.frame);
+
+  int const num_source = source_swarm.num_particles();
+  int const num_target = target_swarm.num_particles();
+
+  auto const h = particles::mean_distance(target_swarm,
+                                          params.scale.smooth, params.target.distrib,
+                                          params.target.min, params.target.max,
+                                          params.scale.coords, params.target.radius,
+                                          params.target.span, params.target.width,
+                                          params.target.size);
+
+  Extents source_extents(num_source, Wonton::Point<dim>(h[0], h[1]));
+  Extents target_extents(num_target, Wonton::Point<dim>(h[0], h[1]));
+
+  int threads = 1;
+#ifdef _OPENMP
+  threads = omp_get_max_threads();
+#endif
+
+  // build a search kernel several times and return the mean time
+  int const repeat = 10;
+  auto measure = [&](auto&& build) {
+    auto const tic = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < repeat; ++i)
+      build();
+    auto const toc = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double>(toc - tic).count() / repeat;
+  };
+
+  double const time_bins = measure([&] {
+    Bins search(source_swarm, target_swarm, source_extents, target_extents,
+                Portage::WeightCenter::Gather);
+  });
+
+  double const time_gather = measure([&] {
+    Cells search(source_swarm, target_swarm, source_extents, target_extents,
+                 Portage::WeightCenter::Gather);
+  });
+
+  double const time_scatter = measure([&] {
+    Cells search(source_swarm, target_swarm, source_extents, target_extents,
+                 Portage::WeightCenter::Scatter);
+  });
+
+  if (params.mpi.rank == 0) {
+    std::printf("Search grids build for %d source and %d target points:\n",
+                num_source, num_target);
+    std::printf(" \u2022 threads: \e[32m%d\e[0m\n", threads);
+    std::printf(" \u2022 points bins: \e[32m%.4f s\e[0m\n", time_bins);
+    std::printf(" \u2022 points by cells, gather: \e[32m%.4f s\e[0m\n", time_gather);
+    std::printf(" \u2022 points by cells, scatter: \e[32m%.4f s\e[0m\n", time_scatter);
+  }
+
+  MPI_Finalize();
+  return EXIT_SUCCESS;
+}
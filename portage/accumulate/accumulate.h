@@ -8,7 +8,13 @@ Please see the license file at the root of this repository, or at:
 
 #include <vector>
 #include <memory>
+#include <array>
 #include <cassert>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
 
 // wonton includes
 #include "wonton/support/wonton.h"
@@ -17,6 +23,7 @@ Please see the license file at the root of this repository, or at:
 // portage includes
 #include "portage/support/portage.h"
 #include "portage/support/weight.h"
+#include "portage/support/smoothing_lengths.h"
 #include "portage/support/basis.h"
 #include "portage/support/operator.h"
 
@@ -46,6 +53,10 @@ enum WeightCenter {
  * 
  * This class does the meat of local regression. It computes weight functions, 
  * and the local regression corrections to those weights. 
+ *
+ * When all particles share the same kernel and geometry, which is the
+ * usual case, the weight evaluator is selected once on construction so
+ * that the weights of a target are computed by a loop specialized for them.
  */
 template<int dim,
          class SourceSwarm,
@@ -66,7 +77,26 @@ class Accumulate {
    * The parameters @code kernels@endcode, @code geometries@endcode and @code smoothing@endcode 
    * all must have the same length. If @code center@endcode is @code Gather@endcode, then 
    * the length is the size of the target swarm. If @code center@endcode is @code Scatter@endcode, 
-   * the length is the size of the source swarm.
+   * the length is the size of the source swarm. The smoothing lengths are
+   * referenced, not copied.
+   */
+  Accumulate(SourceSwarm const& source, TargetSwarm const& target,
+             EstimateType estimate, WeightCenter center,
+             Wonton::vector<Weight::Kernel> const& kernels,
+             Wonton::vector<Weight::Geometry> const& geometries,
+             SmoothingLengthArray const& smoothing,
+             basis::Type basis, oper::Type operator_spec = oper::LastOperator,
+             Wonton::vector<oper::Domain> const& operator_domain = {},
+             Wonton::vector<std::vector<Wonton::Point<dim>>> const& operator_data = {})
+    : Accumulate(source, target, estimate, center, kernels, geometries,
+                 &smoothing, nullptr, basis, operator_spec,
+                 operator_domain, operator_data) {}
+
+  /**
+   * @brief Constructor from nested smoothing lengths.
+   *
+   * They are converted to a flat array owned by the accumulator.
+   * @see the constructor above for the other parameters.
    */
   Accumulate(SourceSwarm const& source, TargetSwarm const& target,
              EstimateType estimate, WeightCenter center,
@@ -76,33 +106,10 @@ class Accumulate {
              basis::Type basis, oper::Type operator_spec = oper::LastOperator,
              Wonton::vector<oper::Domain> const& operator_domain = {},
              Wonton::vector<std::vector<Wonton::Point<dim>>> const& operator_data = {})
-    : source_(source),
-      target_(target),
-      estimate_(estimate),
-      center_(center),
-      kernels_(kernels),
-      geometries_(geometries),
-      smoothing_(smoothing),
-      basis_(basis),
-      operator_spec_(operator_spec),
-      operator_domain_(operator_domain),
-      operator_data_(operator_data)
-  {
-#ifndef NDEBUG
-    // check sizes of inputs are consistent
-    size_t n_particles = (center == Gather ? target_.num_owned_particles()
-                                           : source_.num_particles());
+    : Accumulate(source, target, estimate, center, kernels, geometries, nullptr,
+                 std::make_shared<SmoothingLengthArray const>(smoothing),
+                 basis, operator_spec, operator_domain, operator_data) {}
 
-    assert(n_particles == kernels_.size());
-    assert(n_particles == geometries_.size());
-    assert(n_particles == smoothing_.size());
-    if (operator_spec_ != oper::LastOperator) {
-      unsigned const num_target_particles = target_.num_owned_particles();
-      assert(operator_data_.size()   == num_target_particles);
-      assert(operator_domain_.size() == num_target_particles);
-    }
-#endif
-  }
 
   /** 
    * @brief Evaluate meshfree weight function
@@ -112,22 +119,13 @@ class Accumulate {
    *
    * Information in constructor arguments decides the details of the weight function.
    */
-  double weight(const size_t particleA, const size_t particleB) {
-    double result = 0.0;
+  double weight(const size_t particleA, const size_t particleB) const {
     Wonton::Point<dim> x = target_.get_particle_coordinates(particleA);
     Wonton::Point<dim> y = source_.get_particle_coordinates(particleB);
-    if (center_ == Gather) {
-      result = Weight::eval<dim>(geometries_[particleA],
-                                 kernels_[particleA],
-                                 x,y,
-                                 smoothing_[particleA]);
-    } else if (center_ == Scatter) {
-      result = Weight::eval<dim>(geometries_[particleB],
-                                 kernels_[particleB],
-                                 y,x, // faceted weights are asymmetric
-                                 smoothing_[particleB]);
-    }
-    return result;
+    if (center_ == Gather)
+      return evaluate(particleA, x, y);
+    else
+      return evaluate(particleB, y, x); // faceted weights are asymmetric
   }
 
   /** 
@@ -146,133 +144,401 @@ class Accumulate {
 
     switch (estimate_) {
       case KernelDensity:  {
+        std::vector<double> weight_val(source_particles.size());
+        (this->*compute_weights_)(particleA, source_particles, weight_val.data());
+        size_t iB = 0;
         for (auto const& particleB : source_particles) {
-          double weight_val = weight(particleA, particleB);
-          std::vector<double> pair_result(1, weight_val);
+          std::vector<double> pair_result(1, weight_val[iB++]);
           result.emplace_back(particleB, pair_result);
         }
         break;
       }
       case OperatorRegression:
       case LocalRegression: {
-        size_t nbasis = basis::function_size<dim>(basis_);
-        Wonton::Point<dim> x = target_.get_particle_coordinates(particleA);
-
-	      // If too few particles, set estimate to zero for this target
-	      bool zilchit = false;
-        if (source_particles.size() < nbasis) {
-          zilchit = true;
+        switch (basis_) {
+          case basis::Unitary:
+            regression<basis::Unitary>(particleA, source_particles, result); break;
+          case basis::Linear:
+            regression<basis::Linear>(particleA, source_particles, result); break;
+          case basis::Quadratic:
+            regression<basis::Quadratic>(particleA, source_particles, result); break;
+          default:
+            throw std::runtime_error("invalid basis type");
         }
+        break;
+      }
+      default:  // invalid estimate
+	      throw std::runtime_error("invalid estimate type");
+    }
+    return result;
+  }
 
-        // Calculate weights and moment matrix (P*W*transpose(P))
-	      std::vector<double> weight_val(source_particles.size());
-        Wonton::Matrix moment(nbasis,nbasis,0.);
-        int const num_source_particles = source_particles.size();
-        std::vector<std::vector<double>> basis_values(num_source_particles);
+ private:
+  /**
+   * @brief Constructor referencing or owning the smoothing lengths.
+   */
+  Accumulate(SourceSwarm const& source, TargetSwarm const& target,
+             EstimateType estimate, WeightCenter center,
+             Wonton::vector<Weight::Kernel> const& kernels,
+             Wonton::vector<Weight::Geometry> const& geometries,
+             SmoothingLengthArray const* smoothing,
+             std::shared_ptr<SmoothingLengthArray const> owned_smoothing,
+             basis::Type basis, oper::Type operator_spec,
+             Wonton::vector<oper::Domain> const& operator_domain,
+             Wonton::vector<std::vector<Wonton::Point<dim>>> const& operator_data)
+    : source_(source),
+      target_(target),
+      estimate_(estimate),
+      center_(center),
+      kernels_(kernels),
+      geometries_(geometries),
+      owned_smoothing_(std::move(owned_smoothing)),
+      smoothing_(owned_smoothing_ ? owned_smoothing_.get() : smoothing),
+      basis_(basis),
+      operator_spec_(operator_spec),
+      operator_domain_(operator_domain),
+      operator_data_(operator_data)
+  {
+    int const num_weights = smoothing_->size();
 
-        size_t iB = 0;
-        if (not zilchit) {
-          for (auto const& particleB : source_particles) {
-            weight_val[iB] = weight(particleA, particleB); // save weights for later
-            Wonton::Point<dim> y = source_.get_particle_coordinates(particleB);
-            auto& basis = basis_values[iB];
-            basis = basis::shift<dim>(basis_, x, y);
-            for (size_t i=0; i<nbasis; i++) {
-              for (size_t j=0; j<nbasis; j++) {
-                moment[i][j] += basis[i]*basis[j]*weight_val[iB];
-              }
-            }
-            iB++;
-          }
-        }
+#ifndef NDEBUG
+    // check sizes of inputs are consistent
+    size_t n_particles = (center == Gather ? target_.num_owned_particles()
+                                           : source_.num_particles());
+
+    assert(n_particles == kernels_.size());
+    assert(n_particles == geometries_.size());
+    assert(n_particles == unsigned(num_weights));
+    if (operator_spec_ != oper::LastOperator) {
+      unsigned const num_target_particles = target_.num_owned_particles();
+      assert(operator_data_.size()   == num_target_particles);
+      assert(operator_domain_.size() == num_target_particles);
+    }
+    // faceted weights read whole rows, the others the first 'dim' values
+    for (int i = 0; i < num_weights; i++) {
+      if (geometries_[i] == Weight::FACETED)
+        assert(smoothing_->row_size(i) == dim + 1);
+      else
+        assert(smoothing_->num_rows(i) > 0 and smoothing_->row_size(i) >= dim);
+    }
+#endif
+
+    // check if a single evaluator applies
+    bool uniform = num_weights > 0;
+    for (int i = 0; i < num_weights; i++) {
+      uniform = uniform and kernels_[i] == kernels_[0]
+                        and geometries_[i] == geometries_[0];
+    }
+
+    if (uniform) {
+      compute_weights_ = Weight::visit<dim>(geometries_[0], kernels_[0],
+        [this](auto const& evaluator) {
+          using Evaluator = std::decay_t<decltype(evaluator)>;
+          return center_ == Gather
+            ? &Accumulate::template compute_weights<Evaluator, Gather>
+            : &Accumulate::template compute_weights<Evaluator, Scatter>;
+        });
+    } else {
+      compute_weights_ = center_ == Gather
+        ? &Accumulate::template compute_mixed_weights<Gather>
+        : &Accumulate::template compute_mixed_weights<Scatter>;
+    }
+  }
+
+  using WeightsFunction = void (Accumulate::*)(size_t,
+                                               std::vector<int> const&,
+                                               double*) const;
+
+  /**
+   * @brief Evaluate the weight function attached to a particle.
+   *
+   * @param particle: index of the particle holding the smoothing data.
+   * @param x: its coordinates.
+   * @param y: coordinates of the other particle.
+   * @return value of weight function
+   */
+  double evaluate(size_t particle,
+                  Wonton::Point<dim> const& x,
+                  Wonton::Point<dim> const& y) const {
+    int const size = smoothing_->data_size(particle);
+    double const* data = smoothing_->data(particle);
+    return Weight::visit<dim>(geometries_[particle], kernels_[particle],
+                              [&](auto const& evaluator) {
+                                return evaluator(x, y, data, size);
+                              });
+  }
+
+  /**
+   * @brief Compute the weights of a target when all particles share the
+   *        same kernel and geometry.
+   *
+   * @tparam Evaluator: weight function evaluator.
+   * @tparam center: where the smoothing data is attached.
+   * @param particleA: target particle index.
+   * @param source_particles: list of its source particle neighbors.
+   * @param weights: weight value of each neighbor.
+   */
+  template<class Evaluator, WeightCenter center>
+  void compute_weights(size_t particleA,
+                       std::vector<int> const& source_particles,
+                       double* weights) const {
+    Evaluator const evaluator;
+    Wonton::Point<dim> const x = target_.get_particle_coordinates(particleA);
+    int const num_source_particles = source_particles.size();
+
+    if (center == Gather) {
+      int const size = smoothing_->data_size(particleA);
+      double const* data = smoothing_->data(particleA);
+      for (int i = 0; i < num_source_particles; i++) {
+        auto const y = source_.get_particle_coordinates(source_particles[i]);
+        weights[i] = evaluator(x, y, data, size);
+      }
+    } else {
+      for (int i = 0; i < num_source_particles; i++) {
+        int const particleB = source_particles[i];
+        auto const y = source_.get_particle_coordinates(particleB);
+        weights[i] = evaluator(y, x, smoothing_->data(particleB),
+                               smoothing_->data_size(particleB));
+      }
+    }
+  }
+
+  /**
+   * @brief Compute the weights of a target when particles have distinct
+   *        kernels or geometries.
+   *
+   * @tparam center: where the smoothing data is attached.
+   * @param particleA: target particle index.
+   * @param source_particles: list of its source particle neighbors.
+   * @param weights: weight value of each neighbor.
+   */
+  template<WeightCenter center>
+  void compute_mixed_weights(size_t particleA,
+                             std::vector<int> const& source_particles,
+                             double* weights) const {
+    Wonton::Point<dim> const x = target_.get_particle_coordinates(particleA);
+    int const num_source_particles = source_particles.size();
+
+    for (int i = 0; i < num_source_particles; i++) {
+      auto const y = source_.get_particle_coordinates(source_particles[i]);
+      weights[i] = center == Gather ? evaluate(particleA, x, y)
+                                    : evaluate(source_particles[i], y, x);
+    }
+  }
 
-        iB = 0;
-
-        // optimize for unitary basis
-        if (nbasis == 1) {
-          for (auto const& particleB : source_particles) {
-            std::vector<double> pair_result(nbasis, 0.);
-            if (not zilchit) {
-              pair_result[0] = (basis_values[iB][0] * weight_val[iB] / moment[0][0]);
-            }
-            // If an operator is being applied, adjust final weights.
-            apply_operator(particleA, nbasis, x, pair_result);
-            result.emplace_back(particleB, pair_result);
-            iB++;
-          }
-          return result;
+  /**
+   * @brief Compute the local regression corrected weights of a target.
+   *
+   * The moment matrix P*W*transpose(P) is assembled from the basis
+   * values shifted to the target, then inverted once and applied to the
+   * basis values of all the neighbors. Basis values and weights are kept
+   * in a flat scratch buffer owned by the calling thread, so that it is
+   * only reallocated when a target has more neighbors than the previous
+   * ones.
+   *
+   * @tparam type: basis type.
+   * @param particleA: target particle index.
+   * @param source_particles: list of its source particle neighbors.
+   * @param result: the corrected weights of each neighbor.
+   */
+  template<basis::Type type>
+  void regression(size_t particleA,
+                  std::vector<int> const& source_particles,
+                  std::vector<Weights_t>& result) const {
+
+    constexpr int nbasis = basis::Traits<type, dim>::function_size;
+    using Moment = std::array<std::array<double, nbasis>, nbasis>;
+
+    int const num_source_particles = source_particles.size();
+    Wonton::Point<dim> const x = target_.get_particle_coordinates(particleA);
+    auto const op = operator_matrix(particleA, nbasis, x);
+
+    // If too few particles, set estimate to zero for this target
+    if (num_source_particles < nbasis) {
+      for (auto const& particleB : source_particles) {
+        std::vector<double> pair_result(nbasis, 0.);
+        apply_operator(op, nbasis, pair_result);
+        result.emplace_back(particleB, pair_result);
+      }
+      return;
+    }
+
+    // weights followed by the shifted basis values of each neighbor
+    static thread_local std::vector<double> buffer;
+    buffer.resize(num_source_particles * (nbasis + 1));
+    double* const weight_val = buffer.data();
+    double* const basis_values = weight_val + num_source_particles;
+
+    (this->*compute_weights_)(particleA, source_particles, weight_val);
+
+    // Calculate moment matrix (P*W*transpose(P)), lower part only
+    auto const ijet = basis::inverse_jet<type, dim>(x);
+    Moment moment {};
+
+    for (int k = 0; k < num_source_particles; k++) {
+      auto const y = source_.get_particle_coordinates(source_particles[k]);
+      auto const by = basis::function<type, dim>(y);
+      double* const basis = basis_values + k * nbasis;
+      for (int i = 0; i < nbasis; i++) {
+        basis[i] = 0.;
+        for (int j = 0; j < nbasis; j++)
+          basis[i] += ijet[i][j] * by[j];
+      }
+      for (int i = 0; i < nbasis; i++)
+        for (int j = 0; j <= i; j++)
+          moment[i][j] += basis[i] * basis[j] * weight_val[k];
+    }
+
+    // calculate inverse(P*W*transpose(P))*P*W
+    Moment inverse;
+    bool const invertible = invert<nbasis>(moment, inverse);
+
+    for (int k = 0; k < num_source_particles; k++) {
+      std::vector<double> pair_result(nbasis, 0.);
+      double const* const basis = basis_values + k * nbasis;
+
+      if (invertible) {
+        for (int i = 0; i < nbasis; i++) {
+          double sum = 0.;
+          for (int j = 0; j < nbasis; j++)
+            sum += inverse[i][j] * basis[j];
+          pair_result[i] = sum * weight_val[k];
+        }
+      } else {
+        // not numerically definite: solve the linear system instead
+        Wonton::Matrix moment_matrix(nbasis, nbasis);
+        Wonton::Matrix basis_matrix(nbasis, 1);
+        for (int i = 0; i < nbasis; i++) {
+          basis_matrix[i][0] = basis[i];
+          for (int j = 0; j <= i; j++)
+            moment_matrix[i][j] = moment_matrix[j][i] = moment[i][j];
         }
 
-        // calculate inverse(P*W*transpose(P))*P*W otherwise
-        for (auto const& particleB : source_particles) {
-	        std::vector<double> pair_result(nbasis,0.);
-          // solve the linear system
-          if (not zilchit) {
-            auto const& basis = basis_values[iB];
-            // recast as a Portage::Matrix
-            Wonton::Matrix basis_matrix(nbasis,1);
-            for (size_t i=0; i<nbasis; i++) basis_matrix[i][0] = basis[i];
-
-            std::string error="check";
+        std::string error="check";
 #ifdef WONTON_HAS_LAPACKE
-            Wonton::Matrix pair_result_matrix = moment.solve(basis_matrix, "lapack-sytr", error);
+        Wonton::Matrix pair_result_matrix = moment_matrix.solve(basis_matrix, "lapack-sytr", error);
 #else
-            Wonton::Matrix pair_result_matrix = moment.solve(basis_matrix, "inverse", error);
+        Wonton::Matrix pair_result_matrix = moment_matrix.solve(basis_matrix, "inverse", error);
 #endif
-            for (size_t i=0; i<nbasis; i++)
-              pair_result[i] = pair_result_matrix[i][0]*weight_val[iB];
-              // NOTE: THIS CODE HAS TO WAIT FOR AN UPDATED WONTON
-              //if (basis_matrix.is_singular() == 2 or error != "none") {
-              //  bad_count++;
-              //}
-          }
-
-          // If an operator is being applied, adjust final weights.
-          apply_operator(particleA, nbasis, x, pair_result);
-          result.emplace_back(particleB, pair_result);
-          iB++;
+        for (int i = 0; i < nbasis; i++)
+          pair_result[i] = pair_result_matrix[i][0] * weight_val[k];
+      }
+
+      // If an operator is being applied, adjust final weights.
+      apply_operator(op, nbasis, pair_result);
+      result.emplace_back(source_particles[k], pair_result);
+    }
+  }
+
+  /**
+   * @brief Invert a symmetric positive definite matrix of fixed size
+   *        through its Cholesky factorization.
+   *
+   * @tparam n: matrix size.
+   * @param matrix: the matrix, only its lower part is read.
+   * @param inverse: its inverse.
+   * @return false if the matrix is not numerically positive definite.
+   */
+  template<int n>
+  static bool invert(std::array<std::array<double, n>, n> const& matrix,
+                     std::array<std::array<double, n>, n>& inverse) {
+
+    // matrix = L * transpose(L)
+    std::array<std::array<double, n>, n> L {};
+    for (int j = 0; j < n; j++) {
+      double pivot = matrix[j][j];
+      for (int k = 0; k < j; k++)
+        pivot -= L[j][k] * L[j][k];
+      if (not (pivot > std::numeric_limits<double>::epsilon() * matrix[j][j]))
+        return false;
+      L[j][j] = std::sqrt(pivot);
+      for (int i = j + 1; i < n; i++) {
+        double sum = matrix[i][j];
+        for (int k = 0; k < j; k++)
+          sum -= L[i][k] * L[j][k];
+        L[i][j] = sum / L[j][j];
+      }
+    }
+
+    // inverse(L) by forward substitution
+    std::array<std::array<double, n>, n> R {};
+    for (int j = 0; j < n; j++) {
+      R[j][j] = 1. / L[j][j];
+      for (int i = j + 1; i < n; i++) {
+        double sum = 0.;
+        for (int k = j; k < i; k++)
+          sum -= L[i][k] * R[k][j];
+        R[i][j] = sum / L[i][i];
+      }
+    }
+
+    // inverse = transpose(inverse(L)) * inverse(L)
+    for (int i = 0; i < n; i++) {
+      for (int j = 0; j <= i; j++) {
+        double sum = 0.;
+        for (int k = i; k < n; k++)
+          sum += R[k][i] * R[k][j];
+        inverse[i][j] = inverse[j][i] = sum;
+      }
+    }
+    return true;
+  }
+
+  /**
+   * @brief Combine the inverse jet and the user-defined operator of a target.
+   *
+   * @param particleA: target particle index.
+   * @param nbasis: number of weight basis
+   * @param x: target particle coordinates.
+   * @return the nbasis x opsize row-major matrix to apply to the corrected
+   *         weights, empty if no operator is specified.
+   */
+  std::vector<double> operator_matrix(size_t particleA, int nbasis,
+                                      Wonton::Point<dim> const& x) const {
+
+    if (estimate_ != OperatorRegression)
+      return {};
+
+    auto ijet = basis::inverse_jet<dim>(basis_, x);
+    std::vector<std::vector<double>> basisop;
+    oper::apply<dim>(operator_spec_, basis_,
+                     operator_domain_[particleA],
+                     operator_data_[particleA], basisop);
+    int const opsize = oper::size_info(operator_spec_, basis_,
+                                       operator_domain_[particleA])[0];
+    std::vector<double> result(nbasis * opsize, 0.);
+
+    for (int k = 0; k < nbasis; k++) {
+      for (int m = 0; m < nbasis; m++) {
+        for (int j = 0; j < opsize; j++) {
+          result[k * opsize + j] += ijet[k][m] * basisop[m][j];
         }
-	      break;
       }
-      default:  // invalid estimate
-	      throw std::runtime_error("invalid estimate type");
     }
     return result;
   }
 
- private:
   /**
    * @brief Adjust weights if a user-defined operator is specified.
    *
-   * @param particleA: target particle index.
+   * @param op: matrix returned by 'operator_matrix' for the target.
    * @param nbasis: number of weight basis
-   * @param x: target particle coordinates.
    * @param pair_result:the corrected weights.
    */
-  void apply_operator(size_t particleA, size_t nbasis,
-                      Wonton::Point<dim> const& x,
-                      std::vector<double>& pair_result) const {
-
-    if (estimate_ == OperatorRegression) {
-      auto ijet = basis::inverse_jet<dim>(basis_, x);
-      std::vector<std::vector<double>> basisop;
-      oper::apply<dim>(operator_spec_, basis_,
-                       operator_domain_[particleA],
-                       operator_data_[particleA], basisop);
-      int const num_basis = nbasis;
-      int const opsize = oper::size_info(operator_spec_, basis_,
-                                         operator_domain_[particleA])[0];
+  static void apply_operator(std::vector<double> const& op, int nbasis,
+                             std::vector<double>& pair_result) {
+
+    if (not op.empty()) {
+      int const opsize = op.size() / nbasis;
       std::vector<double> operator_result(opsize, 0.);
 
-      for (int j = 0; j < opsize; j++) {
-        for (int k = 0; k < num_basis; k++) {
-          for (int m = 0; m < num_basis; m++) {
-            operator_result[j] += pair_result[k]*ijet[k][m]*basisop[m][j];
-          }
+      for (int k = 0; k < nbasis; k++) {
+        for (int j = 0; j < opsize; j++) {
+          operator_result[j] += pair_result[k] * op[k * opsize + j];
         }
       }
-      for (int j = 0; j < num_basis; j++)
-        pair_result[j] = operator_result[j];
+      for (int j = 0; j < nbasis; j++)
+        pair_result[j] = j < opsize ? operator_result[j] : 0.;
     }
   }
 
@@ -283,11 +549,13 @@ class Accumulate {
   WeightCenter center_;
   Wonton::vector<Weight::Kernel> const& kernels_;
   Wonton::vector<Weight::Geometry> const& geometries_;
-  Wonton::vector<std::vector<std::vector<double>>> const& smoothing_;
+  std::shared_ptr<SmoothingLengthArray const> owned_smoothing_;
+  SmoothingLengthArray const* smoothing_;
   basis::Type basis_;
   oper::Type operator_spec_;
   Wonton::vector<oper::Domain> operator_domain_;
   Wonton::vector<std::vector<Wonton::Point<dim>>> operator_data_;
+  WeightsFunction compute_weights_ = nullptr;
 };
 
 }}
@@ -0,0 +1,366 @@
+/*
+This file is part of the Ristra portage project.
+Please see the license file at the root of this repository, or at:
+    https://github.com/laristra/portage/blob/master/LICENSE
+*/
+#ifndef PORTAGE_ACCUMULATE_SWARM_WEIGHTS_H_
+#define PORTAGE_ACCUMULATE_SWARM_WEIGHTS_H_
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <limits>
+#include <numeric>
+#include <ostream>
+#include <stdexcept>
+#include <vector>
+
+#include "wonton/support/wonton.h"
+
+#include "portage/support/portage.h"
+
+namespace Portage { namespace Meshfree {
+
+/**
+ * @class SwarmWeights swarm_weights.h
+ * @brief Shape functions of a swarm remap in compressed sparse row format.
+ *
+ * Each row holds the source particles of a target particle along with
+ * the components of their shape functions, i.e. the result of
+ * @code Accumulate::operator()@endcode for that target. The rows only
+ * depend on the particles positions and smoothing lengths, so they can
+ * be kept and applied to new field values as long as the swarms do not
+ * move. Applying a component of the shape functions to a field gives
+ * the same value as @code Estimate::operator()@endcode.
+ */
+class SwarmWeights {
+
+public:
+  /**
+   * @brief Create empty weights.
+   */
+  SwarmWeights() = default;
+
+  /**
+   * @brief Compress the shape functions of all target particles.
+   *
+   * @param sources_and_weights: source particles and shape functions
+   *                             of each target particle.
+   */
+  explicit SwarmWeights(Wonton::vector<std::vector<Weights_t>> const& sources_and_weights) {
+    build(sources_and_weights);
+  }
+
+  /**
+   * @brief Compress the shape functions of all target particles.
+   *
+   * All shape functions must have the same number of components.
+   *
+   * @param sources_and_weights: source particles and shape functions
+   *                             of each target particle.
+   */
+  void build(Wonton::vector<std::vector<Weights_t>> const& sources_and_weights) {
+
+    num_targets_ = sources_and_weights.size();
+    num_components_ = 0;
+    offsets_.assign(num_targets_ + 1, 0);
+
+    for (int t = 0; t < num_targets_; ++t) {
+      // nb: 'auto' may imply unexpected behavior with thrust enabled.
+      std::vector<Weights_t> const& row = sources_and_weights[t];
+      offsets_[t + 1] = offsets_[t] + row.size();
+      for (auto const& entry : row) {
+        if (num_components_ == 0)
+          num_components_ = entry.weights.size();
+        else if (static_cast<int>(entry.weights.size()) != num_components_) {
+          clear();
+          throw std::runtime_error("inconsistent number of shape function components");
+        }
+      }
+    }
+
+    int const num_entries = offsets_[num_targets_];
+    sources_.resize(num_entries);
+    values_.resize(static_cast<std::size_t>(num_entries) * num_components_);
+
+    std::vector<int> targets(num_targets_);
+    std::iota(targets.begin(), targets.end(), 0);
+
+    Wonton::for_each(targets.begin(), targets.end(), [&](int t) {
+      std::vector<Weights_t> const& row = sources_and_weights[t];
+      std::size_t k = offsets_[t];
+      for (auto const& entry : row) {
+        sources_[k] = entry.entityID;
+        std::copy(entry.weights.begin(), entry.weights.end(),
+                  values_.begin() + k * num_components_);
+        k++;
+      }
+    });
+  }
+
+  /**
+   * @brief Compute and compress the shape functions of all target particles.
+   *
+   * The rows are computed in parallel and copied in place, so that the
+   * shape functions of all target particles are never held at once.
+   * The first non-empty row gives the number of components.
+   *
+   * @tparam RowFunction: functor giving the source particles and shape
+   *                      functions of a target particle.
+   * @param row_sizes: number of entries of each target particle.
+   * @param compute_row: the functor.
+   */
+  template<class RowFunction>
+  void build(std::vector<int> const& row_sizes, RowFunction&& compute_row) {
+
+    num_targets_ = row_sizes.size();
+    num_components_ = 0;
+    offsets_.resize(num_targets_ + 1);
+    offsets_[0] = 0;
+    std::partial_sum(row_sizes.begin(), row_sizes.end(), offsets_.begin() + 1);
+
+    int first = 0;
+    while (first < num_targets_ and row_sizes[first] == 0)
+      first++;
+
+    std::vector<Weights_t> first_row;
+    if (first < num_targets_) {
+      first_row = compute_row(first);
+      if (not first_row.empty())
+        num_components_ = first_row[0].weights.size();
+    }
+
+    int const num_entries = offsets_[num_targets_];
+    sources_.resize(num_entries);
+    values_.resize(static_cast<std::size_t>(num_entries) * num_components_);
+
+    std::atomic<bool> valid_sizes(true), valid_components(true);
+
+    auto store = [&](int t, std::vector<Weights_t> const& row) {
+      if (static_cast<int>(row.size()) != offsets_[t + 1] - offsets_[t]) {
+        valid_sizes = false;
+        return;
+      }
+      std::size_t k = offsets_[t];
+      for (auto const& entry : row) {
+        if (static_cast<int>(entry.weights.size()) != num_components_) {
+          valid_components = false;
+          return;
+        }
+        sources_[k] = entry.entityID;
+        std::copy(entry.weights.begin(), entry.weights.end(),
+                  values_.begin() + k * num_components_);
+        k++;
+      }
+    };
+
+    if (first < num_targets_)
+      store(first, first_row);
+
+    std::vector<int> targets;
+    for (int t = first + 1; t < num_targets_; ++t)
+      if (row_sizes[t] > 0)
+        targets.push_back(t);
+
+    Wonton::for_each(targets.begin(), targets.end(), [&](int t) {
+      store(t, compute_row(t));
+    });
+
+    if (not valid_sizes) {
+      clear();
+      throw std::runtime_error("inconsistent number of shape functions");
+    } else if (not valid_components) {
+      clear();
+      throw std::runtime_error("inconsistent number of shape function components");
+    }
+  }
+
+  /**
+   * @brief Release the weights.
+   */
+  void clear() {
+    num_targets_ = 0;
+    num_components_ = 0;
+    offsets_.assign(1, 0);
+    sources_.clear();
+    values_.clear();
+  }
+
+  /**
+   * @brief Check if there is no weight.
+   *
+   * @return true if no target particle is stored.
+   */
+  bool empty() const { return num_targets_ == 0; }
+
+  /**
+   * @brief Get the number of target particles.
+   *
+   * @return the number of rows.
+   */
+  int num_targets() const { return num_targets_; }
+
+  /**
+   * @brief Get the number of components of each shape function.
+   *
+   * @return the number of components.
+   */
+  int num_components() const { return num_components_; }
+
+  /**
+   * @brief Get the number of stored source-target pairs.
+   *
+   * @return the number of entries.
+   */
+  int num_entries() const { return offsets_.back(); }
+
+  /**
+   * @brief Get the offset of each row.
+   *
+   * @return the rows offsets.
+   */
+  std::vector<int> const& offsets() const { return offsets_; }
+
+  /**
+   * @brief Get the source particle of each entry.
+   *
+   * @return the source particles indices.
+   */
+  std::vector<int> const& sources() const { return sources_; }
+
+  /**
+   * @brief Get the shape function components of each entry.
+   *
+   * @return the packed components.
+   */
+  std::vector<double> const& values() const { return values_; }
+
+  /**
+   * @brief Apply the shape functions of a target particle to a field.
+   *
+   * @param target: target particle index.
+   * @param source_values: field values on source particles.
+   * @param component: the shape function component to use.
+   * @return the estimated value.
+   */
+  double apply(int target, double const* source_values, int component = 0) const {
+    assert(component < num_components_);
+    double result = 0.;
+    for (int j = offsets_[target]; j < offsets_[target + 1]; ++j)
+      result += source_values[sources_[j]] * values_[j * num_components_ + component];
+    return result;
+  }
+
+  /**
+   * @brief Apply the shape functions to a block of fields.
+   *
+   * @param source_fields: pointers to the values of each field on sources.
+   * @param target_fields: pointers to the values of each field on targets.
+   * @param num_fields: number of fields of the block.
+   * @param component: the shape function component to use.
+   */
+  void apply(double const* const* source_fields, double* const* target_fields,
+             int num_fields, int component = 0) const {
+
+    std::vector<int> targets(num_targets_);
+    std::iota(targets.begin(), targets.end(), 0);
+
+    Wonton::for_each(targets.begin(), targets.end(), [&](int t) {
+      for (int f = 0; f < num_fields; ++f)
+        target_fields[f][t] = apply(t, source_fields[f], component);
+    });
+  }
+
+  /**
+   * @brief Write the weights in binary format.
+   *
+   * @param os: output stream.
+   */
+  void write(std::ostream& os) const {
+    std::int64_t const header[] = { magic, num_targets_, num_components_, num_entries() };
+    os.write(reinterpret_cast<char const*>(header), sizeof(header));
+    write(os, offsets_);
+    write(os, sources_);
+    write(os, values_);
+    if (not os)
+      throw std::runtime_error("unable to write swarm weights");
+  }
+
+  /**
+   * @brief Read weights written by 'write'.
+   *
+   * Offsets must not decrease and source particles must be indexed
+   * within the source swarm, so that the weights can be applied safely.
+   *
+   * @param is: input stream.
+   * @param num_sources: number of particles of the source swarm.
+   */
+  void read(std::istream& is, int num_sources) {
+    std::int64_t header[4] = {};
+    is.read(reinterpret_cast<char*>(header), sizeof(header));
+    std::int64_t const max_size = std::numeric_limits<int>::max();
+    if (not is or header[0] != magic)
+      throw std::runtime_error("invalid swarm weights header");
+    for (int i = 1; i < 4; i++) {
+      if (header[i] < 0 or header[i] > max_size)
+        throw std::runtime_error("invalid swarm weights header");
+    }
+
+    num_targets_ = header[1];
+    num_components_ = header[2];
+    int const num_entries = header[3];
+    offsets_.resize(num_targets_ + 1);
+    sources_.resize(num_entries);
+    values_.resize(static_cast<std::size_t>(num_entries) * num_components_);
+    read(is, offsets_);
+    read(is, sources_);
+    read(is, values_);
+
+    if (not is or offsets_.front() != 0 or offsets_.back() != num_entries) {
+      clear();
+      throw std::runtime_error("unable to read swarm weights");
+    }
+
+    bool const sorted = std::is_sorted(offsets_.begin(), offsets_.end());
+    bool const in_range =
+      std::all_of(sources_.begin(), sources_.end(),
+                  [num_sources](int s) { return s >= 0 and s < num_sources; });
+
+    if (not sorted or not in_range) {
+      clear();
+      throw std::runtime_error("invalid swarm weights indices");
+    }
+  }
+
+private:
+  /** tag of the binary format */
+  static constexpr std::int64_t magic = 0x5357574754530001;
+
+  template<class T>
+  static void write(std::ostream& os, std::vector<T> const& data) {
+    os.write(reinterpret_cast<char const*>(data.data()), data.size() * sizeof(T));
+  }
+
+  template<class T>
+  static void read(std::istream& is, std::vector<T>& data) {
+    is.read(reinterpret_cast<char*>(data.data()), data.size() * sizeof(T));
+  }
+
+  /** number of target particles */
+  int num_targets_ = 0;
+  /** number of components of each shape function */
+  int num_components_ = 0;
+  /** offsets of each target particle entries */
+  std::vector<int> offsets_ = {0};
+  /** source particle of each entry */
+  std::vector<int> sources_ {};
+  /** shape function components of each entry */
+  std::vector<double> values_ {};
+};
+
+}}  // namespace Portage::Meshfree
+
+#endif  // PORTAGE_ACCUMULATE_SWARM_WEIGHTS_H_
@@ -3,13 +3,18 @@ This file is part of the Ristra portage project.
 Please see the license file at the root of this repository, or at:
     https://github.com/laristra/portage/blob/master/LICENSE
 */
+#include <algorithm>
 #include <cmath>
+#include <numeric>
+#include <random>
+#include <string>
 #include <vector>
 #include <portage/driver/driver_swarm.h>
 #include "gtest/gtest.h"
 
 #include "wonton/support/wonton.h"
 #include "wonton/support/Point.h"
+#include "wonton/support/Matrix.h"
 #include "wonton/swarm/swarm.h"
 
 #include "portage/accumulate/accumulate.h"
@@ -122,6 +127,142 @@ void test_accumulate(EstimateType etype, basis::Type btype, WeightCenter center)
 }
 
 
+/**
+ * @brief Compute the corrected weights of a target by solving the linear
+ *        system of the moment matrix for each neighbor.
+ *
+ * It is the reference computation of the local regression, prior to its
+ * fixed-size Cholesky inversion.
+ */
+template<int dim>
+std::vector<std::vector<double>>
+reference_regression(Accumulate<dim, Swarm<dim>, Swarm<dim>> const& accumulator,
+                     Swarm<dim> const& src_swarm, Swarm<dim> const& tgt_swarm,
+                     basis::Type btype, int target, std::vector<int> const& sources) {
+
+  int const nbasis = basis::function_size<dim>(btype);
+  int const nsources = sources.size();
+  auto const x = tgt_swarm.get_particle_coordinates(target);
+  auto const ijet = basis::inverse_jet<dim>(btype, x);
+
+  std::vector<double> weights(nsources);
+  std::vector<std::vector<double>> basis_values(nsources, std::vector<double>(nbasis, 0.));
+  Wonton::Matrix moment(nbasis, nbasis, 0.);
+
+  for (int k = 0; k < nsources; k++) {
+    auto const y = src_swarm.get_particle_coordinates(sources[k]);
+    auto const by = basis::function<dim>(btype, y);
+    weights[k] = accumulator.weight(target, sources[k]);
+    for (int i = 0; i < nbasis; i++)
+      for (int j = 0; j < nbasis; j++)
+        basis_values[k][i] += ijet[i][j] * by[j];
+    for (int i = 0; i < nbasis; i++)
+      for (int j = 0; j < nbasis; j++)
+        moment[i][j] += basis_values[k][i] * basis_values[k][j] * weights[k];
+  }
+
+  std::vector<std::vector<double>> result(nsources);
+  for (int k = 0; k < nsources; k++) {
+    Wonton::Matrix basis_matrix(nbasis, 1);
+    for (int i = 0; i < nbasis; i++)
+      basis_matrix[i][0] = basis_values[k][i];
+
+    std::string error = "check";
+#ifdef WONTON_HAS_LAPACKE
+    auto const solution = moment.solve(basis_matrix, "lapack-sytr", error);
+#else
+    auto const solution = moment.solve(basis_matrix, "inverse", error);
+#endif
+    for (int i = 0; i < nbasis; i++)
+      result[k].push_back(solution[i][0] * weights[k]);
+  }
+  return result;
+}
+
+// Compare the regression against the reference solve, and check that it
+// reproduces a polynomial of the basis degree up to round-off.
+template<int dim>
+void test_regression_reference(basis::Type btype, WeightCenter center) {
+
+  using Accumulator = Accumulate<dim, Swarm<dim>, Swarm<dim>>;
+
+  int const npoints = 64;
+  double const smoothing = 0.6;
+  int const nbasis = basis::function_size<dim>(btype);
+
+  std::random_device device;
+  std::mt19937 engine { device() };
+  std::uniform_real_distribution<double> generator(0.0, 1.0);
+
+  Wonton::vector<Point<dim>> source_points(npoints);
+  Wonton::vector<Point<dim>> target_points(npoints);
+  for (int i = 0; i < npoints; i++) {
+    Point<dim> p, q;
+    for (int d = 0; d < dim; d++) {
+      p[d] = generator(engine);
+      q[d] = 0.2 + 0.6 * generator(engine);
+    }
+    source_points[i] = p;
+    target_points[i] = q;
+  }
+
+  Swarm<dim> src_swarm(source_points);
+  Swarm<dim> tgt_swarm(target_points);
+  Wonton::vector<Weight::Kernel> kernels(npoints, Weight::B4);
+  Wonton::vector<Weight::Geometry> geometries(npoints, Weight::TENSOR);
+  std::vector<std::vector<double>> default_length(1, std::vector<double>(dim, smoothing));
+  SmoothingLengths smoothing_h(npoints, default_length);
+
+  Accumulator accumulator(src_swarm, tgt_swarm, EstimateType::LocalRegression,
+                          center, kernels, geometries, smoothing_h, btype);
+
+  // random polynomial of the basis degree
+  std::vector<double> coefs(nbasis);
+  for (auto&& c : coefs)
+    c = 2. * generator(engine) - 1.;
+
+  auto polynomial = [&](Point<dim> const& p) {
+    auto const values = basis::function<dim>(btype, p);
+    double sum = 0.;
+    for (int i = 0; i < nbasis; i++)
+      sum += coefs[i] * values[i];
+    return sum;
+  };
+
+  std::vector<int> src_particles(npoints);
+  std::iota(src_particles.begin(), src_particles.end(), 0);
+
+  for (int i = 0; i < npoints; i++) {
+    auto const shape_vecs = accumulator(i, src_particles);
+    auto const expected = reference_regression<dim>(accumulator, src_swarm, tgt_swarm,
+                                                    btype, i, src_particles);
+    ASSERT_EQ(shape_vecs.size(), unsigned(npoints));
+
+    double norm = 0.;
+    for (int j = 0; j < npoints; j++)
+      for (int m = 0; m < nbasis; m++)
+        norm = std::max(norm, std::abs(expected[j][m]));
+
+    double estimate = 0.;
+    double reference = 0.;
+    for (int j = 0; j < npoints; j++) {
+      Point<dim> const y = source_points[j];
+      double const value = polynomial(y);
+      ASSERT_EQ(shape_vecs[j].entityID, j);
+      ASSERT_EQ(shape_vecs[j].weights.size(), unsigned(nbasis));
+      for (int m = 0; m < nbasis; m++)
+        ASSERT_NEAR(shape_vecs[j].weights[m], expected[j][m], 1.e-10 * norm);
+      estimate += shape_vecs[j].weights[0] * value;
+      reference += expected[j][0] * value;
+    }
+
+    Point<dim> const x = target_points[i];
+    ASSERT_NEAR(estimate, polynomial(x), 1.e-10);
+    ASSERT_NEAR(estimate, reference, 1.e-10);
+  }
+}
+
+
 // Test the reproducing property of basis integration operators
 template<basis::Type btype, oper::Type opertype, oper::Domain domain>
 void test_operator(WeightCenter center) {
@@ -403,6 +544,81 @@ TEST(accumulate, 3d_RQS) {
                      WeightCenter::Scatter);
 }
 
+TEST(accumulate, 1d_RLG_reference) {
+  test_regression_reference<1>(basis::Type::Linear, WeightCenter::Gather);
+}
+
+TEST(accumulate, 2d_RLS_reference) {
+  test_regression_reference<2>(basis::Type::Linear, WeightCenter::Scatter);
+}
+
+TEST(accumulate, 2d_RQG_reference) {
+  test_regression_reference<2>(basis::Type::Quadratic, WeightCenter::Gather);
+}
+
+TEST(accumulate, 3d_RQS_reference) {
+  test_regression_reference<3>(basis::Type::Quadratic, WeightCenter::Scatter);
+}
+
+// Degenerate neighbors: a singular moment matrix is not inverted and
+// falls back to solving the linear system, too few neighbors give zeros.
+TEST(accumulate, degenerate) {
+
+  using Accumulator = Accumulate<2, Swarm<2>, Swarm<2>>;
+
+  int const npoints = 8;
+  Wonton::vector<Point<2>> source_points(npoints);
+  Wonton::vector<Point<2>> target_points(1);
+
+  // collinear sources, target on the same line
+  for (int i = 0; i < npoints; i++)
+    source_points[i] = { 0.1 * i + 0.05, 0.5 };
+  target_points[0] = { 0.4, 0.5 };
+
+  Swarm<2> src_swarm(source_points);
+  Swarm<2> tgt_swarm(target_points);
+  Wonton::vector<Weight::Kernel> kernels(1, Weight::B4);
+  Wonton::vector<Weight::Geometry> geometries(1, Weight::TENSOR);
+  std::vector<std::vector<double>> default_length(1, std::vector<double>(2, 0.5));
+  SmoothingLengths smoothing_h(1, default_length);
+
+  Accumulator linear(src_swarm, tgt_swarm, EstimateType::LocalRegression,
+                     WeightCenter::Gather, kernels, geometries,
+                     smoothing_h, basis::Type::Linear);
+
+  std::vector<int> src_particles(npoints);
+  std::iota(src_particles.begin(), src_particles.end(), 0);
+
+  auto const shape_vecs = linear(0, src_particles);
+  auto const expected = reference_regression<2>(linear, src_swarm, tgt_swarm,
+                                                basis::Type::Linear, 0, src_particles);
+  ASSERT_EQ(shape_vecs.size(), unsigned(npoints));
+  for (int j = 0; j < npoints; j++) {
+    ASSERT_EQ(shape_vecs[j].weights.size(), 3u);
+    for (int m = 0; m < 3; m++) {
+      double const actual = shape_vecs[j].weights[m];
+      if (std::isfinite(expected[j][m]))
+        ASSERT_NEAR(actual, expected[j][m], 1.e-12);
+      else
+        ASSERT_FALSE(std::isfinite(actual));
+    }
+  }
+
+  // fewer neighbors than quadratic basis functions
+  Accumulator quadratic(src_swarm, tgt_swarm, EstimateType::LocalRegression,
+                        WeightCenter::Gather, kernels, geometries,
+                        smoothing_h, basis::Type::Quadratic);
+
+  std::vector<int> const few_particles = { 2, 3, 4, 5 };
+  auto const zeros = quadratic(0, few_particles);
+  ASSERT_EQ(zeros.size(), few_particles.size());
+  for (auto const& pair : zeros) {
+    ASSERT_EQ(pair.weights.size(), 6u);
+    for (double const& w : pair.weights)
+      ASSERT_EQ(w, 0.);
+  }
+}
+
 // test the operator capability
 
 TEST(operator, UnitaryInterval) {
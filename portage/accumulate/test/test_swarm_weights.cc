@@ -0,0 +1,155 @@
+/*
+This file is part of the Ristra portage project.
+Please see the license file at the root of this repository, or at:
+    https://github.com/laristra/portage/blob/master/LICENSE
+*/
+#include <cstddef>
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <stdexcept>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "wonton/support/wonton.h"
+
+#include "portage/support/portage.h"
+#include "portage/accumulate/swarm_weights.h"
+
+using Portage::Weights_t;
+using Portage::Meshfree::SwarmWeights;
+
+namespace {
+
+// shape functions of three targets, with two components each
+Wonton::vector<std::vector<Weights_t>> make_weights() {
+  Wonton::vector<std::vector<Weights_t>> weights(3);
+  weights[0] = { Weights_t(0, {0.25, 1.}), Weights_t(2, {0.75, -1.}) };
+  weights[2] = { Weights_t(1, {1., 0.5}) };
+  return weights;
+}
+
+}
+
+TEST(SwarmWeights, Build) {
+  SwarmWeights weights(make_weights());
+
+  ASSERT_EQ(weights.num_targets(), 3);
+  ASSERT_EQ(weights.num_components(), 2);
+  ASSERT_EQ(weights.num_entries(), 3);
+  ASSERT_EQ(weights.offsets(), std::vector<int>({0, 2, 2, 3}));
+  ASSERT_EQ(weights.sources(), std::vector<int>({0, 2, 1}));
+  ASSERT_EQ(weights.values(), std::vector<double>({0.25, 1., 0.75, -1., 1., 0.5}));
+
+  weights.clear();
+  ASSERT_TRUE(weights.empty());
+  ASSERT_EQ(weights.num_entries(), 0);
+}
+
+TEST(SwarmWeights, BuildInPlace) {
+  auto const rows = make_weights();
+  SwarmWeights const expected(rows);
+
+  SwarmWeights weights;
+  weights.build({2, 0, 1}, [&](int t) {
+    std::vector<Weights_t> const row = rows[t];
+    return row;
+  });
+
+  ASSERT_EQ(weights.num_targets(), 3);
+  ASSERT_EQ(weights.num_components(), 2);
+  ASSERT_EQ(weights.offsets(), expected.offsets());
+  ASSERT_EQ(weights.sources(), expected.sources());
+  ASSERT_EQ(weights.values(), expected.values());
+
+  // rows must match the given sizes and number of components
+  ASSERT_THROW(weights.build({2, 0, 2}, [&](int t) {
+    std::vector<Weights_t> const row = rows[t];
+    return row;
+  }), std::runtime_error);
+  ASSERT_TRUE(weights.empty());
+
+  ASSERT_THROW(weights.build({2, 1, 1}, [&](int t) {
+    std::vector<Weights_t> row = rows[t];
+    if (t == 1)
+      row = { Weights_t(0, {1.}) };
+    return row;
+  }), std::runtime_error);
+  ASSERT_TRUE(weights.empty());
+}
+
+TEST(SwarmWeights, Apply) {
+  SwarmWeights const weights(make_weights());
+
+  std::vector<double> const first = {4., 8., 12.};
+  std::vector<double> const second = {-1., 2., 1.};
+  double const* source[] = {first.data(), second.data()};
+
+  std::vector<double> a(3, -1.), b(3, -1.);
+  double* target[] = {a.data(), b.data()};
+
+  weights.apply(source, target, 2);
+  ASSERT_DOUBLE_EQ(a[0], 10.);
+  ASSERT_DOUBLE_EQ(a[1], 0.);
+  ASSERT_DOUBLE_EQ(a[2], 8.);
+  ASSERT_DOUBLE_EQ(b[0], 0.5);
+  ASSERT_DOUBLE_EQ(b[2], 2.);
+
+  // derivative component
+  ASSERT_DOUBLE_EQ(weights.apply(0, first.data(), 1), -8.);
+  ASSERT_DOUBLE_EQ(weights.apply(2, first.data(), 1), 4.);
+}
+
+TEST(SwarmWeights, Serialize) {
+  SwarmWeights const weights(make_weights());
+
+  std::stringstream stream;
+  weights.write(stream);
+
+  SwarmWeights copy;
+  copy.read(stream, 3);
+  ASSERT_EQ(copy.num_targets(), weights.num_targets());
+  ASSERT_EQ(copy.num_components(), weights.num_components());
+  ASSERT_EQ(copy.offsets(), weights.offsets());
+  ASSERT_EQ(copy.sources(), weights.sources());
+  ASSERT_EQ(copy.values(), weights.values());
+
+  // truncated or foreign data is rejected
+  std::string const data = stream.str();
+  std::stringstream truncated(data.substr(0, data.size() - 8));
+  ASSERT_THROW(copy.read(truncated, 3), std::runtime_error);
+  ASSERT_TRUE(copy.empty());
+
+  std::stringstream foreign("not swarm weights at all, definitely");
+  ASSERT_THROW(copy.read(foreign, 3), std::runtime_error);
+
+  // sizes beyond the range of indices are rejected before allocating
+  std::string oversized = data;
+  std::int64_t const num_entries = std::int64_t(1) << 40;
+  oversized.replace(3 * sizeof(std::int64_t), sizeof(std::int64_t),
+                    reinterpret_cast<char const*>(&num_entries), sizeof(std::int64_t));
+  std::stringstream huge(oversized);
+  ASSERT_THROW(copy.read(huge, 3), std::runtime_error);
+
+  // decreasing offsets are rejected
+  std::size_t const offsets_begin = 4 * sizeof(std::int64_t);
+  std::string unsorted = data;
+  int const offset = 3;
+  unsorted.replace(offsets_begin + sizeof(int), sizeof(int),
+                   reinterpret_cast<char const*>(&offset), sizeof(int));
+  std::stringstream decreasing(unsorted);
+  ASSERT_THROW(copy.read(decreasing, 3), std::runtime_error);
+  ASSERT_TRUE(copy.empty());
+
+  // source particles beyond the source swarm are rejected
+  std::stringstream mismatched(data);
+  ASSERT_THROW(copy.read(mismatched, 2), std::runtime_error);
+  ASSERT_TRUE(copy.empty());
+}
+
+TEST(SwarmWeights, Inconsistent) {
+  auto weights = make_weights();
+  weights[1] = { Weights_t(0, {1.}) };
+  ASSERT_THROW(SwarmWeights{weights}, std::runtime_error);
+}
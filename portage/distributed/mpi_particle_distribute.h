@@ -22,6 +22,7 @@ Please see the license file at the root of this repository, or at:
 #include "portage/accumulate/accumulate.h"
 #include "portage/support/portage.h"
 #include "portage/support/weight.h"
+#include "portage/support/smoothing_lengths.h"
 
 #include "mpi.h"
 
@@ -90,7 +91,7 @@ public:
   template<class SourceSwarm, class SourceState, class TargetSwarm, class TargetState>
   void distribute(SourceSwarm& source_swarm, SourceState& source_state,
                   TargetSwarm& target_swarm, TargetState& target_state,
-                  Wonton::vector<std::vector<std::vector<double>>>& smoothing_lengths,
+                  Meshfree::SmoothingLengthArray& smoothing_lengths,
                   Wonton::vector<Point<dim>>& source_extents,
                   Wonton::vector<Point<dim>>& target_extents,
                   Wonton::vector<Meshfree::Weight::Kernel>& kernel_types,
@@ -262,79 +263,55 @@ public:
     *         the Scatter scheme                                              *
     ***************************************************************************/
     if (center == Meshfree::WeightCenter::Scatter) {
-      //collect smoothing length sizes and get max
-      std::vector<std::vector<double>> h0 = smoothing_lengths[0];
-      int smlen_dim = h0[0].size();
-      std::vector<int> smoothing_length_sizes(nb_source_points);
-      int max_slsize = 0;
-      for (int i = 0; i < nb_source_points; i++) {
-        std::vector<std::vector<double>> h = smoothing_lengths[i];
-        smoothing_length_sizes[i] = h.size();
-        max_slsize = std::max<int>(smoothing_length_sizes[i], max_slsize);
-        for (int j = 0; j < smoothing_length_sizes[i]; j++)
-          assert(h[j].size() == unsigned(smlen_dim));
-      }
-
-      //-----------------------------------------------
-      //communicate smoothing length sizes
-      std::vector<std::vector<int>> sourceSendSmoothSizes(nb_ranks);
-      for (int i = 0; i < nb_ranks; ++i) {
-        if ((!sendFlags[i]) || (i == rank))
-          continue;
-        else {
-          for (int j = 0; j < sourcePtsToSendSize[i]; ++j) {
-            int smlensize = smoothing_length_sizes[sourcePtsToSend[i][j]];
-            sourceSendSmoothSizes[i].push_back(smlensize);
-          }
-        }
-      }
-      //move this smoothing length size data
-      std::vector<int> sourceRecvSmoothSizes(src_info.new_num);
-      moveField<int>(&src_info, rank, nb_ranks, MPI_INT, 1,
-                     sourceSendSmoothSizes, &sourceRecvSmoothSizes);
+      //get the largest number of smoothing lengths rows among all ranks,
+      //each particle sends its rows padded to this size
+      int row_size = smoothing_lengths.row_size();
+      int max_rows = 0;
+      for (int i = 0; i < nb_source_points; i++)
+        max_rows = std::max(max_rows, smoothing_lengths.num_rows(i));
 
-      // update local source particle list with received new particles
-      for (int i = 0; i < src_info.new_num; ++i) {
-        int smlensize = sourceRecvSmoothSizes[i];
-        smoothing_length_sizes.push_back(smlensize);
-      }
-
-      // create cumulative received sizes
-      std::vector<int> recvSLSizeCum(src_info.new_num, 0);
-      for (int i = 1; i < src_info.new_num; ++i) recvSLSizeCum[i] += recvSLSizeCum[i - 1];
+      MPI_Allreduce(MPI_IN_PLACE, &row_size, 1, MPI_INT, MPI_MAX, comm_);
+      MPI_Allreduce(MPI_IN_PLACE, &max_rows, 1, MPI_INT, MPI_MAX, comm_);
+      int const padded_size = max_rows * row_size;
 
       //-----------------------------------------------
-      //communicate smoothing_lengths
-      //this is inefficient if doing facets and there is large variation in number of facets
+      //communicate smoothing length rows count and size, and values
+      std::vector<std::vector<int>> sourceSendSmoothRows(nb_ranks);
       std::vector<std::vector<double>> sourceSendSmoothLengths(nb_ranks);
       for (int i = 0; i < nb_ranks; ++i) {
         if ((!sendFlags[i]) || (i == rank))
           continue;
         else {
+          auto& values = sourceSendSmoothLengths[i];
+          values.reserve(sourcePtsToSendSize[i] * padded_size);
           for (int j = 0; j < sourcePtsToSendSize[i]; ++j) {
-            std::vector<std::vector<double>> smlen(max_slsize, std::vector<double>(smlen_dim, 0.));
-            std::vector<std::vector<double>> h = smoothing_lengths[sourcePtsToSend[i][j]];
-            std::copy(h.begin(), h.end(), smlen.begin());
-            for (int k = 0; k < max_slsize; ++k)
-              for (int d = 0; d < smlen_dim; d++)
-                sourceSendSmoothLengths[i].push_back(smlen[k][d]);
+            int const particle = sourcePtsToSend[i][j];
+            double const* h = smoothing_lengths.data(particle);
+            int const size = smoothing_lengths.data_size(particle);
+            sourceSendSmoothRows[i].push_back(smoothing_lengths.num_rows(particle));
+            sourceSendSmoothRows[i].push_back(smoothing_lengths.row_size(particle));
+            values.insert(values.end(), h, h + size);
+            values.resize(values.size() + padded_size - size, 0.);
           }
         }
       }
       //move this smoothing length data
-      std::vector<double> sourceRecvSmoothLengths(src_info.new_num * max_slsize * smlen_dim);
-      moveField<double>(&src_info, rank, nb_ranks, MPI_DOUBLE, max_slsize * smlen_dim,
+      std::vector<int> sourceRecvSmoothRows(2 * src_info.new_num);
+      moveField<int>(&src_info, rank, nb_ranks, MPI_INT, 2,
+                     sourceSendSmoothRows, &sourceRecvSmoothRows);
+
+      std::vector<double> sourceRecvSmoothLengths(src_info.new_num * padded_size);
+      moveField<double>(&src_info, rank, nb_ranks, MPI_DOUBLE, padded_size,
                         sourceSendSmoothLengths, &sourceRecvSmoothLengths);
 
       // update local source particle list with received new particles
-      for (int i = 0; i < src_info.new_num; ++i) {
-        std::vector<std::vector<double>> smlen
-          (smoothing_length_sizes[nb_source_points + i], std::vector<double>(smlen_dim));
-        for (int k = 0; k < smoothing_length_sizes[nb_source_points + i]; k++)
-          for (int d = 0; d < smlen_dim; ++d)
-            smlen[k][d] = sourceRecvSmoothLengths[recvSLSizeCum[i] + k * smlen_dim + d];
+      if (smoothing_lengths.row_size() == 0)
+        smoothing_lengths = Meshfree::SmoothingLengthArray(row_size);
 
-        smoothing_lengths.push_back(smlen);
+      for (int i = 0; i < src_info.new_num; ++i) {
+        smoothing_lengths.push_back(sourceRecvSmoothLengths.data() + i * padded_size,
+                                    sourceRecvSmoothRows[2 * i],
+                                    sourceRecvSmoothRows[2 * i + 1]);
       }
 
       //-----------------------------------------------
@@ -482,6 +459,31 @@ public:
 
   } // distribute
 
+  /*!
+    @brief Distribute source particles with nested smoothing lengths.
+           They are converted to a flat array for the exchange, and back.
+    @see the method above for the parameters.
+   */
+  template<class SourceSwarm, class SourceState, class TargetSwarm, class TargetState>
+  void distribute(SourceSwarm& source_swarm, SourceState& source_state,
+                  TargetSwarm& target_swarm, TargetState& target_state,
+                  Wonton::vector<std::vector<std::vector<double>>>& smoothing_lengths,
+                  Wonton::vector<Point<dim>>& source_extents,
+                  Wonton::vector<Point<dim>>& target_extents,
+                  Wonton::vector<Meshfree::Weight::Kernel>& kernel_types,
+                  Wonton::vector<Meshfree::Weight::Geometry>& geom_types,
+                  Meshfree::WeightCenter center = Meshfree::WeightCenter::Gather) {
+
+    Meshfree::SmoothingLengthArray flat_smoothing_lengths(smoothing_lengths);
+    distribute(source_swarm, source_state, target_swarm, target_state,
+               flat_smoothing_lengths, source_extents, target_extents,
+               kernel_types, geom_types, center);
+
+    // only source smoothing lengths are exchanged
+    if (center == Meshfree::WeightCenter::Scatter)
+      smoothing_lengths = flat_smoothing_lengths.nested();
+  }
+
 private:
 
   MPI_Comm comm_ = MPI_COMM_NULL;
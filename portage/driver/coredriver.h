@@ -17,6 +17,7 @@
 #include <type_traits>
 #include <memory>
 #include <limits>
+#include <numeric>
 
 #include "wonton/support/wonton.h"
 #include "wonton/support/Point.h"
@@ -27,6 +28,7 @@
 #endif
 
 #include "portage/support/portage.h"
+#include "portage/support/bucket_sort.h"
 
 #ifdef PORTAGE_HAS_TANGRAM
 #include "tangram/driver/driver.h"
@@ -37,7 +39,12 @@
 #endif
 
 #include "portage/intersect/dummy_interface_reconstructor.h"
+#include "portage/intersect/matpoly_cache.h"
+#include "portage/intersect/dual_cell_cache.h"
 #include "portage/interpolate/gradient.h"
+#include "portage/interpolate/quadfit.h"
+#include "portage/interpolate/remap_operator.h"
+#include "portage/interpolate/compressed_weights.h"
 #include "portage/driver/parts.h"
 #include "portage/driver/fix_mismatch.h"
 
@@ -147,6 +154,7 @@ class CoreDriver {
         source_state_(source_state),
         target_state_(target_state),
         gradient_(source_mesh, source_state),
+        quadfit_stencils_(std::make_shared<QuadfitStencils<D>>()),
         executor_(executor)
   {
 #ifdef WONTON_ENABLE_MPI
@@ -242,6 +250,9 @@ class CoreDriver {
               InterfaceReconstructorType, Matpoly_Splitter, Matpoly_Clipper>
         intersector(source_mesh_, source_state_, target_mesh_, num_tols_);
 
+    cache_dual_cells();
+    attach_dual_cell_cache(intersector, dual_cells_);
+
     Wonton::transform(target_mesh_.begin(ONWHAT, PARALLEL_OWNED),
                        target_mesh_.end(ONWHAT, PARALLEL_OWNED),
                        candidates.begin(),
@@ -255,6 +266,11 @@ class CoreDriver {
    * @brief Deduce weights for reverse remap by transposing
    *        the weight matrix used for forward remap.
    *
+   * The forward weights are flattened in target order, then bucketed
+   * by source entity with the parallel counting sort of bucket_sort.
+   * The reverse lists are filled and split per source entity in
+   * parallel, and the targets of each source entity remain sorted.
+   *
    * @param forward_weights: weights list for forward remap.
    * @return weights list for reverse remap.
    */
@@ -265,15 +281,62 @@ class CoreDriver {
     int const num_target_entities = target_mesh_.num_entities(ONWHAT, PARALLEL_OWNED);
     assert(unsigned(num_target_entities) == forward_weights.size());
 
-    std::vector<entity_weights_t> reverse_weights(num_source_entities);
+    // 1. flatten the forward weights: offset of each target list,
+    //    then target and rank in its list of each forward weight.
+    std::vector<int> forward_offsets(num_target_entities + 1, 0);
 
-    for (int t = 0; t < num_target_entities; ++t) {
+    Wonton::for_each(target_mesh_.begin(ONWHAT, PARALLEL_OWNED),
+                     target_mesh_.end(ONWHAT, PARALLEL_OWNED), [&](int t) {
       entity_weights_t const& list = forward_weights[t];
-      for (auto const& weight : list) {
-        int const& s = weight.entityID;
-        reverse_weights[s].emplace_back(t, weight.weights);
+      forward_offsets[t + 1] = list.size();
+    });
+
+    std::partial_sum(forward_offsets.begin(), forward_offsets.end(),
+                     forward_offsets.begin());
+
+    int const num_weights = forward_offsets[num_target_entities];
+    std::vector<int> target_of(num_weights), rank_of(num_weights);
+
+    Wonton::for_each(target_mesh_.begin(ONWHAT, PARALLEL_OWNED),
+                     target_mesh_.end(ONWHAT, PARALLEL_OWNED), [&](int t) {
+      for (int k = forward_offsets[t]; k < forward_offsets[t + 1]; ++k) {
+        target_of[k] = t;
+        rank_of[k] = k - forward_offsets[t];
       }
-    }
+    });
+
+    // 2. bucket them by source entity, items of each bucket keep
+    //    their flattened order hence are sorted by target.
+    auto source_of = [&](int k, int& first, int& last) {
+      entity_weights_t const& list = forward_weights[target_of[k]];
+      first = list[rank_of[k]].entityID;
+      last = first + 1;
+    };
+
+    std::vector<int> reverse_offsets, order;
+    bucket_sort<int>(num_weights, num_source_entities, source_of,
+                     reverse_offsets, order);
+
+    // 3. fill the flattened reverse lists then split them per source
+    //    entity, both in parallel since every slot is written once.
+    entity_weights_t flat(num_weights);
+    std::vector<int> slots(num_weights);
+    std::iota(slots.begin(), slots.end(), 0);
+
+    Wonton::for_each(slots.begin(), slots.end(), [&](int i) {
+      int const k = order[i];
+      int const t = target_of[k];
+      entity_weights_t const& list = forward_weights[t];
+      flat[i] = Weights_t(t, list[rank_of[k]].weights);
+    });
+
+    std::vector<entity_weights_t> reverse_weights(num_source_entities);
+
+    Wonton::for_each(source_mesh_.begin(ONWHAT, ALL),
+                     source_mesh_.end(ONWHAT, ALL), [&](int s) {
+      reverse_weights[s].assign(flat.begin() + reverse_offsets[s],
+                                flat.begin() + reverse_offsets[s + 1]);
+    });
 
 #ifdef WONTON_ENABLE_THRUST
     Wonton::vector<entity_weights_t> result(num_source_entities);
@@ -290,11 +353,13 @@ class CoreDriver {
     num_tols_.min_absolute_distance = min_absolute_distance;
     num_tols_.min_absolute_volume = min_absolute_volume;
     num_tols_.user_tolerances = true;
+    dual_cells_.reset();  // convexity of dual cells depends on tolerances
   }
 
   /// Set all numerical tolerances
   void set_num_tols(const NumericTolerances_t& num_tols) {
     num_tols_ = num_tols;
+    dual_cells_.reset();  // convexity of dual cells depends on tolerances
   }
 
 #ifdef PORTAGE_HAS_TANGRAM
@@ -392,143 +457,198 @@ class CoreDriver {
                                                    cell_mat_centroids);
     interface_reconstructor_->reconstruct(executor_);
 
-    // Make an intersector which knows about the source state (to be
-    // able to query the number of materials, etc) and also knows
-    // about the interface reconstructor so that it can retrieve pure
-    // material polygons
-
-    Intersect<D, CELL, SourceMesh, SourceState, TargetMesh,
-              InterfaceReconstructorType, Matpoly_Splitter, Matpoly_Clipper>
-        intersector(source_mesh_, source_state_, target_mesh_, num_tols_,
-                    interface_reconstructor_);
+    // Build the material polytopes of mixed cells and their moments
+    // once, so that they are shared by the intersection, gradient
+    // and interpolation phases instead of being rebuilt by each one.
+    matpoly_cache_ = std::make_shared<MatPolyCache<D>>();
+    matpoly_cache_->build(source_mesh_, *interface_reconstructor_);
+
+    // Make an intersector per material which knows about the source
+    // state (to be able to query the number of materials, etc) and also
+    // knows about the interface reconstructor so that it can retrieve
+    // pure material polygons. Each one is bound to its own material so
+    // that all materials can be processed in the same parallel pass.
+    // They are copied from the first one so that any material-independent
+    // data it precomputes, such as swept-face cutting planes, is shared
+    // by all of them.
+
+    using Intersector = Intersect<D, CELL, SourceMesh, SourceState, TargetMesh,
+                                  InterfaceReconstructorType,
+                                  Matpoly_Splitter, Matpoly_Clipper>;
+
+    std::vector<std::unique_ptr<Intersector>> intersectors(nmats);
+    for (int m = 0; m < nmats; m++) {
+      if (m == 0) {
+        intersectors[m] = std::make_unique<Intersector>(source_mesh_, source_state_,
+                                                        target_mesh_, num_tols_,
+                                                        interface_reconstructor_);
+        cache_face_group_cuts(*(intersectors[m]));
+      } else {
+        intersectors[m] = std::make_unique<Intersector>(*(intersectors[0]));
+      }
+      intersectors[m]->set_material(m);
+      attach_matpoly_cache(*(intersectors[m]), matpoly_cache_);
+    }
 
-    // Assume (with no harm for sizing purposes) that all materials
-    // in source made it into target
+    // Build a flattened (material, target cell) work list. A target
+    // cell is only intersected with a material if one of its candidates
+    // contains that material according to the source state, so that
+    // materials occupying few cells do not cost a pass over the whole
+    // target mesh.
+
+    int const nsourcecells = source_mesh_.num_entities(CELL, ALL);
+    std::vector<int> cell_mat_offsets(nsourcecells + 1, 0);
+    for (int c = 0; c < nsourcecells; c++)
+      cell_mat_offsets[c + 1] = cell_mat_offsets[c] + cell_num_mats[c];
+
+    std::vector<std::vector<int>> mat_candidate_cells(nmats);
+    std::vector<int> last_visited(nmats, -1);
+    for (int c = 0; c < ntargetcells; c++) {
+      std::vector<int> const& cell_candidates = candidates[c];
+      for (int s : cell_candidates) {
+        for (int i = cell_mat_offsets[s]; i < cell_mat_offsets[s + 1]; i++) {
+          int const m = cell_mat_ids[i];
+          if (last_visited[m] != c) {
+            last_visited[m] = c;
+            mat_candidate_cells[m].push_back(c);
+          }
+        }
+      }
+    }
 
-    std::vector<Wonton::vector<std::vector<Weights_t>>>
-        source_weights_by_mat(nmats);
+    std::vector<int> mat_work_offsets(nmats + 1, 0);
+    for (int m = 0; m < nmats; m++)
+      mat_work_offsets[m + 1] = mat_work_offsets[m] + mat_candidate_cells[m].size();
 
+    int const nwork = mat_work_offsets[nmats];
+    std::vector<int> work_material(nwork);
+    std::vector<int> work_cell(nwork);
     for (int m = 0; m < nmats; m++) {
-      std::vector<int> matcellstgt;
+      int const offset = mat_work_offsets[m];
+      int const nb_cells = mat_candidate_cells[m].size();
+      for (int i = 0; i < nb_cells; i++) {
+        work_material[offset + i] = m;
+        work_cell[offset + i] = mat_candidate_cells[m][i];
+      }
+    }
 
-      intersector.set_material(m);
+    // For each (material, target cell) pair get a list of
+    // candidate-weight pairings (in a traditional mesh, not particle
+    // mesh, the weights are moments). Note that this candidate list is
+    // different from the search candidate list in that it may not
+    // include some of the search candidates. Also, note that for 2nd
+    // order and higher remaps, we get multiple moments (0th, 1st, etc)
+    // for each target-source cell intersection
+    //
+    // NOTE: IDEALLY WE WOULD REUSE THE MESH-MESH INTERSECTIONS
+    // WHEN THE SOURCE CELL CONTAINS ONLY ONE MATERIAL
+
+    std::vector<int> work_items(nwork);
+    std::iota(work_items.begin(), work_items.end(), 0);
+
+    Wonton::vector<std::vector<Weights_t>> work_sources_and_wts(nwork);
+    Wonton::transform(work_items.begin(), work_items.end(),
+                      work_sources_and_wts.begin(),
+                      [&](int i) {
+                        int const c = work_cell[i];
+                        return (*(intersectors[work_material[i]]))(c, candidates[c]);
+                      });
+
+    // LOOK AT INTERSECTION WEIGHTS TO DETERMINE WHICH TARGET CELLS
+    // WILL GET NEW MATERIALS
+
+    std::vector<std::vector<int>> mat_work_kept(nmats);
+    std::vector<int> nmatcells(nmats, 0);
 
-      // For each cell in the target mesh get a list of
-      // candidate-weight pairings (in a traditional mesh, not
-      // particle mesh, the weights are moments). Note that this
-      // candidate list is different from the search candidate list in
-      // that it may not include some of the search candidates. Also,
-      // note that for 2nd order and higher remaps, we get multiple
-      // moments (0th, 1st, etc) for each target-source cell
-      // intersection
-      //
-      // NOTE: IDEALLY WE WOULD REUSE THE MESH-MESH INTERSECTIONS
-      // WHEN THE SOURCE CELL CONTAINS ONLY ONE MATERIAL
-      //
-      // UNFORTUNATELY, THE REQUIREMENT OF THE INTERSECT FUNCTOR IS
-      // THAT IT CANNOT MODIFY STATE, THIS MEANS WE CANNOT STORE THE
-      // MESH-MESH INTERSECTION VALUES AND REUSE THEM AS NECESSARY
-      // FOR MESH-MATERIAL INTERSECTION COMPUTATIONS. WE COULD DO
-      // SOME OTHER THINGS LIKE PROCESS ONLY TARGET CELLS THAT
-      // POSSIBLY INTERSECT MULTI-MATERIAL SOURCE CELLS; TARGET
-      // CELLS THAT ONLY INTERSECT SINGLE MATERIAL CELLS CAN REUSE
-      // MESH-MESH INTERSECTIONS (still have to determine the
-      // materials coming into the target cell though - a target
-      // cell intersecting pure cells of different materials will
-      // become mixed).
-
-
-      Wonton::vector<std::vector<Weights_t>> this_mat_sources_and_wts(ntargetcells);
-      Wonton::transform(target_mesh_.begin(CELL, PARALLEL_OWNED),
-                         target_mesh_.end(CELL, PARALLEL_OWNED),
-                         candidates.begin(),
-                         this_mat_sources_and_wts.begin(),
-                         intersector);
-
-      // LOOK AT INTERSECTION WEIGHTS TO DETERMINE WHICH TARGET CELLS
-      // WILL GET NEW MATERIALS
-
-      ntargetcells = target_mesh_.num_entities(CELL, PARALLEL_OWNED);
-
-      for (int c = 0; c < ntargetcells; c++) {
+    for (int m = 0; m < nmats; m++) {
+      for (int i = mat_work_offsets[m]; i < mat_work_offsets[m + 1]; i++) {
         std::vector<Weights_t> const& cell_mat_sources_and_weights =
-            this_mat_sources_and_wts[c];
-        int nwts = cell_mat_sources_and_weights.size();
+            work_sources_and_wts[i];
         double cell_mat_volume = 0.0;
-        for (int s = 0; s < nwts; s++) {
-          std::vector<double> const& wts = cell_mat_sources_and_weights[s].weights;
-          cell_mat_volume += wts[0];
-        }
+        for (auto const& weight : cell_mat_sources_and_weights)
+          cell_mat_volume += weight.weights[0];
         // Check that the volume of material we are adding to c is not miniscule
         if (cell_mat_volume > num_tols_.min_absolute_volume)
-          matcellstgt.push_back(c);
+          mat_work_kept[m].push_back(i);
       }
+      nmatcells[m] = mat_work_kept[m].size();
+    }
 
-      // If any processor is adding this material to the target state,
-      // add it on all the processors
+    // If any processor is adding a material to the target state, add
+    // it on all the processors. The counts of all materials are
+    // reduced in a single collective.
 
-      int nmatcells = matcellstgt.size();
-      int nmatcells_global = nmatcells;
+    std::vector<int> nmatcells_global(nmatcells);
 #ifdef WONTON_ENABLE_MPI
-      if (mycomm_!= MPI_COMM_NULL)
-        MPI_Allreduce(&nmatcells, &nmatcells_global, 1, MPI_INT, MPI_SUM,
-                      mycomm_);
+    if (mycomm_!= MPI_COMM_NULL and nmats > 0)
+      MPI_Allreduce(nmatcells.data(), nmatcells_global.data(), nmats,
+                    MPI_INT, MPI_SUM, mycomm_);
 #endif
 
-      if (nmatcells_global) {
-        int nmatstrg = target_state_.num_materials();
-        bool found = false;
-        int m2 = -1;
-        for (int i = 0; i < nmatstrg; i++)
-          if (target_state_.material_name(i) == source_state_.material_name(m)) {
-            found = true;
-            m2 = i;
-            break;
-          }
-        if (found) {  // material already present - just update its cell list
-          target_state_.mat_add_cells(m2, matcellstgt);
-        } else {
-          // add material along with the cell list
-
-          // NOTE: NOT ONLY DOES THIS ROUTINE ADD A MATERIAL AND ITS
-          // CELLS TO THE STATEMANAGER, IT ALSO MAKES SPACE FOR
-          // FIELD VALUES FOR THIS MATERIAL IN EVERY MULTI-MATERIAL
-          // VECTOR IN THE STATE MANAGER. THIS ENSURES THAT WHEN WE
-          // CALL mat_get_celldata FOR A MATERIAL IN MULTI-MATERIAL
-          // STATE VECTOR IT WILL ALREADY HAVE SPACE ALLOCATED FOR
-          // FIELD VALUES OF THAT MATERIAL. SOME STATE WRAPPERS
-          // COULD CHOOSE TO MAKE THIS A SIMPLER ROUTINE THAT ONLY
-          // STORES THE NAME AND THE CELLS IN THE MATERIAL AND
-          // ACTUALLY ALLOCATE SPACE FOR FIELD VALUES OF A MATERIAL
-          // IN A MULTI-MATERIAL FIELD WHEN mat_get_celldata IS
-          // INVOKED.
-
-          target_state_.add_material(source_state_.material_name(m),
-                                     matcellstgt);
+    // Assume (with no harm for sizing purposes) that all materials
+    // in source made it into target
+
+    std::vector<Wonton::vector<std::vector<Weights_t>>>
+        source_weights_by_mat(nmats);
+
+    for (int m = 0; m < nmats; m++) {
+
+      if (not nmatcells_global[m])
+        continue;  // maybe the target mesh does not overlap this material
+
+      std::vector<int> matcellstgt(nmatcells[m]);
+      for (int ic = 0; ic < nmatcells[m]; ic++)
+        matcellstgt[ic] = work_cell[mat_work_kept[m][ic]];
+
+      int nmatstrg = target_state_.num_materials();
+      bool found = false;
+      int m2 = -1;
+      for (int i = 0; i < nmatstrg; i++)
+        if (target_state_.material_name(i) == source_state_.material_name(m)) {
+          found = true;
+          m2 = i;
+          break;
         }
+      if (found) {  // material already present - just update its cell list
+        target_state_.mat_add_cells(m2, matcellstgt);
+      } else {
+        // add material along with the cell list
+
+        // NOTE: NOT ONLY DOES THIS ROUTINE ADD A MATERIAL AND ITS
+        // CELLS TO THE STATEMANAGER, IT ALSO MAKES SPACE FOR
+        // FIELD VALUES FOR THIS MATERIAL IN EVERY MULTI-MATERIAL
+        // VECTOR IN THE STATE MANAGER. THIS ENSURES THAT WHEN WE
+        // CALL mat_get_celldata FOR A MATERIAL IN MULTI-MATERIAL
+        // STATE VECTOR IT WILL ALREADY HAVE SPACE ALLOCATED FOR
+        // FIELD VALUES OF THAT MATERIAL. SOME STATE WRAPPERS
+        // COULD CHOOSE TO MAKE THIS A SIMPLER ROUTINE THAT ONLY
+        // STORES THE NAME AND THE CELLS IN THE MATERIAL AND
+        // ACTUALLY ALLOCATE SPACE FOR FIELD VALUES OF A MATERIAL
+        // IN A MULTI-MATERIAL FIELD WHEN mat_get_celldata IS
+        // INVOKED.
+
+        target_state_.add_material(source_state_.material_name(m),
+                                   matcellstgt);
       }
-      else
-        continue;  // maybe the target mesh does not overlap this material
 
       // Add volume fractions and centroids of materials to target mesh
       //
       // Also make list of sources/weights only for target cells that are
-      // getting this material - Can we avoid the copy?
+      // getting this material.
 
-      std::vector<double> mat_volfracs(nmatcells);
-      std::vector<Point<D>> mat_centroids(nmatcells);
+      std::vector<double> mat_volfracs(nmatcells[m]);
+      std::vector<Point<D>> mat_centroids(nmatcells[m]);
 
-      source_weights_by_mat[m].resize(nmatcells);
+      source_weights_by_mat[m].resize(nmatcells[m]);
 
-      for (int ic = 0; ic < nmatcells; ic++) {
-        int c = matcellstgt[ic];
+      for (int ic = 0; ic < nmatcells[m]; ic++) {
+        int const c = matcellstgt[ic];
         double matvol = 0.0;
         Point<D> matcen;
-        std::vector<Weights_t> const &
-            cell_mat_sources_and_weights = this_mat_sources_and_wts[c];
-        int nwts = cell_mat_sources_and_weights.size();
-        for (int s = 0; s < nwts; s++) {
-          std::vector<double> const& wts = cell_mat_sources_and_weights[s].weights;
+        std::vector<Weights_t> const& cell_mat_sources_and_weights =
+            work_sources_and_wts[mat_work_kept[m][ic]];
+        for (auto const& weight : cell_mat_sources_and_weights) {
+          std::vector<double> const& wts = weight.weights;
           matvol += wts[0];
           for (int d = 0; d < D; d++)
             matcen[d] += wts[d+1];
@@ -566,6 +686,7 @@ class CoreDriver {
     if (interface_reconstructor_) {
       if (not cached_multimat_stenc_) {
         gradient_.set_interface_reconstructor(interface_reconstructor_);
+        attach_matpoly_cache(gradient_, matpoly_cache_);
         gradient_.cache_matrices(Field_type::MULTIMATERIAL_FIELD);
         cached_multimat_stenc_ = true;
       }
@@ -700,6 +821,9 @@ class CoreDriver {
     // nb: make_unique or make_shared would copy the object
     auto kernel = (source_part == nullptr ? &gradient_
                                           : new Gradient(source_mesh_, source_state_, source_part));
+    cache_dual_cells(false);
+    attach_dual_cell_cache(*kernel, dual_cells_);
+
     // set gradient kernel options
     kernel->set_interpolation_variable(field_name, limiter_type, boundary_limiter_type);
 
@@ -785,6 +909,121 @@ class CoreDriver {
     return gradient_fields;
   }
 
+  /**
+   * @brief Compute the gradients of several fields in a single pass.
+   *
+   * Equivalent to calling compute_source_gradient for each field, but
+   * the stencil of each cell is traversed once for all fields. Fields
+   * must all be mesh fields or all be multi-material fields.
+   *
+   * @param field_names: the variable names.
+   * @param limiter_types: gradient limiter to use on internal regions per field.
+   * @param boundary_limiter_types: gradient limiter to use on boundary per field.
+   * @param material_id: material index if multi-material fields.
+   * @param source_part: the source mesh part to consider if any.
+   * @return the gradient field of each variable.
+   */
+  template<Entity_kind ONWHAT1 = ONWHAT,
+           typename = typename std::enable_if<ONWHAT1 == CELL>::type>
+  std::vector<Wonton::vector<Vector<D>>> compute_source_gradients(
+    std::vector<std::string> const& field_names,
+    std::vector<Limiter_type> const& limiter_types,
+    std::vector<Boundary_Limiter_type> const& boundary_limiter_types,
+    int material_id = 0,
+    const Part<SourceMesh, SourceState>* source_part = nullptr) {
+
+    int const nb_fields = field_names.size();
+    if (not nb_fields)
+      return {};
+
+    // owned entities and the index of their gradient in the field
+    std::vector<int> cells_owned;
+    std::vector<int> index_owned;
+    int nallent = 0;
+
+#ifdef PORTAGE_HAS_TANGRAM
+    bool const multimat =
+      source_state_.field_type(ONWHAT, field_names[0]) == Field_type::MULTIMATERIAL_FIELD;
+
+    if (multimat) {
+      if (not cached_multimat_stenc_)
+        cache_multimat_gradient_stencils();
+
+      if (not interface_reconstructor_)
+        throw std::runtime_error("interface reconstructor not set");
+
+      std::vector<int> mat_cells_all;
+      source_state_.mat_get_cells(material_id, &mat_cells_all);
+      nallent = mat_cells_all.size();
+
+      // Filter out GHOST cells
+      for (auto const& c : mat_cells_all) {
+        if (source_mesh_.cell_get_type(c) == PARALLEL_OWNED) {
+          cells_owned.push_back(c);
+          index_owned.push_back(source_state_.cell_index_in_material(c, material_id));
+        }
+      }
+    } else /* single material */ {
+#endif
+      nallent = source_mesh_.num_entities(ONWHAT, ALL);
+      int const nb_owned = source_mesh_.num_entities(ONWHAT, PARALLEL_OWNED);
+      cells_owned.resize(nb_owned);
+      std::iota(cells_owned.begin(), cells_owned.end(), 0);
+      index_owned = cells_owned;
+#ifdef PORTAGE_HAS_TANGRAM
+    }
+#endif
+
+    // use stored instance for mesh remap
+    // create a new instance for part-by-part
+    auto kernel = (source_part == nullptr ? &gradient_
+                                          : new Gradient(source_mesh_, source_state_, source_part));
+    kernel->set_interpolation_variables(field_names, limiter_types, boundary_limiter_types);
+
+#ifdef PORTAGE_HAS_TANGRAM
+    if (multimat) {
+      kernel->set_material(material_id);
+      kernel->set_interface_reconstructor(interface_reconstructor_);
+    }
+#endif
+
+    // compute all gradients of each owned cell at once,
+    // stored contiguously per cell.
+    int const nb_owned = cells_owned.size();
+    std::vector<Vector<D>> owned_gradients(nb_owned * nb_fields);
+    std::vector<int> positions(nb_owned);
+    std::iota(positions.begin(), positions.end(), 0);
+
+    Wonton::for_each(positions.begin(), positions.end(), [&](int i) {
+      kernel->compute_gradients(cells_owned[i], owned_gradients.data() + i * nb_fields);
+    });
+
+    if (source_part != nullptr) { delete kernel; }
+
+    // scatter them per field (ghost entries are zeroed out)
+    Vector<D> zerovec;
+    zerovec.zero();
+    std::vector<Wonton::vector<Vector<D>>> gradient_fields(nb_fields);
+    for (int f = 0; f < nb_fields; ++f) {
+      std::vector<Vector<D>> gradient_field(nallent, zerovec);
+      for (int i = 0; i < nb_owned; ++i)
+        gradient_field[index_owned[i]] = owned_gradients[i * nb_fields + f];
+      gradient_fields[f] = gradient_field;
+    }
+
+#ifdef WONTON_ENABLE_MPI
+    if (nprocs_ > 1) {
+#ifdef PORTAGE_HAS_TANGRAM
+      int const ghost_material = multimat ? material_id : -1;
+#else
+      int const ghost_material = -1;
+#endif
+      update_gradient_ghosts(gradient_fields, ghost_material);
+    }
+#endif
+    return gradient_fields;
+  }
+
   /**
    * @brief Interpolate mesh variable.
    *
@@ -820,6 +1059,7 @@ class CoreDriver {
 
     Interpolator interpolator(source_mesh_, target_mesh_, source_state_,
                               num_tols_);
+    attach_quadfit_stencils(interpolator, quadfit_stencils_);
     interpolator.set_interpolation_variable(srcvarname, gradients);
 
     // get a handle to a memory location where the target state
@@ -835,6 +1075,133 @@ class CoreDriver {
   }
 
 
+  /**
+   * @brief Store mesh-mesh weights in single precision.
+   *
+   * @param[in] sources_and_weights weights for mesh-mesh interpolation
+   * @return the compressed weights, with moments relative to the target
+   *         entities, to be passed to interpolate_mesh_var and check_mismatch.
+   */
+  CompressedWeights<D>
+  compress_weights(Wonton::vector<std::vector<Weights_t>> const& sources_and_weights) const {
+    return CompressedWeights<D>(sources_and_weights, target_mesh_, ONWHAT);
+  }
+
+
+  /**
+   * @brief Interpolate mesh variable using weights stored in single precision.
+   *
+   * @param[in] srcvarname  source mesh variable to remap
+   * @param[in] trgvarname  target mesh variable to remap
+   * @param[in] weights     compressed weights for mesh-mesh interpolation
+   * @param[in] gradients   gradients of the variable stored in single
+   *                        precision (can be nullptr for 1st order remap)
+   *
+   * The interpolator reads the moments of each target entity through
+   * a view which expands them in double precision on the fly, so that
+   * accumulations are still done in double precision.
+   */
+  template<typename T = double,
+           template<int, Entity_kind, class, class, class, class, class,
+                    template<class, int, class, class> class,
+                    class, class, class> class Interpolate
+           >
+  void interpolate_mesh_var(std::string srcvarname, std::string trgvarname,
+                            CompressedWeights<D> const& weights,
+                            CompressedGradients<D> const* gradients = nullptr) {
+
+    if (source_state_.get_entity(srcvarname) != ONWHAT) {
+#if defined(PORTAGE_DEBUG)
+      std::cerr << "Variable " << srcvarname << " not defined on Entity_kind "
+                << ONWHAT << ". Skipping!" << std::endl;
+#endif
+      return;
+    }
+
+    using Interpolator = Interpolate<D, ONWHAT,
+                                     SourceMesh, TargetMesh,
+                                     SourceState, TargetState,
+                                     T,
+                                     InterfaceReconstructorType,
+                                     Matpoly_Splitter, Matpoly_Clipper, CoordSys>;
+
+    Interpolator interpolator(source_mesh_, target_mesh_, source_state_,
+                              num_tols_);
+    set_compressed_interpolation_variable(interpolator, srcvarname, gradients);
+
+    T* target_field = nullptr;
+    target_state_.mesh_get_data(ONWHAT, trgvarname, &target_field);
+    assert(weights.size() <= target_mesh_.num_entities(ONWHAT, ALL));
+
+    Wonton::for_each(target_mesh_.begin(ONWHAT, PARALLEL_OWNED),
+                     target_mesh_.end(ONWHAT, PARALLEL_OWNED), [&](int t) {
+      target_field[t] = interpolator(t, weights[t]);
+    });
+  }
+
+
+  /**
+   * @brief Compile mesh-mesh weights into a first order remap operator.
+   *
+   * @param[in] sources_and_weights weights for mesh-mesh interpolation
+   * @param[in] traversal           whether to apply it target or source-major
+   * @return the sparse operator to be applied to any number of fields.
+   */
+  RemapOperator
+  build_remap_operator(Wonton::vector<std::vector<Weights_t>> const& sources_and_weights,
+                       RemapOperator::Traversal traversal =
+                         RemapOperator::Traversal::TARGET_MAJOR) const {
+    return RemapOperator(sources_and_weights, num_tols_, traversal);
+  }
+
+
+  /**
+   * @brief Interpolate a block of mesh variables at first order.
+   *
+   * @param[in] srcvarnames  source mesh variables to remap
+   * @param[in] trgvarnames  target mesh variables to remap
+   * @param[in] remap_op     operator compiled from mesh-mesh weights
+   *
+   * Equivalent to calling interpolate_mesh_var with Interpolate_1stOrder
+   * for each pair of variables, but the weights are traversed once for
+   * the whole block of fields.
+   */
+  void interpolate_mesh_vars(std::vector<std::string> const& srcvarnames,
+                             std::vector<std::string> const& trgvarnames,
+                             RemapOperator const& remap_op) {
+
+    int const num_vars = srcvarnames.size();
+    if (num_vars != static_cast<int>(trgvarnames.size()))
+      throw std::runtime_error("interpolate_mesh_vars: mismatched variable lists");
+
+    std::vector<double const*> source_fields;
+    std::vector<double*> target_fields;
+    source_fields.reserve(num_vars);
+    target_fields.reserve(num_vars);
+
+    for (int i = 0; i < num_vars; ++i) {
+      if (source_state_.get_entity(srcvarnames[i]) != ONWHAT) {
+#if defined(PORTAGE_DEBUG)
+        std::cerr << "Variable " << srcvarnames[i] << " not defined on Entity_kind "
+                  << ONWHAT << ". Skipping!" << std::endl;
+#endif
+        continue;
+      }
+
+      double const* source_field = nullptr;
+      double* target_field = nullptr;
+      source_state_.mesh_get_data(ONWHAT, srcvarnames[i], &source_field);
+      target_state_.mesh_get_data(ONWHAT, trgvarnames[i], &target_field);
+      source_fields.push_back(source_field);
+      target_fields.push_back(target_field);
+    }
+
+    assert(remap_op.num_rows() <= target_mesh_.num_entities(ONWHAT, ALL));
+    remap_op.apply(source_fields.data(), target_fields.data(),
+                   static_cast<int>(source_fields.size()));
+  }
+
+
   /**
    * @brief Interpolate mesh variable from source part to target part
    *
@@ -891,6 +1258,7 @@ class CoreDriver {
                                      Matpoly_Splitter, Matpoly_Clipper, CoordSys>;
 
     Interpolator interpolator(source_mesh_, target_mesh_, source_state_, num_tols_, partition);
+    attach_quadfit_stencils(interpolator, quadfit_stencils_);
     interpolator.set_interpolation_variable(srcvarname, gradients);
 
     // get a handle to a memory location where the target state
@@ -1027,7 +1395,8 @@ class CoreDriver {
     Interpolator interpolator(source_mesh_, target_mesh_,
                               source_state_, num_tols_,
                               interface_reconstructor_);
-      
+    attach_matpoly_cache(interpolator, matpoly_cache_);
+
     int const nmats = source_state_.num_materials();
 
     for (int m = 0; m < nmats; m++) {
@@ -1073,6 +1442,130 @@ class CoreDriver {
 
   }  // CoreDriver::interpolate_mat_var
 
+
+  /*! CoreDriver::interpolate_mat_vars
+
+    @brief interpolate several material variables at once
+
+    @param[in] srcvarnames  Material variable names on the source mesh
+
+    @param[in] trgvarnames  Material variable names on the target mesh
+
+    @param[in] sources_and_weights_by_mat  Intersection weights per material
+
+    @param[in] gradients  Gradient fields per variable and per material if
+    the interpolator requires them
+
+    Equivalent to calling interpolate_mat_var for each pair of variables,
+    but the target cells of every material are retrieved once for all the
+    variables, and all the variables of all the materials are interpolated
+    in a single parallel loop over a flattened (variable, material, cell)
+    index space. This avoids running one small loop per material and per
+    variable, which is inefficient when there are many materials with
+    few cells each.
+
+    Enable only for cells using SFINAE (see interpolate_mat_var).
+  */
+
+  template<typename T = double,
+           template<int, Entity_kind, class, class, class, class, class,
+                    template<class, int, class, class> class,
+                    class, class, class> class Interpolate,
+           Entity_kind ONWHAT1 = ONWHAT,
+           typename = typename std::enable_if<ONWHAT1 == CELL>::type>
+  void
+  interpolate_mat_vars(std::vector<std::string> const& srcvarnames,
+                       std::vector<std::string> const& trgvarnames,
+                       std::vector<Wonton::vector<std::vector<Weights_t>>> const& sources_and_weights_by_mat,
+                       std::vector<std::vector<Wonton::vector<Vector<D>>>>* gradients = nullptr) {
+
+    using Interpolator = Interpolate<D, ONWHAT,
+                                     SourceMesh, TargetMesh,
+                                     SourceState, TargetState,
+                                     T,
+                                     InterfaceReconstructorType,
+                                     Matpoly_Splitter, Matpoly_Clipper, CoordSys>;
+
+    int const nb_vars = srcvarnames.size();
+
+    if (trgvarnames.size() != srcvarnames.size())
+      throw std::runtime_error("interpolate_mat_vars: mismatched number of source and target variables");
+
+    if (gradients != nullptr and int(gradients->size()) != nb_vars)
+      throw std::runtime_error("interpolate_mat_vars: expected one gradient field per variable");
+
+    int const nmats = source_state_.num_materials();
+
+    // Flatten the target cells of all materials once, they are shared
+    // by all the variables. Material 'm' owns the range
+    // [offsets[m], offsets[m+1]) of the flattened lists.
+
+    std::vector<int> offsets(nmats + 1, 0);
+    std::vector<int> matcells;
+    std::vector<int> matids;
+
+    for (int m = 0; m < nmats; m++) {
+      std::vector<int> matcellstgt;
+      if (target_state_.mat_get_num_cells(m) > 0)
+        target_state_.mat_get_cells(m, &matcellstgt);
+      matcells.insert(matcells.end(), matcellstgt.begin(), matcellstgt.end());
+      matids.insert(matids.end(), matcellstgt.size(), m);
+      offsets[m + 1] = matcells.size();
+    }
+
+    int const nb_mat_cells = matcells.size();
+
+    // One interpolator and one target array per variable and material.
+    // Interpolators are set up sequentially since setting the material
+    // and variable updates their state.
+
+    std::vector<std::unique_ptr<Interpolator>> interpolators(nb_vars * nmats);
+    std::vector<T*> target_fields(nb_vars * nmats, nullptr);
+
+    for (int v = 0; v < nb_vars; v++) {
+      for (int m = 0; m < nmats; m++) {
+        int const k = v * nmats + m;
+        interpolators[k].reset(new Interpolator(source_mesh_, target_mesh_,
+                                                source_state_, num_tols_,
+                                                interface_reconstructor_));
+        attach_matpoly_cache(*interpolators[k], matpoly_cache_);
+
+        interpolators[k]->set_material(m);
+        auto mat_grad = (gradients != nullptr ? &((*gradients)[v][m]) : nullptr);
+        interpolators[k]->set_interpolation_variable(srcvarnames[v], mat_grad);
+
+        if (offsets[m + 1] > offsets[m]) {
+          target_state_.mat_get_celldata(trgvarnames[v], m, &(target_fields[k]));
+          assert(target_fields[k] != nullptr);
+        }
+      }
+    }
+
+    // interpolate all the variables of all the materials at once
+    std::vector<int> entries(nb_vars * nb_mat_cells);
+    std::iota(entries.begin(), entries.end(), 0);
+
+    Wonton::for_each(entries.begin(), entries.end(), [&](int e) {
+      int const v = e / nb_mat_cells;
+      int const i = e % nb_mat_cells;
+      int const m = matids[i];
+      int const k = v * nmats + m;
+      int const local = i - offsets[m];
+      // nb: 'auto' may imply unexpected behavior with thrust enabled.
+      std::vector<Weights_t> const& weights = sources_and_weights_by_mat[m][local];
+      target_fields[k][local] = (*interpolators[k])(matcells[i], weights);
+    });
+
+    // let the target state copy the values to their proper locations
+    // if its storage format is different (see interpolate_mat_var)
+    for (int v = 0; v < nb_vars; v++) {
+      for (int m = 0; m < nmats; m++) {
+        if (offsets[m + 1] > offsets[m])
+          target_state_.mat_add_celldata(trgvarnames[v], m, target_fields[v * nmats + m]);
+      }
+    }
+  }  // CoreDriver::interpolate_mat_vars
+
 #endif  // PORTAGE_HAS_TANGRAM
 
 
@@ -1084,8 +1577,9 @@ class CoreDriver {
 
     @returns   Whether the meshes are mismatched
   */
+  template<class SourcesAndWeights = Wonton::vector<std::vector<Weights_t>>>
   bool
-  check_mismatch(Wonton::vector<std::vector<Weights_t>> const& source_weights) {
+  check_mismatch(SourcesAndWeights const& source_weights) {
 
     // Instantiate mismatch fixer for later use
     if (not mismatch_fixer_) {
@@ -1160,11 +1654,55 @@ class CoreDriver {
   }
   
  private:
+
+#ifdef WONTON_ENABLE_MPI
+  /**
+   * @brief Update ghost values of several gradient fields.
+   *
+   * Each field goes through the ghost manager as for a single gradient
+   * field, so that its cached send and receive lists are reused.
+   *
+   * @param gradient_fields: the gradient fields to update.
+   * @param material_id: the material index, or -1 for mesh fields.
+   */
+  void update_gradient_ghosts(std::vector<Wonton::vector<Vector<D>>>& gradient_fields,
+                              int material_id) {
+    for (auto&& gradient_field : gradient_fields) {
+      if (material_id < 0)
+        source_ghost_manager_->update_mesh_ghost_values(gradient_field.data());
+      else
+        source_ghost_manager_->update_material_ghost_values(gradient_field.data(), material_id);
+    }
+  }
+#endif
+
+  /**
+   * @brief Build the dual cells of source and target nodes once, on
+   *        first use by the intersection or gradient phases.
+   *
+   * @param targets: whether the dual cells of target nodes are needed,
+   *                 the gradient phase only uses the source ones.
+   */
+  template<Entity_kind ONWHAT1 = ONWHAT>
+  typename std::enable_if<ONWHAT1 == NODE>::type cache_dual_cells(bool targets = true) {
+    if (not dual_cells_)
+      dual_cells_ = std::make_shared<DualCellCache<D>>();
+    if (not dual_cells_->has_sources())
+      dual_cells_->build_sources(source_mesh_, num_tols_);
+    if (targets and not dual_cells_->has_targets())
+      dual_cells_->build_targets(target_mesh_, num_tols_);
+  }
+
+  template<Entity_kind ONWHAT1 = ONWHAT>
+  typename std::enable_if<ONWHAT1 != NODE>::type cache_dual_cells(bool = true) {}
+
   SourceMesh const & source_mesh_;
   TargetMesh const & target_mesh_;
   SourceState & source_state_;  // May have to update ghost values
   TargetState & target_state_;
   Gradient gradient_;
+  std::shared_ptr<QuadfitStencils<D>> quadfit_stencils_;  // 3rd order remap
+  std::shared_ptr<DualCellCache<D>> dual_cells_;  // node remap
   NumericTolerances_t num_tols_ = DEFAULT_NUMERIC_TOLERANCES<D>;
   Wonton::Executor_type const *executor_;
 
@@ -1204,7 +1742,10 @@ class CoreDriver {
   // in 'intersect_materials' in the previous code. It may cause memory
   // issues at runtime.
   std::shared_ptr<InterfaceReconstructor> interface_reconstructor_;
-  
+
+  // Material polytopes of mixed source cells, filled once after
+  // interface reconstruction and shared by all the remap phases
+  std::shared_ptr<MatPolyCache<D>> matpoly_cache_;
 
   // Convert volume fraction and centroid data from compact
   // material-centric to compact cell-centric (ccc) form as needed
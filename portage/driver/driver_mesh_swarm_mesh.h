@@ -32,7 +32,9 @@ Please see the license file at the root of this repository, or at:
 #include "portage/support/weight.h"
 #include "portage/support/operator.h"
 #include "portage/support/faceted_setup.h"
+#include "portage/support/smoothing_lengths.h"
 #include "portage/accumulate/accumulate.h"
+#include "portage/accumulate/swarm_weights.h"
 #include "portage/estimate/estimate.h"
 #include "portage/driver/driver_swarm.h"
 
@@ -165,6 +167,12 @@ public:
                            Meshfree::oper::Type operator_spec = Meshfree::oper::LastOperator,
                            Wonton::vector<Meshfree::oper::Domain> const& operator_domains = {},
                            Wonton::vector<std::vector<Point<dim>>> const& operator_data = {}) {
+
+    // kept shape functions depend on the estimator but not on variables
+    if (estimator_type != estimate_ or basis_type != basis_ or
+        operator_spec != operator_spec_ or operator_spec != Meshfree::oper::LastOperator)
+      invalidate_weights();
+
 #ifndef NDEBUG
     assert(source_vars.size() == target_vars.size());
 
@@ -185,6 +193,60 @@ public:
     operator_data_    = operator_data;
   }
 
+  /*!
+    @brief Specify the names of the variables to be interpolated, along
+    with the part assignments of the particles.
+    @param[in] part_field name of field to use for part assignments, with faceted weights only
+    @param[in] part_tolerance tolerance for determining if part assignment matches a neighbor's assignment
+    @see the method above for the other parameters.
+  */
+  void set_remap_var_names(std::vector<std::string> const& source_vars,
+                           std::vector<std::string> const& target_vars,
+                           Meshfree::EstimateType const& estimator_type,
+                           Meshfree::basis::Type const& basis_type,
+                           Meshfree::oper::Type operator_spec,
+                           Wonton::vector<Meshfree::oper::Domain> const& operator_domains,
+                           Wonton::vector<std::vector<Point<dim>>> const& operator_data,
+                           std::string const& part_field,
+                           double part_tolerance) {
+
+    // kept shape functions also depend on the parts
+    if (part_field != part_field_ or part_tolerance != part_tolerance_)
+      invalidate_weights();
+
+    part_field_     = part_field;
+    part_tolerance_ = part_tolerance;
+    set_remap_var_names(source_vars, target_vars, estimator_type, basis_type,
+                        operator_spec, operator_domains, operator_data);
+  }
+
+  /*!
+    @brief Keep the shape functions of the remap for subsequent runs.
+
+    The first call to @c run converts the meshes to swarms, searches
+    neighbors and computes the shape functions of cell and node variables
+    as usual, but keeps them afterwards. The next calls only apply them to
+    the current values of the variables on the meshes. The shape functions
+    are computed again if the estimator, basis, operator or part field
+    changes, but changes of the meshes or of the part assignments are not
+    detected: call @c invalidate_weights then. They are not distributed,
+    so @c run throws if the executor spans several ranks.
+    @param[in] reuse whether to keep and reuse the shape functions.
+  */
+  void set_reuse_weights(bool reuse) {
+    reuse_weights_ = reuse;
+    if (not reuse)
+      invalidate_weights();
+  }
+
+  /*!
+    @brief Discard the kept shape functions, when the meshes change.
+  */
+  void invalidate_weights() {
+    cell_weights_.clear();
+    node_weights_.clear();
+  }
+
   /*!
     @brief Get the names of the variables to be remapped from the
     source mesh.
@@ -226,6 +288,8 @@ public:
       MPI_Comm_rank(mycomm, &rank);
       MPI_Comm_size(mycomm, &nprocs);
       if (nprocs > 1) {
+        if (reuse_weights_)
+          throw std::runtime_error("Cannot reuse Mesh-Swarm-Mesh shape functions in distributed mode");
 #if defined(PORTAGE_DEBUG)
         std::cerr << "Cannot run Mesh-Swarm-Mesh driver in distributed mode yet";
         std::cerr << std::endl;
@@ -260,8 +324,12 @@ public:
       }
     }
 
+    // reuse the kept shape functions if any
+    bool const cached_cells = reuse_weights_ and not cell_weights_.empty()
+                              and cell_weights_.num_targets() == target_mesh_.num_owned_cells();
+
     // Collect all cell based variables and remap them
-    if (not source_cellvar_names.empty()) {
+    if (not source_cellvar_names.empty() and not cached_cells) {
       // convert mesh and state wrappers to swarm ones
       Wonton::Swarm<dim> source_swarm(source_mesh_, Wonton::CELL);
       Wonton::Swarm<dim> target_swarm(target_mesh_, Wonton::CELL);
@@ -269,23 +337,24 @@ public:
       Wonton::SwarmState<dim> target_swarm_state(target_state_, Wonton::CELL);
 
       // set up smoothing lengths and extents
-      Wonton::vector<std::vector<std::vector<double>>> smoothing_lengths;
-      std::vector<std::vector<double>> default_lengths(1, std::vector<double>(dim));
+      SmoothingLengthArray smoothing_lengths;
       Wonton::vector<Wonton::Point<dim>> weight_extents, other_extents;
-      Wonton::vector<std::vector<std::vector<double>>> part_smoothing; // only for faceted,scatter,parts
+      SmoothingLengthArray part_smoothing; // only for faceted,scatter,parts
 
       if (geometry_ == Weight::FACETED) {
         using Weight::faceted_setup_cell;
+        Wonton::vector<std::vector<std::vector<double>>> facets;
+        Wonton::vector<std::vector<std::vector<double>>> part_facets;
 
         if (part_field_ == "NONE") {
           switch (center_) {
             case Scatter: faceted_setup_cell<dim>(source_mesh_,
-                                                  smoothing_lengths,
+                                                  facets,
                                                   weight_extents,
                                                   smoothing_factor_,
                                                   boundary_factor_); break;
             case Gather:  faceted_setup_cell<dim>(target_mesh_,
-                                                  smoothing_lengths,
+                                                  facets,
                                                   weight_extents,
                                                   smoothing_factor_,
                                                   boundary_factor_); break;
@@ -297,26 +366,31 @@ public:
             case Scatter:
               // Set smoothing_factor to 1/4 to make weight support exactly equal to cell volume.
               // Store these smoothing lengths off on the side for later use in the swarm driver.
-              faceted_setup_cell<dim>(source_mesh_, part_smoothing,
+              faceted_setup_cell<dim>(source_mesh_, part_facets,
                                       dummy_extents, 0.25, 0.25);
               // Get usual smoothing lengths and extents
               faceted_setup_cell<dim>(source_mesh_,
-                                      smoothing_lengths, weight_extents,
+                                      facets, weight_extents,
                                       smoothing_factor_, boundary_factor_);
               break;
             case Gather: faceted_setup_cell<dim>(target_mesh_, target_state_,
                                                  part_field_, part_tolerance_,
-                                                 smoothing_lengths, weight_extents,
+                                                 facets, weight_extents,
                                                  smoothing_factor_, boundary_factor_);
             break;
             default: break;
           }
         }
+        smoothing_lengths = facets;
+        part_smoothing = part_facets;
       } else /* part_field_ != NONE */ {
         int ncells = (center_ == Scatter ? source_mesh_.num_owned_cells()
                                          : target_mesh_.num_owned_cells());
 
-        smoothing_lengths.resize(ncells, default_lengths);
+        // a single row of lengths per cell
+        smoothing_lengths = SmoothingLengthArray(dim);
+        smoothing_lengths.reserve(ncells, ncells * dim);
+        std::vector<double> h(dim);
 
         for (int i = 0; i < ncells; i++) {
           double radius = 0.0;
@@ -326,9 +400,8 @@ public:
             default: break;
           }
 
-          std::vector<std::vector<double>> h = smoothing_lengths[i];
-          h[0] = std::vector<double>(dim, 2. * radius * smoothing_factor_);
-          smoothing_lengths[i] = h;
+          std::fill(h.begin(), h.end(), 2. * radius * smoothing_factor_);
+          smoothing_lengths.push_back(h.data(), 1);
         }
       }
 
@@ -362,21 +435,30 @@ public:
                                       estimate_, basis_, operator_spec_,
                                       operator_domains_, operator_data_,
                                       part_field_, part_tolerance_, part_smoothing);
-      // do the remap
-      swarm_remap.run(executor, true);
-
-      // transfer data back to target mesh
-      for (auto&& name : target_cellvar_names) {
-        auto& swarm_field = target_swarm_state.get_field(name);
-        double* mesh_field;
-        target_state_.mesh_get_data(Wonton::CELL, name, &mesh_field);
-        for (int i = 0; i < target_swarm_state.get_size(); i++)
-          mesh_field[i] = swarm_field[i];
+      if (reuse_weights_) {
+        // only keep the shape functions, applied below
+        swarm_remap.compute_weights(executor);
+        cell_weights_ = swarm_remap.weights();
+      } else {
+        // do the remap
+        swarm_remap.run(executor, true);
+
+        // transfer data back to target mesh
+        for (auto&& name : target_cellvar_names) {
+          auto& swarm_field = target_swarm_state.get_field(name);
+          double* mesh_field;
+          target_state_.mesh_get_data(Wonton::CELL, name, &mesh_field);
+          for (int i = 0; i < target_swarm_state.get_size(); i++)
+            mesh_field[i] = swarm_field[i];
+        }
       }
 
       delete swarm_remap_ptr;
     }
 
+    if (not source_cellvar_names.empty() and reuse_weights_)
+      apply_weights(Wonton::CELL, cell_weights_, source_cellvar_names, target_cellvar_names);
+
     // Wonton::NODE VARIABLE SECTION ------------------------------------------
 
     // get node variable names
@@ -390,17 +472,16 @@ public:
       }
     }
 
-    if (not source_nodevar_names.empty()) {
+    bool const cached_nodes = reuse_weights_ and not node_weights_.empty()
+                              and node_weights_.num_targets() == target_mesh_.num_owned_nodes();
+
+    if (not source_nodevar_names.empty() and not cached_nodes) {
       // convert mesh and state wrappers to swarm ones
       Wonton::Swarm<dim> source_swarm(source_mesh_, Wonton::NODE);
       Wonton::Swarm<dim> target_swarm(target_mesh_, Wonton::NODE);
       Wonton::SwarmState<dim> source_swarm_state(source_state_, Wonton::NODE);
       Wonton::SwarmState<dim> target_swarm_state(target_state_, Wonton::NODE);
 
-      // create smoothing lengths
-      Wonton::vector<std::vector<std::vector<double>>> smoothing_lengths;
-      std::vector<std::vector<double>> default_lengths(1, std::vector<double>(dim));
-
       if (geometry_ == Weight::FACETED) {
         throw std::runtime_error("Cannot do FACETED weights for nodal variables yet.");
       }
@@ -408,7 +489,10 @@ public:
       int nnodes = (center_ == Scatter ? source_mesh_.num_owned_nodes()
                                        : target_mesh_.num_owned_nodes());
 
-      smoothing_lengths.resize(nnodes, default_lengths);
+      // create smoothing lengths, a single row of lengths per node
+      SmoothingLengthArray smoothing_lengths(dim);
+      smoothing_lengths.reserve(nnodes, nnodes * dim);
+      std::vector<double> h(dim);
 
       for (int i = 0; i < nnodes; i++) {
         double radius = 0.0;
@@ -418,9 +502,8 @@ public:
           default: break;
         }
 
-        std::vector<std::vector<double>> h = smoothing_lengths[i];
-        h[0] = std::vector<double>(dim, radius * smoothing_factor_);
-        smoothing_lengths[i] = h;
+        std::fill(h.begin(), h.end(), radius * smoothing_factor_);
+        smoothing_lengths.push_back(h.data(), 1);
       }
 
       // create swarm remap driver
@@ -432,19 +515,28 @@ public:
       swarm_remap.set_remap_var_names(source_nodevar_names, target_nodevar_names,
                                       LocalRegression, basis_);
 
-      // do the remap
-      swarm_remap.run(executor, true);
-
-      // transfer data back to target mesh
-      for (auto&& name : target_nodevar_names) {
-        auto& swarm_field = target_swarm_state.get_field(name);
-        double* mesh_field;
-        target_state_.mesh_get_data(Wonton::NODE, name, &mesh_field);
-        for (int i = 0; i < target_swarm_state.get_size(); i++)
-          mesh_field[i] = swarm_field[i];
+      if (reuse_weights_) {
+        // only keep the shape functions, applied below
+        swarm_remap.compute_weights(executor);
+        node_weights_ = swarm_remap.weights();
+      } else {
+        // do the remap
+        swarm_remap.run(executor, true);
+
+        // transfer data back to target mesh
+        for (auto&& name : target_nodevar_names) {
+          auto& swarm_field = target_swarm_state.get_field(name);
+          double* mesh_field;
+          target_state_.mesh_get_data(Wonton::NODE, name, &mesh_field);
+          for (int i = 0; i < target_swarm_state.get_size(); i++)
+            mesh_field[i] = swarm_field[i];
+        }
       }
     }
 
+    if (not source_nodevar_names.empty() and reuse_weights_)
+      apply_weights(Wonton::NODE, node_weights_, source_nodevar_names, target_nodevar_names);
+
 #if defined(PORTAGE_DEBUG)
     float elapsed = timer::elapsed(tic);
     std::cout << "Mesh-Swarm-Mesh Time for Rank " << rank << " (s): " << elapsed << std::endl;
@@ -452,6 +544,33 @@ public:
   }
 
 private:
+  /*!
+    @brief Apply kept shape functions directly to mesh variables.
+
+    Swarms derived from meshes list their cells or nodes in the same
+    order, so no conversion of the variables to swarm ones is needed.
+    @param[in] onwhat the kind of the variables.
+    @param[in] weights the shape functions of the target entities.
+    @param[in] source_vars names of the source variables.
+    @param[in] target_vars names of the target variables.
+  */
+  void apply_weights(Wonton::Entity_kind onwhat,
+                     Meshfree::SwarmWeights const& weights,
+                     std::vector<std::string> const& source_vars,
+                     std::vector<std::string> const& target_vars) {
+
+    int const nvars = source_vars.size();
+    std::vector<double const*> source_fields(nvars, nullptr);
+    std::vector<double*> target_fields(nvars, nullptr);
+
+    for (int i = 0; i < nvars; ++i) {
+      source_state_.mesh_get_data(onwhat, source_vars[i], &source_fields[i]);
+      target_state_.mesh_get_data(onwhat, target_vars[i], &target_fields[i]);
+    }
+
+    weights.apply(source_fields.data(), target_fields.data(), nvars);
+  }
+
   SourceMesh_Wrapper const& source_mesh_;
   TargetMesh_Wrapper const& target_mesh_;
   SourceState_Wrapper const& source_state_;
@@ -471,6 +590,9 @@ private:
   Wonton::vector<Meshfree::oper::Domain> operator_domains_ {};
   Wonton::vector<std::vector<Point<dim>>> operator_data_ {};
   int dim_ = 2;
+  bool reuse_weights_ = false;
+  Meshfree::SwarmWeights cell_weights_ {};
+  Meshfree::SwarmWeights node_weights_ {};
 };  // class MSM_Driver
 
 }  // namespace Portage
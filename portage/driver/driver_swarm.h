@@ -9,6 +9,7 @@
 #include <algorithm>
 #include <vector>
 #include <iterator>
+#include <numeric>
 #include <string>
 #include <utility>
 #include <iostream>
@@ -22,9 +23,13 @@
 #include "portage/support/timer.h"
 #include "portage/support/basis.h"
 #include "portage/support/weight.h"
+#include "portage/support/smoothing_lengths.h"
 #include "portage/support/operator.h"
 #include "portage/search/search_simple_points.h"
+#include "portage/search/search_particle_parts.h"
+#include "portage/search/search_points_knn.h"
 #include "portage/accumulate/accumulate.h"
+#include "portage/accumulate/swarm_weights.h"
 #include "portage/estimate/estimate.h"
 
 #ifdef WONTON_ENABLE_MPI
@@ -63,12 +68,10 @@ public:
    * @param source_state: a reference to the source state
    * @param target_swarm: a reference to the target swarm
    * @param target_state: a reference to the target state
-   * @param smoothing_lengths: a vector of smoothing lengths for each
-   *                           target particle - the three levels of vectors
-   *                           allow for a polygonal/polyhedral shaped support
-   *                           around each target particle and a vector of
-   *                           smoothing lengths for each facet of the
-   *                           polygonal/polyhedral support.
+   * @param smoothing_lengths: smoothing lengths for each target particle,
+   *                           given as one row of lengths, or one row per
+   *                           facet of a polygonal/polyhedral support. The
+   *                           former nested vectors are implicitly converted.
    * @param kernel_types: types of weight kernels (B4, SQUARE, etc) to use.
    * @param geom_types: geometry of the supports (ELLIPTIC, TENSOR, FACETED)
    *                    of the weight functions to use.
@@ -81,7 +84,7 @@ public:
               SourceState& source_state,
               TargetSwarm const& target_swarm,
               TargetState& target_state,
-              SmoothingLengths const& smoothing_lengths,
+              SmoothingLengthArray const& smoothing_lengths,
               Weight::Kernel const kernel_type = Weight::B4,
               Weight::Geometry const support_geom_type = Weight::ELLIPTIC,
               WeightCenter const center=Gather)
@@ -107,12 +110,10 @@ public:
    * @param source_state: a reference to the source state
    * @param target_swarm: a reference to the target swarm
    * @param target_state: a reference to the target state
-   * @param smoothing_lengths: a vector of smoothing lengths for each
-   *                           target particle - the three levels of vectors
-   *                           allow for a polygonal/polyhedral shaped support
-   *                           around each target particle and a vector of
-   *                           smoothing lengths for each facet of the
-   *                           polygonal/polyhedral support.
+   * @param smoothing_lengths: smoothing lengths for each target particle,
+   *                           given as one row of lengths, or one row per
+   *                           facet of a polygonal/polyhedral support. The
+   *                           former nested vectors are implicitly converted.
    * @param kernel_types: types of weight kernels (B4, SQUARE, etc) to use.
    * @param geom_types: geometry of the supports (ELLIPTIC, TENSOR, FACETED)
    *                    of the weight functions to use.
@@ -125,7 +126,7 @@ public:
               SourceState& source_state,
               TargetSwarm const& target_swarm,
               TargetState& target_state,
-              SmoothingLengths const& smoothing_lengths,
+              SmoothingLengthArray const& smoothing_lengths,
               Wonton::vector<Weight::Kernel> const& kernel_types,
               Wonton::vector<Weight::Geometry> const& geom_types,
               WeightCenter const center = Gather)
@@ -154,12 +155,10 @@ public:
    * @param source_state: a reference to the source state
    * @param target_swarm: a reference to the target swarm
    * @param target_state: a reference to the target state
-   * @param smoothing_lengths: a vector of smoothing lengths for each
-   *                           target particle - the three levels of vectors
-   *                           allow for a polygonal/polyhedral shaped support
-   *                           around each target particle and a vector of
-   *                           smoothing lengths for each facet of the
-   *                           polygonal/polyhedral support.
+   * @param smoothing_lengths: smoothing lengths for each target particle,
+   *                           given as one row of lengths, or one row per
+   *                           facet of a polygonal/polyhedral support. The
+   *                           former nested vectors are implicitly converted.
    * @param source_extents: extents for source swarm
    * @param target_extents: extents for target swarm
    * @param center: specify whether gather-form or scatter-form weights are used.
@@ -171,7 +170,7 @@ public:
               SourceState& source_state,
               TargetSwarm const& target_swarm,
               TargetState& target_state,
-              SmoothingLengths const& smoothing_lengths,
+              SmoothingLengthArray const& smoothing_lengths,
               Wonton::vector<Point<dim>> const& source_extents,
               Wonton::vector<Point<dim>> const& target_extents,
               WeightCenter const center = Gather)
@@ -197,7 +196,7 @@ public:
      default: throw std::runtime_error("invalid weight center type");
    }
 
-   assert(smoothing_lengths.size() == unsigned(swarm_size));
+   assert(smoothing_lengths.size() == swarm_size);
 #endif
 
     kernel_types_.resize(swarm_size, Weight::POLYRAMP);
@@ -255,7 +254,7 @@ public:
                            Wonton::vector<std::vector<Point<dim>>> const& operator_data = {},
                            std::string part_field = "NONE",
                            double part_tolerance = 0.0,
-                           SmoothingLengths const& part_smoothing = {}) {
+                           SmoothingLengthArray const& part_smoothing = {}) {
 
     assert(source_vars.size() == target_vars.size());
     // variables names
@@ -281,6 +280,62 @@ public:
     part_smoothing_ = part_smoothing;
   }
 
+  /**
+   * @brief Fuse the accumulate and estimate steps.
+   *
+   * By default, the shape functions of all target particles are computed
+   * and stored before being applied to each variable. In fused mode, the
+   * target particles are processed by tiles in parallel: the shape
+   * functions of a tile are applied to all the remapped variables then
+   * discarded. It bounds the memory used by the shape functions when a
+   * few variables are remapped once.
+   *
+   * @param fused: whether to fuse the accumulate and estimate steps.
+   * @param tile_size: number of target particles per tile.
+   */
+  void set_fused_estimate(bool fused, int tile_size = 256) {
+    assert(tile_size > 0);
+    fused_estimate_ = fused;
+    tile_size_      = tile_size;
+  }
+
+  /**
+   * @brief Set the number of source neighbors retrieved per target particle.
+   *
+   * It only applies to searches retrieving a fixed number of neighbors,
+   * such as 'SearchPointsKNN', and is ignored by the others.
+   *
+   * @param num_neighbors: number of neighbors, or 0 to use twice the
+   *                       size of the basis set in 'set_remap_var_names'.
+   */
+  void set_num_neighbors(int num_neighbors) {
+    assert(num_neighbors >= 0);
+    num_neighbors_ = num_neighbors;
+  }
+
+  /**
+   * @brief Adapt the smoothing lengths of target particles to their neighbors.
+   *
+   * Once the search is done, the smoothing lengths of each target particle
+   * are set such that its weight function support encloses all its source
+   * neighbors, the support factor being the ratio of the support radius to
+   * the distance of the farthest one. Combined with a search retrieving the
+   * k nearest neighbors, it gives each target the same number of neighbors
+   * whatever the local density of source particles. It applies to gather
+   * weights with non-faceted supports only. The adapted smoothing lengths
+   * are only kept for the current remap, the given ones are then only used
+   * for the distribution and the search.
+   *
+   * @param adaptive: whether to adapt the smoothing lengths.
+   * @param support_factor: ratio of the support radius to the distance
+   *                        of the farthest neighbor, at least one.
+   */
+  void set_adaptive_smoothing(bool adaptive, double support_factor = 1.1) {
+    assert(support_factor >= 1.);
+    adaptive_smoothing_ = adaptive;
+    support_factor_     = support_factor;
+  }
+
   /**
    * @brief Get all source swarm variables names.
    *
@@ -324,11 +379,9 @@ public:
 #endif
 
     // useful aliases
-    using Searcher = Search<dim, SourceSwarm, TargetSwarm>;
     using Accumulator = Accumulate<dim, SourceSwarm, TargetSwarm>;
     using Estimator = Estimate<dim, SourceState>;
 
-    int nb_source = source_swarm_.num_particles(Wonton::PARALLEL_OWNED);
     int nb_target = target_swarm_.num_particles(Wonton::PARALLEL_OWNED);
     int nb_fields = source_vars_.size();
 
@@ -360,81 +413,17 @@ public:
 #endif
 
     // SEARCH
-    Wonton::vector<std::vector<int>> candidates(nb_target);
+    auto candidates = find_candidates();
 
-    // Get an instance of the desired search algorithm type which is expected
-    // to be a functor with an operator() of the right form
-    Searcher search(source_swarm_, target_swarm_,
-                    source_extents_, target_extents_, weight_center_);
-
-    Wonton::transform(target_swarm_.begin(Wonton::PARTICLE, Wonton::PARALLEL_OWNED),
-                       target_swarm_.end(Wonton::PARTICLE, Wonton::PARALLEL_OWNED),
-                       candidates.begin(), search);
+    // adapted smoothing lengths only apply to this remap
+    SmoothingLengthArray const adapted = adaptive_smoothing_
+                                         ? adapt_smoothing_lengths(candidates)
+                                         : SmoothingLengthArray();
+    SmoothingLengthArray const& smoothing_lengths = adaptive_smoothing_
+                                                    ? adapted : smoothing_lengths_;
 
     tot_seconds_srch = timer::elapsed(tic);
 
-    // In case of faceted, scatter, and parts, obtain part assignments on target particles.
-    // Eliminate neighbors that aren't in the same part.
-    // It is assumed that the faceted weight function will be non-zero only on the
-    // source cell it came from, which is achieved by using a smoothing factor of 1/2.
-    // It is also assumed no target point will appear in more than one source cell.
-    if (geom_types_[0] == Weight::FACETED and weight_center_ == Scatter and part_field_!="NONE") {
-
-
-      // make storage for target part assignments
-      nb_source = source_swarm_.num_particles(Wonton::PARALLEL_OWNED);
-      nb_target = target_swarm_.num_particles(Wonton::PARALLEL_OWNED);
-
-      // get source part assignments
-      auto source_field_part = source_state_.get_field_dbl(part_field_);
-      std::vector<double> target_field_part(nb_target);
-
-      // create accumulator to evaluate weight function on source cells
-      Wonton::vector<Weight::Kernel> step_kern(nb_source, Weight::STEP);
-      Accumulator accumulator(source_swarm_, target_swarm_,
-                              estimator_type_, weight_center_,
-                              step_kern, geom_types_, part_smoothing_, basis_type_,
-                              operator_spec_, operator_domains_, operator_data_);
-
-      // loop over target points and set part assignments
-
-      for (int i = 0; i < nb_target; i++) {
-        std::vector<int> possibles = candidates[i];
-        for (auto&& neighbor : possibles) {
-          double weight = accumulator.weight(i, neighbor);
-          if (weight > 0.) {
-            double part_val = source_field_part[neighbor];
-            target_field_part[i] = part_val;
-#undef DEBUG_HERE
-#ifdef DEBUG_HERE
-            if (dim == 2) {
-              auto p1 = source_swarm_.get_particle_coordinates(nbr);
-              auto p2 = target_swarm_.get_particle_coordinates(i);
-              double h = part_smoothing_[neighbor][0][2];
-
-              std::cout << "i=" << i << " " << " neighbor=" << neighbor << " ";
-              std::cout << std::abs(p2[0]-p1[0])/h <<", "<< std::abs(p2[1]-p1[1])/h;
-              std::cout << " w= "<< weight <<" part= "<< part_val << std::endl;
-            }
-#endif
-#undef DEBUG_HERE
-          }
-        }
-      }
-
-      // loop over target points and dismiss neighbors that aren't in the same part
-      for (int i = 0; i < nb_target; i++) {
-        std::vector<int> new_candidates;
-        std::vector<int> possibles = candidates[i];
-        for (auto&& neighbor : possibles) {
-          if (std::abs(target_field_part[i] - source_field_part[neighbor]) < part_tolerance_) {
-            new_candidates.emplace_back(neighbor);
-          }
-        }
-        candidates[i] = new_candidates;
-      }
-    }
-
     // ACCUMULATE (build moment matrix, calculate shape functions)
     // EQUIVALENT TO INTERSECT IN MESH-MESH REMAP
     tic = timer::now();
@@ -443,9 +432,25 @@ public:
     // expected to be a functor with an operator() of the right form
     Accumulator accumulate(source_swarm_, target_swarm_,
                            estimator_type_, weight_center_, kernel_types_,
-                           geom_types_, smoothing_lengths_, basis_type_,
+                           geom_types_, smoothing_lengths, basis_type_,
                            operator_spec_, operator_domains_, operator_data_);
 
+    // ACCUMULATE AND ESTIMATE (all variables at once, by tiles)
+    if (fused_estimate_) {
+      accumulate_and_estimate<Estimator>(accumulate, candidates);
+
+      tot_seconds_xsect = timer::elapsed(tic, true);
+      tot_seconds = tot_seconds_dist + tot_seconds_srch + tot_seconds_xsect;
+
+      if (report_time) {
+        std::cout << "Swarm Transform Time Rank " << rank << " (s): " << tot_seconds << std::endl;
+        std::cout << "  Swarm Distribution Time Rank " << rank << " (s): " << tot_seconds_dist << std::endl;
+        std::cout << "  Swarm Search Time Rank " << rank << " (s): " << tot_seconds_srch << std::endl;
+        std::cout << "  Swarm Accumulate and Estimate Time Rank " << rank << " (s): " << tot_seconds_xsect << std::endl;
+      }
+      return;
+    }
+
     Wonton::vector<std::vector<Weights_t>> source_points_and_multipliers(nb_target);
 
     // For each particle in the target swarm get the shape functions
@@ -550,7 +555,143 @@ public:
 
   }  // run
 
+  /**
+   * @brief Compute and keep the shape functions of all target particles.
+   *
+   * It performs the search and accumulate steps of 'run' only, the
+   * shape functions are then applied to the current values of the
+   * variables by 'apply'. They remain valid as long as the swarms and
+   * smoothing lengths are unchanged, and must be invalidated or
+   * computed again otherwise. They are compressed as soon as each target
+   * particle is processed. Swarms are not distributed here since the
+   * values of the received source particles would be stale on the next
+   * 'apply', so the executor must not span several ranks.
+   *
+   * @param executor: the executor type: serial or parallel.
+   */
+  void compute_weights(Wonton::Executor_type const* executor = nullptr) {
+
+    check_single_rank(executor);
+
+    using Accumulator = Accumulate<dim, SourceSwarm, TargetSwarm>;
+
+    int const nb_target = target_swarm_.num_particles(Wonton::PARALLEL_OWNED);
+    auto candidates = find_candidates();
+
+    // adapted smoothing lengths only apply to this remap
+    SmoothingLengthArray const adapted = adaptive_smoothing_
+                                         ? adapt_smoothing_lengths(candidates)
+                                         : SmoothingLengthArray();
+    SmoothingLengthArray const& smoothing_lengths = adaptive_smoothing_
+                                                    ? adapted : smoothing_lengths_;
+
+    Accumulator accumulate(source_swarm_, target_swarm_,
+                           estimator_type_, weight_center_, kernel_types_,
+                           geom_types_, smoothing_lengths, basis_type_,
+                           operator_spec_, operator_domains_, operator_data_);
+
+    // each source neighbor gets a shape function
+    std::vector<int> row_sizes(nb_target);
+    for (int t = 0; t < nb_target; ++t) {
+      // nb: 'auto' may imply unexpected behavior with thrust enabled.
+      std::vector<int> const& neighbors = candidates[t];
+      row_sizes[t] = neighbors.size();
+    }
+
+    weights_.build(row_sizes, [&](int t) {
+      std::vector<int> const& neighbors = candidates[t];
+      return accumulate(t, neighbors);
+    });
+  }
+
+  /**
+   * @brief Apply the kept shape functions to the remapped variables.
+   *
+   * @param executor: the executor type: serial or parallel.
+   * @param component: the shape function component to use, for instance
+   *                   a derivative for regression estimates.
+   */
+  void apply(Wonton::Executor_type const* executor = nullptr, int component = 0) {
+    apply(source_vars_, target_vars_, executor, component);
+  }
+
+  /**
+   * @brief Apply the kept shape functions to the given variables.
+   *
+   * @param source_vars: a list of source swarm variables names.
+   * @param target_vars: a list of target swarm variables names.
+   * @param executor: the executor type: serial or parallel.
+   * @param component: the shape function component to use.
+   */
+  void apply(std::vector<std::string> const& source_vars,
+             std::vector<std::string> const& target_vars,
+             Wonton::Executor_type const* executor = nullptr,
+             int component = 0) {
+
+    check_single_rank(executor);
+
+    assert(source_vars.size() == target_vars.size());
+    int const nb_target = target_swarm_.num_particles(Wonton::PARALLEL_OWNED);
+
+    if (weights_.num_targets() != nb_target)
+      throw std::runtime_error("swarm weights must be computed before being applied");
+
+    if (component < 0 or component >= weights_.num_components())
+      throw std::runtime_error("invalid shape function component");
+
+    int const nb_fields = source_vars.size();
+    std::vector<double const*> source_fields(nb_fields);
+    std::vector<double*> target_fields(nb_fields);
+
+    for (int i = 0; i < nb_fields; ++i) {
+      source_fields[i] = source_state_.get_field(source_vars[i]).data();
+      target_fields[i] = target_state_.get_field(target_vars[i]).data();
+    }
+
+    weights_.apply(source_fields.data(), target_fields.data(), nb_fields, component);
+  }
+
+  /**
+   * @brief Get the kept shape functions, for instance to save them.
+   *
+   * @return the shape functions of all target particles.
+   */
+  SwarmWeights const& weights() const { return weights_; }
+
+  /**
+   * @brief Restore previously computed shape functions.
+   *
+   * @param weights: the shape functions of all target particles.
+   */
+  void set_weights(SwarmWeights const& weights) {
+    if (weights.num_targets() != target_swarm_.num_particles(Wonton::PARALLEL_OWNED))
+      throw std::runtime_error("swarm weights do not match the target swarm");
+    weights_ = weights;
+  }
+
+  /**
+   * @brief Discard the kept shape functions, when the swarms move.
+   */
+  void invalidate_weights() { weights_.clear(); }
+
 protected:
+  /**
+   * @brief Reject executors spanning several ranks.
+   *
+   * @param executor: the executor type: serial or parallel.
+   */
+  static void check_single_rank(Wonton::Executor_type const* executor) {
+#ifdef WONTON_ENABLE_MPI
+    auto mpiexecutor = dynamic_cast<Wonton::MPIExecutor_type const*>(executor);
+    if (mpiexecutor && mpiexecutor->mpicomm != MPI_COMM_NULL) {
+      int nprocs = 0;
+      MPI_Comm_size(mpiexecutor->mpicomm, &nprocs);
+      if (nprocs > 1)
+        throw std::runtime_error("kept swarm weights are not distributed");
+    }
+#endif
+  }
+
   /**
    * @brief Get swarm size according to weight center type.
    *
@@ -562,6 +703,165 @@ protected:
       : target_swarm_.num_particles(Wonton::PARALLEL_OWNED));
   }
 
+  /**
+   * @brief Find the source neighbors of each target particle.
+   *
+   * @return the list of source neighbors of each target particle.
+   */
+  Wonton::vector<std::vector<int>> find_candidates() {
+
+    using Searcher = Search<dim, SourceSwarm, TargetSwarm>;
+    using Accumulator = Accumulate<dim, SourceSwarm, TargetSwarm>;
+
+    int const nb_target = target_swarm_.num_particles(Wonton::PARALLEL_OWNED);
+
+    Wonton::vector<std::vector<int>> candidates(nb_target);
+
+    // Get an instance of the desired search algorithm type which is expected
+    // to be a functor with an operator() of the right form
+    Searcher search(source_swarm_, target_swarm_,
+                    source_extents_, target_extents_, weight_center_);
+
+    // searches retrieving a fixed number of neighbors
+    int const nb_neighbors = num_neighbors_ > 0 ? num_neighbors_
+                             : 2 * static_cast<int>(basis::function_size<dim>(basis_type_));
+    set_search_num_neighbors(search, nb_neighbors);
+
+    // In case of faceted, scatter, and parts, obtain part assignments on target particles.
+    // Eliminate neighbors that aren't in the same part.
+    // It is assumed that the faceted weight function will be non-zero only on the
+    // source cell it came from, which is achieved by using a smoothing factor of 1/2.
+    // It is also assumed no target point will appear in more than one source cell.
+    if (geom_types_[0] == Weight::FACETED and weight_center_ == Scatter and part_field_!="NONE") {
+
+      int const nb_source = source_swarm_.num_particles(Wonton::PARALLEL_OWNED);
+
+      // get source part assignments
+      auto const& source_field_part = source_state_.get_field_dbl(part_field_);
+
+      // create accumulator to evaluate weight function on source cells
+      Wonton::vector<Weight::Kernel> step_kern(nb_source, Weight::STEP);
+      Accumulator accumulator(source_swarm_, target_swarm_,
+                              estimator_type_, weight_center_,
+                              step_kern, geom_types_, part_smoothing_, basis_type_,
+                              operator_spec_, operator_domains_, operator_data_);
+
+      // filter the neighbors of each target within the search itself
+      SearchParticleParts<Searcher, Accumulator> search_parts(search, accumulator,
+                                                              source_field_part.data(),
+                                                              part_tolerance_);
+
+      Wonton::transform(target_swarm_.begin(Wonton::PARTICLE, Wonton::PARALLEL_OWNED),
+                         target_swarm_.end(Wonton::PARTICLE, Wonton::PARALLEL_OWNED),
+                         candidates.begin(), search_parts);
+    } else {
+      Wonton::transform(target_swarm_.begin(Wonton::PARTICLE, Wonton::PARALLEL_OWNED),
+                         target_swarm_.end(Wonton::PARTICLE, Wonton::PARALLEL_OWNED),
+                         candidates.begin(), search);
+    }
+
+    return candidates;
+  }
+
+  /**
+   * @brief Deduce the smoothing lengths of each target particle such that
+   *        its weight function support encloses all its source neighbors.
+   *
+   * A target without neighbors keeps its smoothing lengths.
+   *
+   * @param candidates: source neighbors of each target particle.
+   * @return the adapted smoothing lengths.
+   */
+  SmoothingLengthArray
+  adapt_smoothing_lengths(Wonton::vector<std::vector<int>> const& candidates) const {
+
+    if (weight_center_ != Gather)
+      throw std::runtime_error("adaptive smoothing lengths require gather weights");
+
+    int const nb_target = target_swarm_.num_particles(Wonton::PARALLEL_OWNED);
+    for (int t = 0; t < nb_target; ++t) {
+      if (geom_types_[t] == Weight::FACETED)
+        throw std::runtime_error("FACETED geometry is not available here");
+    }
+
+    std::vector<double> lengths(nb_target * dim);
+    std::vector<int> targets(nb_target);
+    std::iota(targets.begin(), targets.end(), 0);
+
+    Wonton::for_each(targets.begin(), targets.end(), [&](int t) {
+      auto const p = target_swarm_.get_particle_coordinates(t);
+      // nb: 'auto' may imply unexpected behavior with thrust enabled.
+      std::vector<int> const& neighbors = candidates[t];
+
+      double radius = 0.;
+      for (int s : neighbors) {
+        auto const q = source_swarm_.get_particle_coordinates(s);
+        double distance = 0.;
+        for (int d = 0; d < dim; ++d)
+          distance += (q[d] - p[d]) * (q[d] - p[d]);
+        radius = std::max(radius, std::sqrt(distance));
+      }
+
+      // weight kernels vanish at twice the smoothing length
+      for (int d = 0; d < dim; ++d)
+        lengths[t * dim + d] = radius > 0. ? 0.5 * support_factor_ * radius
+                                           : smoothing_lengths_(t, 0, d);
+    });
+
+    SmoothingLengthArray adapted(dim);
+    adapted.reserve(nb_target, nb_target * dim);
+    for (int t = 0; t < nb_target; ++t)
+      adapted.push_back(lengths.data() + t * dim, 1);
+
+    return adapted;
+  }
+
+  /**
+   * @brief Compute the shape functions of target particles by tiles and
+   *        apply them to all remapped variables at once.
+   *
+   * @tparam Estimator: the particle estimate type.
+   * @tparam Accumulator: the particle accumulate type.
+   * @param accumulate: the accumulate functor.
+   * @param candidates: source neighbors of each target particle.
+   */
+  template<class Estimator, class Accumulator>
+  void accumulate_and_estimate(Accumulator& accumulate,
+                               Wonton::vector<std::vector<int>> const& candidates) {
+
+    int const nb_target = target_swarm_.num_particles(Wonton::PARALLEL_OWNED);
+    int const nb_fields = source_vars_.size();
+    int const nb_tiles  = (nb_target + tile_size_ - 1) / tile_size_;
+
+    // one estimator per variable, shared by all tiles
+    std::vector<Estimator> estimators;
+    std::vector<double*> target_fields(nb_fields);
+    estimators.reserve(nb_fields);
+
+    for (int i = 0; i < nb_fields; ++i) {
+      estimators.emplace_back(source_state_);
+      estimators[i].set_variable(source_vars_[i]);
+      target_fields[i] = target_state_.get_field(target_vars_[i]).data();
+    }
+
+    std::vector<int> tiles(nb_tiles);
+    std::iota(tiles.begin(), tiles.end(), 0);
+
+    Wonton::for_each(tiles.begin(), tiles.end(), [&](int tile) {
+      int const first = tile * tile_size_;
+      int const last  = std::min(first + tile_size_, nb_target);
+
+      // shape functions of the tile, discarded once applied
+      std::vector<std::vector<Weights_t>> multipliers(last - first);
+      for (int t = first; t < last; ++t)
+        multipliers[t - first] = accumulate(t, candidates[t]);
+
+      for (int i = 0; i < nb_fields; ++i)
+        for (int t = first; t < last; ++t)
+          target_fields[i][t] = estimators[i](t, multipliers[t - first]);
+    });
+  }
+
   /**
    * @brief Check sizes according to weight center type.
    *
@@ -606,8 +906,7 @@ protected:
         if (geom_types_[i] == Weight::FACETED) {
           throw std::runtime_error("FACETED geometry is not available here");
         }
-        std::vector<std::vector<double>> temp = smoothing_lengths_[i];
-        target_extents_[i] = Point<dim>(temp[0]);
+        target_extents_[i] = extent(i);
       }
     } else if (weight_center_ == Scatter) {
       int const nb_source = source_swarm_.num_particles(Wonton::PARALLEL_OWNED);
@@ -618,12 +917,24 @@ protected:
         if (geom_types_[i] == Weight::FACETED) {
           throw std::runtime_error("FACETED geometry is not available here");
         }
-        std::vector<std::vector<double>> temp = smoothing_lengths_[i];
-        source_extents_[i] = Point<dim>(temp[0]);
+        source_extents_[i] = extent(i);
       }
     }
   }
 
+  /**
+   * @brief Get the search extent of a particle for non-faceted weights.
+   *
+   * @param i: particle index.
+   * @return its smoothing lengths.
+   */
+  Point<dim> extent(int i) const {
+    Point<dim> result;
+    for (int d = 0; d < dim; d++)
+      result[d] = smoothing_lengths_(i, 0, d);
+    return result;
+  }
+
 private:
   SourceSwarm& source_swarm_;
   TargetSwarm const& target_swarm_;
@@ -632,7 +943,7 @@ private:
   std::vector<std::string> source_vars_ {};
   std::vector<std::string> target_vars_ {};
   WeightCenter weight_center_ = Gather;
-  SmoothingLengths smoothing_lengths_ {};
+  SmoothingLengthArray smoothing_lengths_ {};
   Wonton::vector<Weight::Kernel> kernel_types_ {};
   Wonton::vector<Weight::Geometry> geom_types_ {};
   Wonton::vector<Point<dim>> source_extents_ {};
@@ -644,7 +955,13 @@ private:
   Wonton::vector<std::vector<Point<dim>>> operator_data_ {};
   std::string part_field_ = "";
   double part_tolerance_ = 0.0;
-  Wonton::vector<std::vector<std::vector<double>>> part_smoothing_ {};
+  SmoothingLengthArray part_smoothing_ {};
+  bool fused_estimate_ = false;
+  int tile_size_ = 256;
+  int num_neighbors_ = 0;
+  bool adaptive_smoothing_ = false;
+  double support_factor_ = 1.1;
+  SwarmWeights weights_ {};
 };  // class SwarmDriver
 
 }}  // namespace Portage::Meshfree
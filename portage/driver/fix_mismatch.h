@@ -151,9 +151,13 @@ class MismatchFixer {
 
   /// @brief Compute (and cache) whether the mesh domains are mismatched
   /// @param[in] sources_and_weights Intersection sources and moments (vols, centroids)
+  /// either as lists of Weights_t or as CompressedWeights
   /// @returns whether the mesh domains are mismatched
-  bool check_mismatch(
-    Wonton::vector<std::vector<Weights_t>> const & source_ents_and_weights) {
+  template<class SourcesAndWeights = Wonton::vector<std::vector<Weights_t>>>
+  bool check_mismatch(SourcesAndWeights const & source_ents_and_weights) {
+
+    // list of Weights_t, or view of the compressed weights of a target
+    using Row = typename SourcesAndWeights::value_type;
     
     // If we have already computed the mismatch, just return the result
     if (computed_mismatch_) return mismatch_;
@@ -224,7 +228,7 @@ class MismatchFixer {
 
     xsect_volumes_.resize(ntargetents_, 0.0);
     for (int t = 0; t < ntargetents_; t++) {
-      std::vector<Weights_t> const& sw_vec = source_ents_and_weights[t];
+      Row const& sw_vec = source_ents_and_weights[t];
       for (auto const& sw : sw_vec)
         xsect_volumes_[t] += sw.weights[0];
     }
@@ -267,7 +271,7 @@ class MismatchFixer {
       std::vector<double> source_covered_vol(source_ent_volumes_);
       for (auto it = target_mesh_.begin(onwhat, Entity_type::PARALLEL_OWNED);
            it != target_mesh_.end(onwhat, Entity_type::PARALLEL_OWNED); it++) {
-        std::vector<Weights_t> const& sw_vec = source_ents_and_weights[*it];
+        Row const& sw_vec = source_ents_and_weights[*it];
         for (auto const& sw : sw_vec)
           source_covered_vol[sw.entityID] -= sw.weights[0];
       }
@@ -306,7 +310,7 @@ class MismatchFixer {
            it != target_mesh_.end(onwhat, Entity_type::PARALLEL_OWNED); it++) {
         int t = *it;
         double covered_vol = 0.0;
-        std::vector<Weights_t> const& sw_vec = source_ents_and_weights[t];
+        Row const& sw_vec = source_ents_and_weights[t];
         for (auto const& sw : sw_vec)
           covered_vol += sw.weights[0];
         if (fabs(covered_vol-target_ent_volumes_[t])/target_ent_volumes_[t] > voldifftol_) {
@@ -948,31 +948,39 @@ int MMDriver<Search, Intersect, Interpolate, D,
     if (Interpolator::order == 2) { coredriver_cell.cache_multimat_gradient_stencils(); }
     
     int nmatvars = src_matvar_names.size();
-    std::vector<Wonton::vector<Vector<D>>> matgradients(nmats);
-
-    for (int i = 0; i < nmatvars; ++i) {
-      std::string const& srcvar = src_matvar_names[i];
-      std::string const& trgvar = trg_matvar_names[i];
-
-      if (Interpolator::order == 2) {
-        // set slope limiters
-        auto limiter = (limiters_.count(srcvar) ? limiters_[srcvar] : DEFAULT_LIMITER);
-        auto bndlimit = (bnd_limiters_.count(srcvar) ? bnd_limiters_[srcvar] : DEFAULT_BND_LIMITER);
-        // compute gradient field for each material
-        for (int m = 0; m < nmats; m++) {
-          matgradients[m] =
-            coredriver_cell.compute_source_gradient(src_matvar_names[i],
-                                                    limiter, bndlimit, m);
-        }
-        // interpolate
-        coredriver_cell.template interpolate_mat_var<double, Interpolate>
-          (srcvar, trgvar, source_ents_and_weights_mat, &matgradients);
-      } else {
-        // interpolate
-        coredriver_cell.template interpolate_mat_var<double, Interpolate>
-          (srcvar, trgvar, source_ents_and_weights_mat);
+
+    if (Interpolator::order == 2) {
+      // set slope limiters
+      std::vector<Limiter_type> limiters(nmatvars);
+      std::vector<Boundary_Limiter_type> bndlimiters(nmatvars);
+      for (int i = 0; i < nmatvars; ++i) {
+        std::string const& srcvar = src_matvar_names[i];
+        limiters[i] = (limiters_.count(srcvar) ? limiters_[srcvar] : DEFAULT_LIMITER);
+        bndlimiters[i] = (bnd_limiters_.count(srcvar) ? bnd_limiters_[srcvar] : DEFAULT_BND_LIMITER);
       }
-    }  // nmatvars
+
+      // compute gradient fields of all variables for each material
+      std::vector<std::vector<Wonton::vector<Vector<D>>>> matgradients(nmatvars);
+      for (int i = 0; i < nmatvars; ++i)
+        matgradients[i].resize(nmats);
+
+      for (int m = 0; m < nmats; m++) {
+        auto gradients_m =
+          coredriver_cell.compute_source_gradients(src_matvar_names, limiters,
+                                                   bndlimiters, m);
+        for (int i = 0; i < nmatvars; ++i)
+          matgradients[i][m] = std::move(gradients_m[i]);
+      }
+
+      // interpolate all variables of all materials at once
+      coredriver_cell.template interpolate_mat_vars<double, Interpolate>
+        (src_matvar_names, trg_matvar_names, source_ents_and_weights_mat,
+         &matgradients);
+    } else {
+      // interpolate all variables of all materials at once
+      coredriver_cell.template interpolate_mat_vars<double, Interpolate>
+        (src_matvar_names, trg_matvar_names, source_ents_and_weights_mat);
+    }
   }
 #endif
 
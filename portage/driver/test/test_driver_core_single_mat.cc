@@ -265,3 +265,80 @@ TEST(CellDriver, 3D_2ndOrder) {
 }  // CellDriver_3D_2ndOrder
 
 
+
+
+// Gradients of several fields computed in a single pass
+
+TEST(CellDriver, 2D_MultiField_Gradients) {
+
+  MPI_Comm comm = MPI_COMM_WORLD;
+
+  Jali::MeshFactory mesh_factory(comm);
+  mesh_factory.partitioner(Jali::Partitioner_type::BLOCK);
+
+  std::shared_ptr<Jali::Mesh> sourceMesh = mesh_factory(0.0, 0.0, 1.0, 1.0, 6, 4);
+  std::shared_ptr<Jali::Mesh> targetMesh = mesh_factory(0.0, 0.0, 1.0, 1.0, 5, 3);
+
+  std::shared_ptr<Jali::State> sourceState = Jali::State::create(sourceMesh);
+  std::shared_ptr<Jali::State> targetState = Jali::State::create(targetMesh);
+
+  Wonton::Jali_Mesh_Wrapper sourceMeshWrapper(*sourceMesh);
+  Wonton::Jali_Mesh_Wrapper targetMeshWrapper(*targetMesh);
+  Wonton::Jali_State_Wrapper sourceStateWrapper(*sourceState);
+  Wonton::Jali_State_Wrapper targetStateWrapper(*targetState);
+
+  int nsrccells = sourceMeshWrapper.num_entities(Wonton::Entity_kind::CELL,
+                                                 Wonton::Entity_type::ALL);
+
+  // linear fields with distinct gradients
+  std::vector<std::string> fields = {"density", "pressure", "energy"};
+  double exact_gradients[3][2] = {{1.0, 2.0}, {-3.0, 0.5}, {0.0, 4.0}};
+
+  for (int f = 0; f < 3; f++) {
+    std::vector<double> values(nsrccells);
+    for (int c = 0; c < nsrccells; c++) {
+      Wonton::Point<2> cen;
+      sourceMeshWrapper.cell_centroid(c, &cen);
+      values[c] = 1.0 + exact_gradients[f][0] * cen[0] + exact_gradients[f][1] * cen[1];
+    }
+    sourceStateWrapper.mesh_add_data(Wonton::Entity_kind::CELL, fields[f], values.data());
+    targetStateWrapper.mesh_add_data<double>(Wonton::Entity_kind::CELL, fields[f], 0.0);
+  }
+
+  Wonton::MPIExecutor_type executor(comm);
+
+  Portage::CoreDriver<2, Wonton::Entity_kind::CELL,
+                      Wonton::Jali_Mesh_Wrapper, Wonton::Jali_State_Wrapper>
+      d(sourceMeshWrapper, sourceStateWrapper,
+        targetMeshWrapper, targetStateWrapper, &executor);
+
+  std::vector<Portage::Limiter_type> limiters = {Portage::NOLIMITER,
+                                                 Portage::BARTH_JESPERSEN,
+                                                 Portage::NOLIMITER};
+  std::vector<Portage::Boundary_Limiter_type> bnd_limiters = {Portage::BND_NOLIMITER,
+                                                              Portage::BND_NOLIMITER,
+                                                              Portage::BND_ZERO_GRADIENT};
+
+  auto gradients = d.compute_source_gradients(fields, limiters, bnd_limiters);
+  ASSERT_EQ(gradients.size(), unsigned(3));
+
+  // same result as one field at a time, ghost cells included
+  for (int f = 0; f < 3; f++) {
+    auto expected = d.compute_source_gradient(fields[f], limiters[f], bnd_limiters[f]);
+    ASSERT_EQ(expected.size(), gradients[f].size());
+
+    for (int c = 0; c < nsrccells; c++) {
+      Wonton::Vector<2> const& approx_gradient = gradients[f][c];
+      Wonton::Vector<2> const& single_gradient = expected[c];
+      for (int dim = 0; dim < 2; dim++)
+        ASSERT_NEAR(single_gradient[dim], approx_gradient[dim], 1.0e-12);
+    }
+  }
+
+  // linear fields are reproduced away from zeroed boundaries
+  for (int c = 0; c < nsrccells; c++) {
+    Wonton::Vector<2> const& approx_gradient = gradients[0][c];
+    for (int dim = 0; dim < 2; dim++)
+      ASSERT_NEAR(exact_gradients[0][dim], approx_gradient[dim], 1.0e-12);
+  }
+}  // CellDriver_2D_MultiField_Gradients
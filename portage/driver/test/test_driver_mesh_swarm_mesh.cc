@@ -453,6 +453,85 @@ TEST_F(MSMDriverTest2D, 2D2ndOrderQuadraticIntegrate) {
 }
 
 
+TEST_F(MSMDriverTest2D, 2DReuseWeights) {
+
+  using Field = Wonton::StateVectorUni<>;
+  using SwarmRemap = Portage::MSM_Driver<Portage::SearchPointsByCells,
+                                         Accumulate, Estimate, 2,
+                                         Wonton::Simple_Mesh_Wrapper,
+                                         Wonton::Simple_State_Wrapper<Wonton::Simple_Mesh_Wrapper>>;
+
+  int const nb_source_cells = source_mesh_wrapper.num_owned_cells();
+  int const nb_source_nodes = source_mesh_wrapper.num_owned_nodes();
+  int const nb_target_cells = target_mesh_wrapper.num_owned_cells();
+  int const nb_target_nodes = target_mesh_wrapper.num_owned_nodes();
+
+  source_state.add(std::make_shared<Field>("celldata", Wonton::CELL,
+                                           std::vector<double>(nb_source_cells)));
+  source_state.add(std::make_shared<Field>("nodedata", Wonton::NODE,
+                                           std::vector<double>(nb_source_nodes)));
+
+  for (auto* state : { &target_state_one, &target_state_two }) {
+    state->add(std::make_shared<Field>("celldata", Wonton::CELL,
+                                       std::vector<double>(nb_target_cells)));
+    state->add(std::make_shared<Field>("nodedata", Wonton::NODE,
+                                       std::vector<double>(nb_target_nodes)));
+  }
+
+  std::vector<std::string> const remap_fields = { "celldata", "nodedata" };
+
+  // the same remap with shape functions kept across runs
+  SwarmRemap cached(source_mesh_wrapper, source_state,
+                    target_mesh_wrapper, target_state_two,
+                    0.75, 0.75, Weight::TENSOR, Weight::B4, Gather);
+  cached.set_remap_var_names(remap_fields, remap_fields, LocalRegression, basis::Quadratic);
+  cached.set_reuse_weights(true);
+
+  // kept shape functions are computed on a single rank
+#ifdef WONTON_ENABLE_MPI
+  Wonton::MPIExecutor_type mpi_executor(MPI_COMM_SELF);
+  Wonton::Executor_type const* executor = &mpi_executor;
+#else
+  Wonton::Executor_type const* executor = nullptr;
+#endif
+
+  Wonton::Flat_Mesh_Wrapper<double> source_flat_mesh;
+  source_flat_mesh.initialize(source_mesh_wrapper);
+
+  auto& cell_data = source_state.get<Field>("celldata")->get_data();
+  auto& node_data = source_state.get<Field>("nodedata")->get_data();
+
+  for (int step = 0; step < 3; ++step) {
+    // update source fields
+    for (int i = 0; i < nb_source_cells; ++i) {
+      Wonton::Point<2> c;
+      source_flat_mesh.cell_centroid(i, &c);
+      cell_data[i] = (step + 1) * compute_quadratic_field_2d(c) + step;
+    }
+
+    for (int i = 0; i < nb_source_nodes; ++i) {
+      Wonton::Point<2> p;
+      source_flat_mesh.node_get_coordinates(i, &p);
+      node_data[i] = compute_linear_field_2d(p) - step;
+    }
+
+    SwarmRemap fresh(source_mesh_wrapper, source_state,
+                     target_mesh_wrapper, target_state_one,
+                     0.75, 0.75, Weight::TENSOR, Weight::B4, Gather);
+    fresh.set_remap_var_names(remap_fields, remap_fields, LocalRegression, basis::Quadratic);
+    fresh.run();
+    cached.run(executor);
+
+    for (auto&& name : remap_fields) {
+      auto const& expected = target_state_one.get<Field>(name)->get_data();
+      auto const& result = target_state_two.get<Field>(name)->get_data();
+      ASSERT_EQ(expected.size(), result.size());
+      for (unsigned i = 0; i < expected.size(); ++i)
+        ASSERT_NEAR(expected[i], result[i], 1.e-12);
+    }
+  }
+}
+
 TEST_F(MSMDriverTest3D, 3D1stOrderLinear) {
   unitTest<Portage::IntersectRnD,
            Portage::Interpolate_1stOrder,
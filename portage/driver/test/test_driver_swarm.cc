@@ -9,6 +9,7 @@ Please see the license file at the root of this repository, or at:
 #include <memory>
 #include <cassert>
 #include <cmath>
+#include <sstream>
 #include <string>
 
 #include "gtest/gtest.h"
@@ -31,6 +32,7 @@ Please see the license file at the root of this repository, or at:
 
 #include "portage/support/portage.h"
 #include "portage/search/search_points_by_cells.h"
+#include "portage/search/search_points_knn.h"
 
 namespace {
 // avoid long namespaces
@@ -617,6 +619,206 @@ TEST_F(IntegrateDriverTest3D, 3D_LinearFieldLinearBasis) {
     (compute_linear_field<3>, 3./2.);
 }
 
+TEST(Fused, 2D) {
+
+  using Remapper = SwarmDriver<Portage::SearchPointsByCells,
+                               Accumulate, Estimate, 2,
+                               Wonton::Swarm<2>, Wonton::SwarmState<2>>;
+
+  Wonton::Swarm<2> source_swarm(17 * 17, 2, 0, 0.0, 1.0, 0.0, 1.0);
+  Wonton::Swarm<2> target_swarm(11 * 11, 2, 0, 0.0, 1.0, 0.0, 1.0);
+  Wonton::SwarmState<2> source_state(source_swarm);
+  Wonton::SwarmState<2> target_state(target_swarm);
+
+  int const nb_source = source_swarm.num_owned_particles();
+  int const nb_target = target_swarm.num_owned_particles();
+
+  Wonton::vector<double> linear(nb_source), quadratic(nb_source);
+  for (int i = 0; i < nb_source; ++i) {
+    auto const p = source_swarm.get_particle_coordinates(i);
+    linear[i] = compute_linear_field<2>(p);
+    quadratic[i] = compute_quadratic_field<2>(p);
+  }
+
+  source_state.add_field("linear", linear);
+  source_state.add_field("quadratic", quadratic);
+
+  std::vector<std::string> const source_vars = { "linear", "quadratic" };
+  std::vector<std::string> const stored_vars = { "linear", "quadratic" };
+  std::vector<std::string> const fused_vars  = { "linear_fused", "quadratic_fused" };
+
+  for (auto&& name : stored_vars)
+    target_state.add_field(name, Wonton::vector<double>(nb_target, 0.));
+  for (auto&& name : fused_vars)
+    target_state.add_field(name, Wonton::vector<double>(nb_target, 0.));
+
+  Wonton::vector<std::vector<std::vector<double>>> smoothing(nb_target, {{0.25, 0.25}});
+
+  // remap with stored shape functions, then with fused tiles
+  // whose size does not divide the number of targets
+  Remapper stored(source_swarm, source_state, target_swarm, target_state, smoothing);
+  stored.set_remap_var_names(source_vars, stored_vars, LocalRegression, basis::Quadratic);
+  stored.run(nullptr, false);
+
+  Remapper fused(source_swarm, source_state, target_swarm, target_state, smoothing);
+  fused.set_remap_var_names(source_vars, fused_vars, LocalRegression, basis::Quadratic);
+  fused.set_fused_estimate(true, 7);
+  fused.run(nullptr, false);
+
+  for (int f = 0; f < 2; ++f) {
+    auto& expected = target_state.get_field(stored_vars[f]);
+    auto& result = target_state.get_field(fused_vars[f]);
+    for (int i = 0; i < nb_target; ++i)
+      ASSERT_DOUBLE_EQ(expected[i], result[i]);
+  }
+}
+
+TEST(CachedWeights, 2D) {
+
+  using Remapper = SwarmDriver<Portage::SearchPointsByCells,
+                               Accumulate, Estimate, 2,
+                               Wonton::Swarm<2>, Wonton::SwarmState<2>>;
+
+  Wonton::Swarm<2> source_swarm(17 * 17, 2, 0, 0.0, 1.0, 0.0, 1.0);
+  Wonton::Swarm<2> target_swarm(11 * 11, 2, 0, 0.0, 1.0, 0.0, 1.0);
+  Wonton::SwarmState<2> source_state(source_swarm);
+  Wonton::SwarmState<2> target_state(target_swarm);
+
+  int const nb_source = source_swarm.num_owned_particles();
+  int const nb_target = target_swarm.num_owned_particles();
+
+  Wonton::vector<double> values(nb_source);
+  for (int i = 0; i < nb_source; ++i)
+    values[i] = compute_quadratic_field<2>(source_swarm.get_particle_coordinates(i));
+
+  source_state.add_field("field", values);
+  target_state.add_field("field", Wonton::vector<double>(nb_target, 0.));
+  target_state.add_field("cached", Wonton::vector<double>(nb_target, 0.));
+
+  Wonton::vector<std::vector<std::vector<double>>> smoothing(nb_target, {{0.25, 0.25}});
+  std::vector<std::string> const source_vars = { "field" };
+  std::vector<std::string> const cached_vars = { "cached" };
+
+  Remapper remapper(source_swarm, source_state, target_swarm, target_state, smoothing);
+  remapper.set_remap_var_names(source_vars, source_vars, LocalRegression, basis::Quadratic);
+
+  Remapper cached(source_swarm, source_state, target_swarm, target_state, smoothing);
+  cached.set_remap_var_names(source_vars, cached_vars, LocalRegression, basis::Quadratic);
+  ASSERT_THROW(cached.apply(), std::runtime_error);
+  cached.compute_weights();
+
+  // shape functions are reused while the field values change
+  for (int step = 0; step < 3; ++step) {
+    auto& source_field = source_state.get_field("field");
+    for (int i = 0; i < nb_source; ++i)
+      source_field[i] += 0.5 * step;
+
+    remapper.run(nullptr, false);
+    cached.apply();
+
+    auto& expected = target_state.get_field("field");
+    auto& result = target_state.get_field("cached");
+    for (int i = 0; i < nb_target; ++i)
+      ASSERT_NEAR(expected[i], result[i], 1.e-12);
+  }
+
+  // saved shape functions are restored in another driver
+  std::stringstream stream;
+  cached.weights().write(stream);
+
+  SwarmWeights weights;
+  weights.read(stream, nb_source);
+  Remapper restored(source_swarm, source_state, target_swarm, target_state, smoothing);
+  restored.set_weights(weights);
+  restored.apply(source_vars, { "field" });
+
+  auto& expected = target_state.get_field("cached");
+  auto& result = target_state.get_field("field");
+  for (int i = 0; i < nb_target; ++i)
+    ASSERT_DOUBLE_EQ(expected[i], result[i]);
+
+  // derivative of the field along x
+  target_state.add_field("dx", Wonton::vector<double>(nb_target, 0.));
+  cached.apply(source_vars, { "dx" }, nullptr, 1);
+  ASSERT_THROW(cached.apply(nullptr, 6), std::runtime_error);
+
+  auto const& field = source_state.get_field("field");
+  auto const& dx = target_state.get_field("dx");
+  for (int i = 0; i < nb_target; ++i)
+    ASSERT_DOUBLE_EQ(dx[i], cached.weights().apply(i, field.data(), 1));
+
+  // moving swarms requires computing them again
+  cached.invalidate_weights();
+  ASSERT_THROW(cached.apply(), std::runtime_error);
+}
+
+TEST(NearestNeighbors, 2D) {
+
+  using Remapper = SwarmDriver<Portage::SearchPointsKNN,
+                               Accumulate, Estimate, 2,
+                               Wonton::Swarm<2>, Wonton::SwarmState<2>>;
+
+  Wonton::Swarm<2> source_swarm(17 * 17, 2, 0, 0.0, 1.0, 0.0, 1.0);
+  Wonton::Swarm<2> target_swarm(11 * 11, 2, 0, 0.0, 1.0, 0.0, 1.0);
+  Wonton::SwarmState<2> source_state(source_swarm);
+  Wonton::SwarmState<2> target_state(target_swarm);
+
+  int const nb_source = source_swarm.num_owned_particles();
+  int const nb_target = target_swarm.num_owned_particles();
+
+  Wonton::vector<double> values(nb_source);
+  for (int i = 0; i < nb_source; ++i)
+    values[i] = compute_quadratic_field<2>(source_swarm.get_particle_coordinates(i));
+
+  source_state.add_field("field", values);
+  target_state.add_field("field", Wonton::vector<double>(nb_target, 0.));
+
+  // far too small to enclose enough source particles, the smoothing
+  // lengths are deduced from the nearest neighbors instead.
+  Wonton::vector<std::vector<std::vector<double>>> smoothing(nb_target, {{1.e-3, 1.e-3}});
+  std::vector<std::string> const vars = { "field" };
+
+  Remapper remapper(source_swarm, source_state, target_swarm, target_state, smoothing);
+  remapper.set_remap_var_names(vars, vars, LocalRegression, basis::Quadratic);
+  remapper.set_adaptive_smoothing(true);
+  remapper.run(nullptr, false);
+
+  auto& result = target_state.get_field("field");
+  for (int i = 0; i < nb_target; ++i) {
+    auto const p = target_swarm.get_particle_coordinates(i);
+    ASSERT_NEAR(compute_quadratic_field<2>(p), result[i], 1.e-10);
+  }
+
+  // adapted smoothing lengths do not outlive the remap
+  std::vector<std::string> const given_vars = { "given" };
+  std::vector<std::string> const fresh_vars = { "fresh" };
+  target_state.add_field("given", Wonton::vector<double>(nb_target, 0.));
+  target_state.add_field("fresh", Wonton::vector<double>(nb_target, 0.));
+
+  Remapper density(source_swarm, source_state, target_swarm, target_state, smoothing);
+  density.set_remap_var_names(vars, given_vars, KernelDensity, basis::Unitary);
+  density.set_adaptive_smoothing(true);
+  density.run(nullptr, false);
+
+  auto const adapted = target_state.get_field("given");
+  density.set_adaptive_smoothing(false);
+  density.run(nullptr, false);
+
+  Remapper fresh(source_swarm, source_state, target_swarm, target_state, smoothing);
+  fresh.set_remap_var_names(vars, fresh_vars, KernelDensity, basis::Unitary);
+  fresh.run(nullptr, false);
+
+  auto& given = target_state.get_field("given");
+  auto& expected = target_state.get_field("fresh");
+  int num_changed = 0;
+  for (int i = 0; i < nb_target; ++i) {
+    ASSERT_DOUBLE_EQ(expected[i], given[i]);
+    if (adapted[i] != given[i])
+      num_changed++;
+  }
+  ASSERT_GT(num_changed, 0);
+}
+
 TEST(Part, 2D) {
 
   using Remapper = SwarmDriver<Portage::SearchPointsByCells,
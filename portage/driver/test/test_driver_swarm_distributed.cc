@@ -7,6 +7,8 @@ Please see the license file at the root of this repository, or at:
 
 #include <iostream>
 #include <memory>
+#include <stdexcept>
+#include <string>
 #include <vector>
 
 #include "wonton/support/wonton.h"
@@ -14,11 +16,16 @@ Please see the license file at the root of this repository, or at:
 #include "wonton/support/Point.h"
 #include "wonton/swarm/swarm.h"
 #include "wonton/swarm/swarm_state.h"
+#include "wonton/mesh/simple/simple_mesh.h"
+#include "wonton/mesh/simple/simple_mesh_wrapper.h"
+#include "wonton/state/simple/simple_state_mm_wrapper.h"
+#include "wonton/state/state_vector_uni.h"
 
 #include "portage/support/portage.h"
 #include "portage/accumulate/accumulate.h"
 #include "portage/distributed/mpi_particle_distribute.h"
 #include "portage/driver/driver_swarm.h"
+#include "portage/driver/driver_mesh_swarm_mesh.h"
 #include "portage/estimate/estimate.h"
 #include "portage/search/search_points_by_cells.h"
 
@@ -309,4 +316,60 @@ TEST_F(DriverTest3DScatter, 3D_QuadraticFieldQuadraticBasisScatter) {
   unitTest<Portage::SearchPointsByCells, basis::Quadratic>
       (compute_quadratic_field<3>, 0.0);
 }
+
+// Kept shape functions are not distributed: computing them on several
+// ranks is rejected instead of silently missing remote neighbors.
+TEST_F(DriverTest2D, KeptWeights) {
+
+  using Remapper = SwarmDriver<Portage::SearchPointsByCells, Accumulate, Estimate, 2,
+                               Wonton::Swarm<2>, Wonton::SwarmState<2>>;
+  using MeshState = Wonton::Simple_State_Wrapper<Wonton::Simple_Mesh_Wrapper>;
+  using MeshRemapper = Portage::MSM_Driver<Portage::SearchPointsByCells,
+                                           Accumulate, Estimate, 2,
+                                           Wonton::Simple_Mesh_Wrapper, MeshState>;
+  using Field = Wonton::StateVectorUni<>;
+
+  int nprocs = 0;
+  MPI_Comm_size(comm, &nprocs);
+  Wonton::MPIExecutor_type executor(comm);
+
+  // swarm remap
+  std::vector<std::string> const particle_fields = { "particledata" };
+  int const nb_source = source_swarm.num_owned_particles();
+  source_state.add_field("particledata", Wonton::vector<double>(nb_source, 1.));
+  target_state.add_field("particledata", 0.0);
+
+  Remapper remapper(source_swarm, source_state,
+                    target_swarm, target_state,
+                    smoothing_lengths_, Weight::B4, Weight::ELLIPTIC, center_);
+  remapper.set_remap_var_names(particle_fields, particle_fields, LocalRegression, basis::Linear);
+
+  // mesh-swarm-mesh remap of the same serial meshes on each rank
+  Wonton::Simple_Mesh source_mesh(0.0, 0.0, 1.0, 1.0, 10, 10);
+  Wonton::Simple_Mesh target_mesh(0.3, 0.3, 0.7, 0.7, 4, 4);
+  Wonton::Simple_Mesh_Wrapper source_mesh_wrapper(source_mesh);
+  Wonton::Simple_Mesh_Wrapper target_mesh_wrapper(target_mesh);
+  MeshState source_mesh_state(source_mesh_wrapper);
+  MeshState target_mesh_state(target_mesh_wrapper);
+
+  int const nb_source_cells = source_mesh_wrapper.num_owned_cells();
+  int const nb_target_cells = target_mesh_wrapper.num_owned_cells();
+  source_mesh_state.add(std::make_shared<Field>("celldata", Wonton::CELL,
+                                                std::vector<double>(nb_source_cells, 1.)));
+  target_mesh_state.add(std::make_shared<Field>("celldata", Wonton::CELL,
+                                                std::vector<double>(nb_target_cells, 0.)));
+
+  MeshRemapper mesh_remapper(source_mesh_wrapper, source_mesh_state,
+                             target_mesh_wrapper, target_mesh_state);
+  mesh_remapper.set_remap_var_names({ "celldata" });
+  mesh_remapper.set_reuse_weights(true);
+
+  if (nprocs > 1) {
+    ASSERT_THROW(remapper.compute_weights(&executor), std::runtime_error);
+    ASSERT_THROW(mesh_remapper.run(&executor), std::runtime_error);
+  } else {
+    ASSERT_NO_THROW(remapper.compute_weights(&executor));
+    ASSERT_NO_THROW(mesh_remapper.run(&executor));
+  }
+}
 }  // end namespace
@@ -778,6 +778,81 @@ public:
     }
 #endif
   }
+
+  /*!
+    Interpolate several multi-material variables of type T residing on
+    CELLs at once, using the material intersection weights computed by
+    compute_interpolation_weights
+
+    @param[in] srcvarnames  Variable names on source mesh
+
+    @param[in] trgvarnames  Variable names on target mesh
+
+    @param[in] limiter      Limiter to use for second order reconstruction
+
+    @param[in] bnd_limiter  Boundary limiter to use for second order reconstruction
+
+    The gradients of all the variables are computed in a single pass per
+    material, and all the variables of all the materials are interpolated
+    in a single parallel loop (see CoreDriver::interpolate_mat_vars)
+  */
+
+  template <typename T = double,
+            template<int, Entity_kind, class, class, class, class, class,
+                     template <class, int, class, class> class,
+                     class, class, class> class Interpolate
+            >
+  void interpolate_mat_vars(std::vector<std::string> const& srcvarnames,
+                            std::vector<std::string> const& trgvarnames,
+                            Limiter_type limiter = DEFAULT_LIMITER,
+                            Boundary_Limiter_type bnd_limiter = DEFAULT_BND_LIMITER) {
+
+    for (auto const& srcvarname : srcvarnames) {
+      assert(source_state_.get_entity(srcvarname) == CELL);
+      if (not contains(source_vars_to_remap_, srcvarname)) {
+        throw std::runtime_error(srcvarname + " not in field variables list");
+      }
+    }
+
+#ifdef PORTAGE_HAS_TANGRAM
+    assert(mat_intersection_completed_);
+
+    using Interpolator = Interpolate<D, CELL,
+                                     SourceMesh, TargetMesh,
+                                     SourceState, TargetState,
+                                     T, InterfaceReconstructorType,
+                                     Matpoly_Splitter, Matpoly_Clipper, CoordSys>;
+
+    int const nb_mats = source_state_.num_materials();
+    int const nb_vars = srcvarnames.size();
+    assert(nb_mats > 0);
+
+    if (Interpolator::order == 2) {
+      // cache gradient stencils first
+      driver_cell_->cache_multimat_gradient_stencils();
+
+      std::vector<Limiter_type> limiters(nb_vars, limiter);
+      std::vector<Boundary_Limiter_type> bnd_limiters(nb_vars, bnd_limiter);
+      std::vector<std::vector<Wonton::vector<Vector<D>>>> gradients(nb_vars);
+      for (int v = 0; v < nb_vars; ++v)
+        gradients[v].resize(nb_mats);
+
+      for (int i = 0; i < nb_mats; ++i) {
+        auto gradients_i = driver_cell_->compute_source_gradients(srcvarnames, limiters,
+                                                                  bnd_limiters, i);
+        for (int v = 0; v < nb_vars; ++v)
+          gradients[v][i] = std::move(gradients_i[v]);
+      }
+      driver_cell_->template interpolate_mat_vars<T, Interpolate>(
+        srcvarnames, trgvarnames, source_weights_by_mat_, &gradients
+      );
+    } else {
+      driver_cell_->template interpolate_mat_vars<T, Interpolate>(
+        srcvarnames, trgvarnames, source_weights_by_mat_
+      );
+    }
+#endif
+  }
   
  private:
 
@@ -0,0 +1,350 @@
+/*
+This file is part of the Ristra portage project.
+Please see the license file at the root of this repository, or at:
+    https://github.com/laristra/portage/blob/master/LICENSE
+*/
+
+#ifndef PORTAGE_INTERPOLATE_COMPRESSED_WEIGHTS_H_
+#define PORTAGE_INTERPOLATE_COMPRESSED_WEIGHTS_H_
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <iterator>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// wonton includes
+#include "wonton/support/wonton.h"
+#include "wonton/support/Point.h"
+#include "wonton/support/Vector.h"
+
+// portage includes
+#include "portage/support/portage.h"
+
+namespace Portage {
+
+using Wonton::Point;
+using Wonton::Vector;
+
+/*!
+  @class CompressedWeights compressed_weights.h
+  @brief Single precision storage of the intersection moments of a remap.
+
+  The intersection moments of each target entity are usually kept as a
+  list of Weights_t, i.e. one heap allocated vector of doubles per
+  contributing source entity, which makes them the largest data of a
+  remap. This class stores them flat in compressed sparse row (CSR)
+  format in single precision instead: for each intersection piece, its
+  source entity, its volume and the offset of its centroid from a
+  reference point of the target entity (its centroid for cells, its
+  coordinates for nodes). Storing centroids relative to the target
+  keeps their single precision error relative to the target size
+  rather than to the coordinates magnitude.
+
+  Only the volume and first moments are kept, which is what the first
+  and second order interpolators and the mismatch fixer use. Each row
+  is a view whose moments are expanded back in double precision on the
+  fly, so that all the accumulations remain in double precision and no
+  list is allocated per target entity.
+  The loss of accuracy, and of conservation, can be measured against
+  the original weights with 'conservation_error'.
+*/
+template<int D>
+class CompressedWeights {
+
+ public:
+
+  /// Loss of accuracy of the compressed moments.
+  struct Report {
+    /// max relative error on the intersection volume of a target entity.
+    double max_volume_error = 0.;
+    /// relative error on the total intersection volume.
+    double total_volume_error = 0.;
+    /// max distance between original and compressed piece centroids.
+    double max_centroid_error = 0.;
+  };
+
+  /// Default constructor: no weights.
+  CompressedWeights() = default;
+
+  /*!
+    @brief Compress the intersection moments of a remap.
+    @param[in] sources_and_weights: source entities and their moments
+               for each target entity.
+    @param[in] target_mesh: target mesh wrapper.
+    @param[in] entity_kind: kind of the target entities (cell or node).
+  */
+  template<class Mesh>
+  CompressedWeights(Wonton::vector<std::vector<Weights_t>> const& sources_and_weights,
+                    Mesh const& target_mesh, Entity_kind entity_kind) {
+
+    int const nb_targets = sources_and_weights.size();
+    references_.resize(nb_targets);
+    offsets_.assign(nb_targets + 1, 0);
+
+    for (int t = 0; t < nb_targets; ++t) {
+      // nb: 'auto' may imply unexpected behavior with thrust enabled.
+      std::vector<Weights_t> const& list = sources_and_weights[t];
+      offsets_[t + 1] = offsets_[t] + list.size();
+    }
+
+    int const nb_pieces = offsets_[nb_targets];
+    entities_.resize(nb_pieces);
+    volumes_.resize(nb_pieces);
+    centroids_.resize(nb_pieces);
+
+    std::vector<int> targets(nb_targets);
+    std::iota(targets.begin(), targets.end(), 0);
+
+    Wonton::for_each(targets.begin(), targets.end(), [&](int t) {
+      if (entity_kind == Entity_kind::CELL)
+        target_mesh.cell_centroid(t, &(references_[t]));
+      else
+        target_mesh.node_get_coordinates(t, &(references_[t]));
+
+      std::vector<Weights_t> const& list = sources_and_weights[t];
+      int j = offsets_[t];
+      for (auto const& piece : list) {
+        std::vector<double> const& moments = piece.weights;
+        assert(moments.size() >= unsigned(D + 1));
+        double const volume = moments[0];
+        entities_[j] = piece.entityID;
+        volumes_[j] = static_cast<float>(volume);
+        for (int d = 0; d < D; ++d) {
+          double const centroid = volume != 0. ? moments[d + 1] / volume
+                                               : references_[t][d];
+          centroids_[j][d] = static_cast<float>(centroid - references_[t][d]);
+        }
+        j++;
+      }
+    });
+  }
+
+  /// Number of target entities.
+  int size() const { return static_cast<int>(references_.size()); }
+
+  /// Number of stored intersection pieces.
+  int num_pieces() const { return static_cast<int>(entities_.size()); }
+
+  /// Moments of an intersection piece expanded in double precision.
+  struct Piece {
+    int entityID;
+    std::array<double, D + 1> weights;
+  };
+
+  /*!
+    @class Row
+    @brief View of the pieces of a target entity.
+
+    It behaves as the list of Weights_t of the target entity for the
+    interpolators: it may be iterated and indexed, but its pieces are
+    expanded in double precision on the fly, without any allocation.
+  */
+  class Row {
+
+   public:
+
+    /// Forward iterator over the pieces of the row.
+    class iterator {
+     public:
+      using iterator_category = std::forward_iterator_tag;
+      using value_type = Piece;
+      using difference_type = std::ptrdiff_t;
+      using pointer = Piece const*;
+      using reference = Piece;
+
+      iterator(Row const& row, int i) : row_(&row), i_(i) {}
+      Piece operator*() const { return (*row_)[i_]; }
+      iterator& operator++() { i_++; return *this; }
+      iterator operator++(int) { iterator it(*this); i_++; return it; }
+      bool operator==(iterator const& it) const { return i_ == it.i_; }
+      bool operator!=(iterator const& it) const { return i_ != it.i_; }
+
+     private:
+      Row const* row_;
+      int i_;
+    };
+
+    Row(CompressedWeights const& weights, int t) : weights_(weights), t_(t) {}
+
+    /// Number of pieces of the target entity.
+    int size() const { return weights_.offsets_[t_ + 1] - weights_.offsets_[t_]; }
+
+    /// Whether the target entity has no piece.
+    bool empty() const { return size() == 0; }
+
+    /// Source entity and moments of a piece in double precision.
+    Piece operator[](int i) const {
+      int const j = weights_.offsets_[t_] + i;
+      double const volume = weights_.volumes_[j];
+      Point<D> const& reference = weights_.references_[t_];
+      Piece piece;
+      piece.entityID = weights_.entities_[j];
+      piece.weights[0] = volume;
+      for (int d = 0; d < D; ++d)
+        piece.weights[d + 1] = volume * (reference[d] + weights_.centroids_[j][d]);
+      return piece;
+    }
+
+    iterator begin() const { return iterator(*this, 0); }
+    iterator end() const { return iterator(*this, size()); }
+
+   private:
+    CompressedWeights const& weights_;
+    int t_;
+  };
+
+  /// Rows are the counterparts of the lists of Weights_t.
+  using value_type = Row;
+
+  /*!
+    @brief Moments of a target entity in double precision.
+    @param[in] t: the target entity.
+    @return a view of its source entities and moments.
+  */
+  Row operator[](int t) const { return Row(*this, t); }
+
+  /*!
+    @brief Compare the compressed moments to the original ones.
+    @param[in] sources_and_weights: the weights that were compressed.
+    @return the errors on volumes and centroids of intersection.
+  */
+  Report conservation_error(Wonton::vector<std::vector<Weights_t>> const& sources_and_weights) const {
+
+    Report report;
+    double total_original = 0.;
+    double total_compressed = 0.;
+    int const nb_targets = size();
+    assert(unsigned(nb_targets) == sources_and_weights.size());
+
+    for (int t = 0; t < nb_targets; ++t) {
+      std::vector<Weights_t> const& list = sources_and_weights[t];
+      double original = 0.;
+      double compressed = 0.;
+      int j = offsets_[t];
+      for (auto const& piece : list) {
+        double const volume = piece.weights[0];
+        original += volume;
+        compressed += volumes_[j];
+        if (volume != 0.) {
+          double distance = 0.;
+          for (int d = 0; d < D; ++d) {
+            double const delta = piece.weights[d + 1] / volume
+                                 - (references_[t][d] + centroids_[j][d]);
+            distance += delta * delta;
+          }
+          report.max_centroid_error = std::max(report.max_centroid_error,
+                                               std::sqrt(distance));
+        }
+        j++;
+      }
+      if (original != 0.)
+        report.max_volume_error = std::max(report.max_volume_error,
+                                           std::fabs(compressed - original) / std::fabs(original));
+      total_original += original;
+      total_compressed += compressed;
+    }
+
+    if (total_original != 0.)
+      report.total_volume_error = std::fabs(total_compressed - total_original)
+                                  / std::fabs(total_original);
+    return report;
+  }
+
+ private:
+  std::vector<int> offsets_ {0};
+  std::vector<int> entities_ {};
+  std::vector<float> volumes_ {};
+  std::vector<std::array<float, D>> centroids_ {};
+  std::vector<Point<D>> references_ {};
+};
+
+
+/*!
+  @class CompressedGradients compressed_weights.h
+  @brief Single precision storage of a gradient field.
+
+  Gradients are converted back to double precision when read, so that
+  the interpolation still accumulates in double precision.
+*/
+template<int D>
+class CompressedGradients {
+
+ public:
+
+  /// Default constructor: empty field.
+  CompressedGradients() = default;
+
+  /*!
+    @brief Compress a gradient field.
+    @param[in] gradients: the gradient field in double precision.
+  */
+  explicit CompressedGradients(Wonton::vector<Vector<D>> const& gradients)
+    : values_(gradients.size()) {
+    int const nb_entities = gradients.size();
+    for (int i = 0; i < nb_entities; ++i) {
+      Vector<D> const& gradient = gradients[i];
+      for (int d = 0; d < D; ++d)
+        values_[i][d] = static_cast<float>(gradient[d]);
+    }
+  }
+
+  /// Number of entities.
+  int size() const { return static_cast<int>(values_.size()); }
+
+  /// Gradient of an entity in double precision.
+  Vector<D> operator[](int i) const {
+    Vector<D> gradient;
+    for (int d = 0; d < D; ++d)
+      gradient[d] = values_[i][d];
+    return gradient;
+  }
+
+ private:
+  std::vector<std::array<float, D>> values_ {};
+};
+
+namespace detail {
+
+template<class Interpolator, int D>
+auto set_compressed_gradients(Interpolator& interpolator, std::string const& name,
+                              CompressedGradients<D> const* gradients, int)
+  -> decltype(interpolator.set_interpolation_variable(name, gradients), void()) {
+  interpolator.set_interpolation_variable(name, gradients);
+}
+
+template<class Interpolator, int D>
+void set_compressed_gradients(Interpolator& interpolator, std::string const& name,
+                              CompressedGradients<D> const* gradients, long) {
+  if (gradients != nullptr)
+    throw std::runtime_error("interpolator does not support compressed gradients");
+  interpolator.set_interpolation_variable(name);
+}
+
+}  // namespace detail
+
+/*!
+  @brief Set the variable of an interpolator along with its gradient
+         field stored in single precision, if it is able to use it.
+  @param[in,out] interpolator: the interpolator.
+  @param[in] name: the variable name.
+  @param[in] gradients: the compressed gradient field, if any.
+*/
+template<class Interpolator, int D>
+void set_compressed_interpolation_variable(Interpolator& interpolator,
+                                           std::string const& name,
+                                           CompressedGradients<D> const* gradients) {
+  if (gradients == nullptr)
+    interpolator.set_interpolation_variable(name);
+  else
+    detail::set_compressed_gradients(interpolator, name, gradients, 0);
+}
+
+}  // namespace Portage
+
+#endif  // PORTAGE_INTERPOLATE_COMPRESSED_WEIGHTS_H_
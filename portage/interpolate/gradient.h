@@ -21,6 +21,8 @@
 #include "portage-config.h"
 #include "portage/support/portage.h"
 #include "portage/intersect/dummy_interface_reconstructor.h"
+#include "portage/intersect/matpoly_cache.h"
+#include "portage/intersect/dual_cell_cache.h"
 #include "portage/driver/fix_mismatch.h"
 #include "portage/driver/parts.h"
 
@@ -142,7 +144,6 @@ namespace Portage {
       int nb_cells = mesh_.num_entities(Wonton::CELL, Wonton::PARALLEL_OWNED);
       int nb_mats = state_.num_materials() + 1;
       stencils_.resize(nb_mats);
-      valid_neigh_.resize(nb_mats);
       reference_.resize(nb_mats);
       neighbors_.resize(nb_cells);
 
@@ -152,19 +153,16 @@ namespace Portage {
           std::vector<int> mat_cells;
           state_.mat_get_cells(m - 1, &mat_cells);
           int const count = mat_cells.size();
-          stencils_[m].resize(count);
-          valid_neigh_[m].resize(count);
+          stencils_[m].offsets.assign(count + 1, 0);
           reference_[m].resize(count);
         } else {
-          stencils_[m].resize(nb_cells);
-          valid_neigh_[m].resize(nb_cells);
+          stencils_[m].offsets.assign(nb_cells + 1, 0);
           reference_[m].resize(nb_cells);
         }
       }
 #else
       assert(nb_mats == 1);
-      stencils_[0].resize(nb_cells);
-      valid_neigh_[0].resize(nb_cells);
+      stencils_[0].offsets.assign(nb_cells + 1, 0);
       reference_[0].resize(nb_cells);
 #endif
 
@@ -228,17 +226,32 @@ namespace Portage {
      */
     void cache_matrices(Field_type field_type) {
 
-      auto kernel = [this](int c, int m = 0) {
-        auto const& p = retrieve_stencil_points(c, m);
+      // stencils are first gathered per cell, then flattened per material
+      std::vector<std::vector<int>> points;
+      std::vector<std::vector<double>> weights;
+      std::vector<std::vector<Point<D>>> vertices;
+
+      auto prepare = [&](int m) {
+        int const nb_cells = reference_[m].size();
+        points.assign(nb_cells, {});
+        weights.assign(nb_cells, {});
+        vertices.assign(nb_cells, {});
+      };
+
+      auto kernel = [&](int c, int m = 0) {
         int const cell = get_relative_index(c, m);
-        stencils_[m][cell] = Wonton::build_gradient_stencil_matrices<D>(p, true);
+        auto const& p = retrieve_stencil_points(c, m, &(points[cell]));
+        weights[cell] = build_stencil_weights(p);
+        retrieve_limiter_points(c, m, &(vertices[cell]));
       };
 
       if (part_ == nullptr) {
         if (field_type == Field_type::MESH_FIELD) {
+          prepare(0);
           Wonton::for_each(mesh_.begin(Wonton::CELL, Wonton::PARALLEL_OWNED),
                            mesh_.end(Wonton::CELL, Wonton::PARALLEL_OWNED),
                            [&](int c) { kernel(c); });
+          flatten_stencils(0, points, weights, vertices);
 
         } else {
 #ifdef PORTAGE_HAS_TANGRAM
@@ -253,8 +266,10 @@ namespace Portage {
                   cells.emplace_back(c);
                 }
               }
-              // retrieve matrices
+              // retrieve stencils
+              prepare(m + 1);
               std::for_each(cells.begin(), cells.end(), [&](int c) { kernel(c, m + 1); });
+              flatten_stencils(m + 1, points, weights, vertices);
             }
           } else
             throw std::runtime_error("interface reconstructor not set");
@@ -262,9 +277,89 @@ namespace Portage {
         }
       } else {
         assert(field_type == Field_type::MESH_FIELD);
+        prepare(0);
         Wonton::for_each(part_->cells().begin(),
                          part_->cells().end(),
                          [&](int c) { kernel(c); });
+        flatten_stencils(0, points, weights, vertices);
+      }
+    }
+
+    /**
+     * @brief Compute the least square coefficients of a stencil.
+     *
+     * The least square gradient is linear in the stencil values, so
+     * it is stored as D coefficients per stencil point, obtained as
+     * the gradients of the unit values at each point.
+     *
+     * @param points: stencil points, the first one being the reference.
+     * @return the D coefficients of each stencil point.
+     */
+    static std::vector<double> build_stencil_weights(std::vector<Point<D>> const& points) {
+
+      int const size = points.size();
+      std::vector<double> weights(size * D, 0.);
+      if (size == 0)
+        return weights;
+
+      auto const matrices = Wonton::build_gradient_stencil_matrices<D>(points, true);
+      std::vector<double> unit(size, 0.);
+
+      for (int i = 0; i < size; ++i) {
+        unit[i] = 1.;
+        auto const grad = Wonton::ls_gradient<D, CoordSys>(matrices[0], matrices[1], unit);
+        for (int d = 0; d < D; ++d)
+          weights[i * D + d] = grad[d];
+        unit[i] = 0.;
+      }
+      return weights;
+    }
+
+    /**
+     * @brief Store the stencils of a mesh/material contiguously.
+     *
+     * The limiter points are stored as offsets from the stencil reference
+     * point since only those are needed to bound the reconstruction.
+     *
+     * @param m: mesh/material index.
+     * @param points: relative indices of the stencil points of each cell.
+     * @param weights: least square coefficients of each cell.
+     * @param vertices: limiter points of each cell.
+     */
+    void flatten_stencils(int m,
+                          std::vector<std::vector<int>> const& points,
+                          std::vector<std::vector<double>> const& weights,
+                          std::vector<std::vector<Point<D>>> const& vertices) {
+
+      auto& stencil = stencils_[m];
+      int const nb_cells = points.size();
+
+      stencil.offsets.assign(nb_cells + 1, 0);
+      for (int i = 0; i < nb_cells; ++i)
+        stencil.offsets[i + 1] = stencil.offsets[i] + points[i].size();
+
+      int const size = stencil.offsets[nb_cells];
+      stencil.points.resize(size);
+      stencil.weights.resize(size * D);
+
+      for (int i = 0; i < nb_cells; ++i) {
+        int const offset = stencil.offsets[i];
+        std::copy(points[i].begin(), points[i].end(), stencil.points.begin() + offset);
+        std::copy(weights[i].begin(), weights[i].end(), stencil.weights.begin() + offset * D);
+      }
+
+      stencil.vertex_offsets.assign(nb_cells + 1, 0);
+      for (int i = 0; i < nb_cells; ++i)
+        stencil.vertex_offsets[i + 1] = stencil.vertex_offsets[i] + vertices[i].size();
+
+      stencil.vertices.resize(stencil.vertex_offsets[nb_cells] * D);
+      for (int i = 0; i < nb_cells; ++i) {
+        double* vec = stencil.vertices.data() + stencil.vertex_offsets[i] * D;
+        for (auto const& vertex : vertices[i]) {
+          for (int d = 0; d < D; ++d)
+            vec[d] = vertex[d] - reference_[m][i][d];
+          vec += D;
+        }
       }
     }
 
@@ -277,13 +372,29 @@ namespace Portage {
       material_id_ = matid;
       // Extract the field data from the state manager
       if (field_type_ != Field_type::MESH_FIELD) {
-        state_.mat_get_celldata(variable_name_, material_id_, &values_);
+        // no single variable is set when several are remapped together
+        if (not variable_name_.empty())
+          state_.mat_get_celldata(variable_name_, material_id_, &values_);
+        for (auto&& field : fields_)
+          state_.mat_get_celldata(field.name, material_id_, &field.values);
       }
     }
 
     void set_interface_reconstructor(std::shared_ptr<InterfaceReconstructor> ir) {
       interface_reconstructor_ = ir;
     }
+
+    /**
+     * @brief Set the cache of material polytopes of mixed cells.
+     *
+     * When set, material centroids and vertices are read from the cache
+     * instead of being rebuilt from the interface reconstructor.
+     *
+     * @param cache: the material polytopes cache.
+     */
+    void set_matpoly_cache(std::shared_ptr<MatPolyCache<D>> cache) {
+      matpoly_cache_ = cache;
+    }
 #endif
 
     /**
@@ -312,6 +423,51 @@ namespace Portage {
       if (field_type_ == Field_type::MESH_FIELD) {
         state_.mesh_get_data(Entity_kind::CELL, variable_name_, &values_);
       }
+      fields_.clear();
+    }
+
+    /**
+     * @brief Set several interpolation variables and their options.
+     *
+     * Their gradients are then computed together by 'compute_gradients'.
+     * All variables must be of the same field type, and as for a single
+     * variable, the material-wise data of multi-material fields are only
+     * stored by a subsequent call to set_material.
+     *
+     * @param variable_names: the names of the variables to remap.
+     * @param limiter_types: the limiter to use for internal points per variable.
+     * @param boundary_limiter_types: the limiter to use at boundary points per variable.
+     */
+    void set_interpolation_variables(std::vector<std::string> const& variable_names,
+                                     std::vector<Limiter_type> const& limiter_types,
+                                     std::vector<Boundary_Limiter_type> const& boundary_limiter_types) {
+
+      int const nb_fields = variable_names.size();
+      if (int(limiter_types.size()) != nb_fields or
+          int(boundary_limiter_types.size()) != nb_fields)
+        throw std::runtime_error("mismatched number of variables and limiters");
+
+      variable_name_ = "";
+      values_ = nullptr;
+      material_id_ = -1;
+      fields_.resize(nb_fields);
+
+      for (int f = 0; f < nb_fields; ++f) {
+        auto& field = fields_[f];
+        field.name = variable_names[f];
+        field.limiter_type = limiter_types[f];
+        field.boundary_limiter_type = boundary_limiter_types[f];
+        field.values = nullptr;
+
+        auto const type = state_.field_type(Entity_kind::CELL, field.name);
+        if (f == 0)
+          field_type_ = type;
+        else if (type != field_type_)
+          throw std::runtime_error("variables must all be mesh or multi-material fields");
+
+        if (field_type_ == Field_type::MESH_FIELD)
+          state_.mesh_get_data(Entity_kind::CELL, field.name, &field.values);
+      }
     }
 
     /**
@@ -321,18 +477,21 @@ namespace Portage {
      * and is required for the construction of the least square
      * matrices used to approximate the gradient.
      *
-     * @param cell: the cell ID.
+     * @param c: the cell ID.
+     * @param m: mesh/material index.
+     * @param stencil: relative indices of the valid stencil points.
      * @return stencil points coordinates.
      */
-    std::vector<Point<D>> retrieve_stencil_points(int c, int m = 0) {
+    std::vector<Point<D>> retrieve_stencil_points(int c, int m,
+                                                  std::vector<int>* stencil) {
 
       int const size = neighbors_[c].size();
 
       std::vector<Point<D>> list_coords;
       list_coords.reserve(size);
       int const cell = get_relative_index(c, m);
-      valid_neigh_[m][cell].clear();
-      valid_neigh_[m][cell].reserve(size);
+      stencil->clear();
+      stencil->reserve(size);
 
 #ifdef PORTAGE_HAS_TANGRAM
     std::vector<std::shared_ptr<Tangram::CellMatPoly<D>>> cmp_ptrs;
@@ -377,18 +536,26 @@ namespace Portage {
 
           if (stencil_cell_has_mat) {
             if (!pure_cell) /* multi-material cell */ {
-              // Collect all the matpolys in this cell for the material of interest
-              auto matpolys = cmp_ptrs[neigh_global]->get_matpolys(m - 1);
-
               // If there are multiple matpolys in this cell for the material of interest,
               // aggregate moments to compute new centroid
               double mvol = 0.0;
               Point<D> centroid;
-              for (auto&& poly : matpolys) {
-                auto moments = poly.moments();
-                mvol += moments[0];
+              auto const* cached = matpoly_cache_
+                ? matpoly_cache_->find(neigh_global, m - 1) : nullptr;
+
+              if (cached != nullptr) {
+                mvol = cached->moments[0];
                 for (int k = 0; k < D; k++)
-                  centroid[k] += moments[k + 1];
+                  centroid[k] = cached->moments[k + 1];
+              } else {
+                // Collect all the matpolys in this cell for the material of interest
+                auto matpolys = cmp_ptrs[neigh_global]->get_matpolys(m - 1);
+                for (auto&& poly : matpolys) {
+                  auto moments = poly.moments();
+                  mvol += moments[0];
+                  for (int k = 0; k < D; k++)
+                    centroid[k] += moments[k + 1];
+                }
               }
 
               // There are cases where r3d returns a single zero volume poly which
@@ -404,7 +571,7 @@ namespace Portage {
               // Populate least squares vectors with centroid for material
               // of interest and field value in the current cell for that material
               // mark as valid
-              valid_neigh_[m][cell].emplace_back(neigh_local);
+              stencil->emplace_back(neigh_local);
               // save cell centroid as a reference point of the stencil
               if (neigh_global == c) { reference_[m][cell] = centroid; }
             } else { /* single-material cell */
@@ -412,7 +579,7 @@ namespace Portage {
               Point<D> centroid;
               mesh_.cell_centroid(neigh_global, &centroid);
               list_coords.emplace_back(centroid);
-              valid_neigh_[m][cell].emplace_back(neigh_local);
+              stencil->emplace_back(neigh_local);
               // save cell centroid as a reference point of the stencil
               if (neigh_global == c) { reference_[m][cell] = centroid; }
             }
@@ -425,7 +592,7 @@ namespace Portage {
           Point<D> centroid;
           mesh_.cell_centroid(neigh_global, &centroid);
           list_coords.emplace_back(centroid);
-          valid_neigh_[m][cell].emplace_back(neigh_global);
+          stencil->emplace_back(neigh_global);
           // save cell centroid as a reference point of the stencil
           if (neigh_global == c) { reference_[m][cell] = centroid; }
         }
@@ -434,22 +601,6 @@ namespace Portage {
       return list_coords;
     }
 
-    /**
-     * @brief Retrieve values of each stencil point.
-     *
-     * This is meant to be called for each field variable.
-     *
-     * @param cell: the cell ID.
-     * @return values of each stencil point.
-     */
-    std::vector<double> retrieve_stencil_values(int c, int m) const {
-      std::vector<double> list_values;
-      for (auto&& neigh : valid_neigh_[m][c]) {
-        list_values.emplace_back(values_[neigh]);
-      }
-      return list_values;
-    }
-
     /**
      * @brief Compute the limited gradient for the given cell.
      *
@@ -463,12 +614,11 @@ namespace Portage {
 
       double phi = 1.0;
       Vector<D> grad;
+      grad.zero();
 
       // check that cell is within the part if part-by-part requested
-      if (part_ != nullptr && !part_->contains(cellid)) {
-        grad.zero();
+      if (part_ != nullptr && !part_->contains(cellid))
         return grad;
-      }
 
       // useful predicates
       bool is_boundary_cell = mesh_.on_exterior_boundary(Entity_kind::CELL, cellid);
@@ -476,140 +626,254 @@ namespace Portage {
                            (!is_boundary_cell || boundary_limiter_type_ == BND_BARTH_JESPERSEN);
 
       // Limit the boundary gradient to enforce monotonicity preservation
-      if (is_boundary_cell && boundary_limiter_type_ == BND_ZERO_GRADIENT) {
-        grad.zero();
+      if (is_boundary_cell && boundary_limiter_type_ == BND_ZERO_GRADIENT)
         return grad;
-      }
 
       int const m = material_id_ + 1;
       int const c = get_relative_index(cellid, m);
 
-#if defined(PORTAGE_DEBUG)
-      auto print = [](Wonton::Matrix const& M, std::string const& desc) {
-        std::cout << desc << ": [";
-        for (int i = 0; i < M.rows(); ++i) {
-          for (int j = 0; j < M.columns(); ++j) {
-            std::cout << M[i][j] <<", ";
-          }
-        }
-        std::cout << "]" << std::endl;
-      };
-
-      print(stencils_[m][c][0], "(A^T.A)^-1");
-      print(stencils_[m][c][1], "A^T");
-      std::cout << " ------------ " << std::endl;
-#endif
+      auto const& stencil = stencils_[m];
+      int const first = stencil.offsets[c];
+      int const last = stencil.offsets[c + 1];
 
-      // retrieve values of each stencil point
-      auto list_values = retrieve_stencil_values(c, m);
+      if (first == last)
+        return grad;
 
-      // compute the gradient using the stored stencil matrices
-      grad = Wonton::ls_gradient<D, CoordSys>(stencils_[m][c][0],
-                                              stencils_[m][c][1],
-                                              list_values);
+      // compute the gradient using the stored stencil coefficients
+      double const* weights = stencil.weights.data() + first * D;
+      for (int i = first; i < last; ++i, weights += D) {
+        double const value = values_[stencil.points[i]];
+        for (int d = 0; d < D; ++d)
+          grad[d] += weights[d] * value;
+      }
 
       // Limit the gradient to enforce monotonicity preservation
-      if (apply_limiter) {
+      if (apply_limiter)
+        phi = limiter_factor(values_, stencil, c, grad);
 
-        phi = 1.0;
+      // Limited gradient is phi*grad
+      return phi * grad;
+    }
 
-        // Min and max vals of function (cell centered vals) among neighbors
-        // and the cell itself
-        /// @todo: must remove assumption the field is scalar
-        double minval = list_values[0];
-        double maxval = list_values[0];
-        double cellcenval = list_values[0];
-
-        // Find min and max values among all neighbors (exlude the first element
-        // in nbrids because it corresponds to the cell itself, not a neighbor)
-        int const nb_values = list_values.size();
-        for (int i = 1; i < nb_values; ++i) {
-          minval = std::min(list_values[i], minval);
-          maxval = std::max(list_values[i], maxval);
+    /**
+     * @brief Compute the limited gradients of all the variables at a cell.
+     *
+     * The stencil of the cell is traversed once for all the variables
+     * set by 'set_interpolation_variables'.
+     *
+     * @param cellid: the cell ID.
+     * @param gradients: the gradient of each variable at this cell.
+     */
+    void compute_gradients(int cellid, Vector<D>* gradients) const {
+
+      assert(mesh_.cell_get_type(cellid) == Entity_type::PARALLEL_OWNED);
+
+      int const nb_fields = fields_.size();
+      for (int f = 0; f < nb_fields; ++f)
+        gradients[f].zero();
+
+      // check that cell is within the part if part-by-part requested
+      if (part_ != nullptr && !part_->contains(cellid))
+        return;
+
+      int const m = material_id_ + 1;
+      int const c = get_relative_index(cellid, m);
+
+      auto const& stencil = stencils_[m];
+      int const first = stencil.offsets[c];
+      int const last = stencil.offsets[c + 1];
+
+      if (first == last)
+        return;
+
+      // gather each stencil point once for all variables
+      double const* weights = stencil.weights.data() + first * D;
+      for (int i = first; i < last; ++i, weights += D) {
+        int const j = stencil.points[i];
+        for (int f = 0; f < nb_fields; ++f) {
+          assert(fields_[f].values);
+          double const value = fields_[f].values[j];
+          for (int d = 0; d < D; ++d)
+            gradients[f][d] += weights[d] * value;
         }
+      }
 
-        std::vector<Point<D>> coords;
-#ifdef PORTAGE_HAS_TANGRAM
-        /* Per page 278 of [Kucharik, M. and Shaskov, M, "Conservative
-           Multi-material Remap for Staggered Multi-material Arbitrary
-           Lagrangian-Eulerian Methods," Journal of Computational Physics,
-           v 258, pp. 268-304, 2014], if a cell is a multimaterial cell and the
-           field is a material field, then the min value (for density, at
-           least) should be set to 0 and the max value to infinity (or a large
-           number), so that we don't end up limiting the gradient to 0 and drop
-           down to 1st order. But we don't know if a variable is density (don't
-           want to do silly things like string comparison) or pressure or
-           something else? What if we limit pressure to 0 and it should
-           actually be allowed to go -ve? In the end, along with the limiter
-           type, the application should be able to tell Portage the global
-           bounds that a variable has to satisfy. Then we can impose the global
-           limits at multi-material cells and boundary cells without limiting
-           the gradient to 0. */
-
-        std::vector<std::shared_ptr<Tangram::CellMatPoly<D>>> cmp_ptrs;
-        if (interface_reconstructor_ != nullptr)
-          cmp_ptrs = interface_reconstructor_->cell_matpoly_ptrs();
-
-        std::vector<int> cell_mats;
-        state_.cell_get_mats(cellid, &cell_mats);
-        int nb_mats = cell_mats.size();
-
-        bool non_materialistic_cells = !nb_mats || (m - 1 == -1);
-          // nb_mats == 0 -- no materials
-          // m - 1 == -1 -- intersect with mesh not a particular material
-
-        bool pure_cell = non_materialistic_cells || (nb_mats == 1);
-
-        if (!pure_cell) {
-          assert(interface_reconstructor_ != nullptr);
-          assert(cmp_ptrs[cellid] != nullptr);
-          nb_mats = cmp_ptrs[cellid]->num_materials();
-          cell_mats = cmp_ptrs[cellid]->cell_matids();
-          pure_cell = (nb_mats == 1);
+      bool const is_boundary_cell = mesh_.on_exterior_boundary(Entity_kind::CELL, cellid);
+
+      for (int f = 0; f < nb_fields; ++f) {
+        auto const& field = fields_[f];
+
+        // Limit the boundary gradient to enforce monotonicity preservation
+        if (is_boundary_cell && field.boundary_limiter_type == BND_ZERO_GRADIENT) {
+          gradients[f].zero();
+          continue;
         }
 
-        bool stencil_cell_has_mat = pure_cell ? non_materialistic_cells || (cell_mats[0] == m - 1) :
-                                                cmp_ptrs[cellid]->is_cell_material(m - 1);
+        bool const apply_limiter =
+          field.limiter_type == BARTH_JESPERSEN &&
+          (!is_boundary_cell || field.boundary_limiter_type == BND_BARTH_JESPERSEN);
+
+        if (apply_limiter)
+          gradients[f] = limiter_factor(field.values, stencil, c, gradients[f]) * gradients[f];
+      }
+    }
+
+  private:
+    /**
+     * least square stencils of a mesh/material: the stencil of relative
+     * cell 'c' spans [offsets[c], offsets[c+1]) in 'points', which holds
+     * the relative indices of its valid neighbors (the cell itself first),
+     * and D coefficients per point are stored in 'weights'. Similarly,
+     * the points where the reconstruction is bounded by the limiter span
+     * [vertex_offsets[c], vertex_offsets[c+1]) and their offsets from the
+     * reference point are stored in 'vertices' with a stride D.
+     */
+    struct Stencils {
+      std::vector<int> offsets {};
+      std::vector<int> points {};
+      std::vector<double> weights {};
+      std::vector<int> vertex_offsets {};
+      std::vector<double> vertices {};
+    };
+
+    /** variable whose gradient is computed along with others */
+    struct Field {
+      std::string name;
+      double const* values = nullptr;
+      Limiter_type limiter_type = DEFAULT_LIMITER;
+      Boundary_Limiter_type boundary_limiter_type = DEFAULT_BND_LIMITER;
+    };
+
+    /**
+     * @brief Retrieve the points where the reconstruction is bounded.
+     *
+     * @param cellid: the cell ID.
+     * @param m: mesh/material index.
+     * @param coords: vertices of the cell or of its material polytopes.
+     */
+    void retrieve_limiter_points(int cellid, int m,
+                                 std::vector<Point<D>>* coords) const {
+      coords->clear();
+#ifdef PORTAGE_HAS_TANGRAM
+      /* Per page 278 of [Kucharik, M. and Shaskov, M, "Conservative
+         Multi-material Remap for Staggered Multi-material Arbitrary
+         Lagrangian-Eulerian Methods," Journal of Computational Physics,
+         v 258, pp. 268-304, 2014], if a cell is a multimaterial cell and the
+         field is a material field, then the min value (for density, at
+         least) should be set to 0 and the max value to infinity (or a large
+         number), so that we don't end up limiting the gradient to 0 and drop
+         down to 1st order. But we don't know if a variable is density (don't
+         want to do silly things like string comparison) or pressure or
+         something else? What if we limit pressure to 0 and it should
+         actually be allowed to go -ve? In the end, along with the limiter
+         type, the application should be able to tell Portage the global
+         bounds that a variable has to satisfy. Then we can impose the global
+         limits at multi-material cells and boundary cells without limiting
+         the gradient to 0. */
+
+      std::vector<int> cell_mats;
+      state_.cell_get_mats(cellid, &cell_mats);
+      int nb_mats = cell_mats.size();
+
+      bool non_materialistic_cells = !nb_mats || (m - 1 == -1);
+        // nb_mats == 0 -- no materials
+        // m - 1 == -1 -- intersect with mesh not a particular material
+
+      bool pure_cell = non_materialistic_cells || (nb_mats == 1);
+
+      if (!pure_cell) {
+        assert(interface_reconstructor_ != nullptr);
+        auto const& cmp_ptrs = interface_reconstructor_->cell_matpoly_ptrs();
+        assert(cmp_ptrs[cellid] != nullptr);
+        nb_mats = cmp_ptrs[cellid]->num_materials();
+        cell_mats = cmp_ptrs[cellid]->cell_matids();
+        pure_cell = (nb_mats == 1);
+      }
 
-        if (stencil_cell_has_mat) {
-          if (!pure_cell) /* multi-material cell */ {
+      if (pure_cell) {
+        if (non_materialistic_cells || (cell_mats[0] == m - 1))
+          mesh_.cell_get_coordinates(cellid, coords);
+      } else {
+        auto const& cmp_ptrs = interface_reconstructor_->cell_matpoly_ptrs();
+        if (cmp_ptrs[cellid]->is_cell_material(m - 1)) {
+          auto const* cached = matpoly_cache_
+            ? matpoly_cache_->find(cellid, m - 1) : nullptr;
+
+          if (cached != nullptr) {
+            *coords = cached->points;
+          } else {
             // Collect all the matpolys in this cell for the material of interest
             auto matpolys = cmp_ptrs[cellid]->get_matpolys(m - 1);
 
             // Get vertices of all material polygons for given material
             for (auto&& poly : matpolys) {
               auto points = poly.points();
-              coords.insert(coords.end(), points.begin(), points.end());
+              coords->insert(coords->end(), points.begin(), points.end());
             }
-          } else /* single-material cell */ {
-            mesh_.cell_get_coordinates(cellid, &coords);
           }
         }
+      }
 #else
-        mesh_.cell_get_coordinates(cellid, &coords);
+      mesh_.cell_get_coordinates(cellid, coords);
 #endif
-        // Find the min and max of the reconstructed function in the cell
-        // Since the reconstruction is linear, this will occur at one of
-        // the nodes of the cell. So find the values of the reconstructed
-        // function at the nodes of the cell. For multi-material problems,
-        // the reconstruction is defined over material polytopes instead of
-        // cells, so the reconstruction is evaluated in vertices of these
-        // polytopes.
+    }
 
-        for (auto&& coord : coords) {
-          auto vec = coord - reference_[m][c];
-          double diff = dot(grad, vec);
-          double extremeval = (diff > 0.) ? maxval : minval;
-          double phi_new = (diff == 0. ? 1. : (extremeval - cellcenval) / diff);
-          phi = std::min(phi_new, phi);
-        }
+    /**
+     * @brief Compute the Barth-Jespersen limiter of a gradient.
+     *
+     * @param values: the field values.
+     * @param stencil: the stencils of the current mesh/material.
+     * @param c: relative index of the cell.
+     * @param grad: the unlimited gradient.
+     * @return the limiter factor in [0, 1].
+     */
+    static double limiter_factor(double const* values, Stencils const& stencil,
+                                 int c, Vector<D> const& grad) {
+
+      int const first = stencil.offsets[c];
+      int const last = stencil.offsets[c + 1];
+
+      // Min and max vals of function (cell centered vals) among neighbors
+      // and the cell itself
+      /// @todo: must remove assumption the field is scalar
+      double const cellcenval = values[stencil.points[first]];
+      double minval = cellcenval;
+      double maxval = cellcenval;
+
+      // Find min and max values among all neighbors (exlude the first element
+      // in nbrids because it corresponds to the cell itself, not a neighbor)
+      for (int i = first + 1; i < last; ++i) {
+        double const value = values[stencil.points[i]];
+        minval = std::min(value, minval);
+        maxval = std::max(value, maxval);
       }
 
-      // Limited gradient is phi*grad
-      return phi * grad;
+      double const lower = minval - cellcenval;
+      double const upper = maxval - cellcenval;
+
+      // Find the min and max of the reconstructed function in the cell
+      // Since the reconstruction is linear, this will occur at one of
+      // the nodes of the cell. So find the values of the reconstructed
+      // function at the nodes of the cell. For multi-material problems,
+      // the reconstruction is defined over material polytopes instead of
+      // cells, so the reconstruction is evaluated in vertices of these
+      // polytopes. Their offsets from the reference point are cached.
+      int const begin = stencil.vertex_offsets[c];
+      int const end = stencil.vertex_offsets[c + 1];
+      double const* vec = stencil.vertices.data() + begin * D;
+
+      double phi = 1.0;
+      for (int k = begin; k < end; ++k, vec += D) {
+        double diff = 0.;
+        for (int d = 0; d < D; ++d)
+          diff += grad[d] * vec[d];
+        double const extremeval = (diff > 0.) ? upper : lower;
+        double const phi_new = (diff == 0. ? 1. : extremeval / diff);
+        phi = std::min(phi_new, phi);
+      }
+      return phi;
     }
 
-  private:
     Mesh const& mesh_;
     State const& state_;
     double const* values_ = nullptr;
@@ -617,19 +881,19 @@ namespace Portage {
     Limiter_type limiter_type_ = DEFAULT_LIMITER;
     Boundary_Limiter_type boundary_limiter_type_ = DEFAULT_BND_LIMITER;
     Field_type field_type_ = Field_type::UNKNOWN_TYPE_FIELD;
+    /** variables whose gradients are computed together */
+    std::vector<Field> fields_ {};
 
     int material_id_ = -1;
-    std::vector<int> cell_ids_;
     std::vector<std::vector<int>> neighbors_ {};
-    /** cached stencil matrices per cell and per material */
-    std::vector<std::vector<std::vector<Wonton::Matrix>>> stencils_ {};
-    /** filtered neighbors per cell and per material */
-    std::vector<std::vector<std::vector<int>>> valid_neigh_ {};
+    /** cached stencils per material */
+    std::vector<Stencils> stencils_ {};
     /** cached reference point per stencil and per material */
     std::vector<std::vector<Wonton::Point<D>>> reference_ {};
 
 #ifdef PORTAGE_HAS_TANGRAM
     std::shared_ptr<InterfaceReconstructor> interface_reconstructor_;
+    std::shared_ptr<MatPolyCache<D>> matpoly_cache_;
 #endif
     const Part<Mesh, State>* part_ = nullptr;
   };
@@ -758,6 +1022,15 @@ namespace Portage {
 
     void set_material(int material_id) { material_id_ = material_id; }
 
+    /**
+     * @brief Use precomputed dual cells of source nodes for the limiter.
+     *
+     * @param cache: the dual cells cache.
+     */
+    void set_dual_cell_cache(std::shared_ptr<DualCellCache<D>> cache) {
+      dual_cells_ = cache;
+    }
+
     void set_interpolation_variable(std::string const& variable_name,
                                     Limiter_type limiter_type = NOLIMITER,
                                     Boundary_Limiter_type boundary_limiter_type = BND_NOLIMITER) {
@@ -858,8 +1131,14 @@ namespace Portage {
         // function at the nodes of the cell
         double nodeval = values_[nodeid];
 
-        std::vector<Point<D>> dual_cell_coords;
-        mesh_.dual_cell_get_coordinates(nodeid, &dual_cell_coords);
+        bool const cached = dual_cells_ and dual_cells_->has_sources();
+        std::vector<Point<D>> dual_cell_buffer;
+        if (not cached)
+          mesh_.dual_cell_get_coordinates(nodeid, &dual_cell_buffer);
+
+        auto const dual_cell_coords = cached
+          ? dual_cells_->vertices(nodeid)
+          : ConstArrayView<Point<D>>(dual_cell_buffer);
 
         for (auto&& coord : dual_cell_coords) {
           auto vec = coord - reference_[nodeid];
@@ -889,6 +1168,8 @@ namespace Portage {
     std::vector<std::vector<Wonton::Matrix>> stencils_ {};
     /** cached reference point per stencil and per material */
     std::vector<Wonton::Point<D>> reference_ {};
+    /** cached dual cells of nodes */
+    std::shared_ptr<DualCellCache<D>> dual_cells_;
 
   };
 }  // namespace Portage
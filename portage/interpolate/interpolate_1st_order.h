@@ -23,6 +23,7 @@ Please see the license file at the root of this repository, or at:
 // portage includes
 #include "portage/intersect/dummy_interface_reconstructor.h"
 #include "portage/support/portage.h"
+#include "portage/interpolate/compressed_weights.h"
 #include "portage/driver/parts.h"
 
 #ifdef PORTAGE_HAS_TANGRAM
@@ -346,13 +347,31 @@ class Interpolate_1stOrder<
     entity; for first order interpolation, only the first element (or zero'th
     moment) of the weights vector (i.e. the volume of intersection) is used.
     Source entities may be repeated in the list if the intersection of a target
-    entity and a source entity consists of two or more disjoint pieces
+    entity and a source entity consists of two or more disjoint pieces.
+    It may also be a row of CompressedWeights.
     @param[in] targetCellId The index of the target cell.
 
   */
 
   T operator() (int const targetCellID,
-                     std::vector<Weights_t> const & sources_and_weights) const
+                std::vector<Weights_t> const & sources_and_weights) const {
+    return interpolate(targetCellID, sources_and_weights);
+  }
+
+  T operator() (int const targetCellID,
+                typename CompressedWeights<D>::Row const & sources_and_weights) const {
+    return interpolate(targetCellID, sources_and_weights);
+  }
+
+  constexpr static int order = 1;
+
+ private:
+  /*!
+    @brief Weighted average over a list of Weights_t or a compressed row.
+  */
+  template<class SourcesAndWeights>
+  T interpolate(int const targetCellID,
+                SourcesAndWeights const & sources_and_weights) const
   {
     int nsrccells = sources_and_weights.size();
     if (!nsrccells) return T(0.0);
@@ -367,7 +386,7 @@ class Interpolate_1stOrder<
     if (field_type_ == Field_type::MESH_FIELD) {
       for (auto const& wt : sources_and_weights) {
         int srccell = wt.entityID;
-        std::vector<double> pair_weights = wt.weights;
+        auto const& pair_weights = wt.weights;
         if (fabs(pair_weights[0]) < num_tols_.min_absolute_volume)
           continue;  // skip small intersections
         val += source_vals_[srccell] * pair_weights[0];
@@ -377,7 +396,7 @@ class Interpolate_1stOrder<
     } else if (field_type_ == Field_type::MULTIMATERIAL_FIELD) {
       for (auto const& wt : sources_and_weights) {
         int srccell = wt.entityID;
-        std::vector<double> pair_weights = wt.weights;
+        auto const& pair_weights = wt.weights;
         if (fabs(pair_weights[0]) < num_tols_.min_absolute_volume)
           continue;  // skip small intersections
         int matcell = source_state_.cell_index_in_material(srccell, matid_);
@@ -402,11 +421,8 @@ class Interpolate_1stOrder<
       val *= (1.0/wtsum0);
 
     return val;
-  }  // operator()
-  
-  constexpr static int order = 1;
+  }  // interpolate
 
- private:
   SourceMeshType const & source_mesh_;
   TargetMeshType const & target_mesh_;
   SourceStateType const & source_state_;
@@ -542,13 +558,31 @@ class Interpolate_1stOrder<
     entity; for first order interpolation, only the first element (or zero'th
     moment) of the weights vector (i.e. the volume of intersection) is used.
     Source entities may be repeated in the list if the intersection of a target
-    entity and a source entity consists of two or more disjoint pieces
+    entity and a source entity consists of two or more disjoint pieces.
+    It may also be a row of CompressedWeights.
     @param[in] targetCellId The index of the target cell.
 
   */
 
   T operator() (int const targetNodeID,
-                std::vector<Weights_t> const & sources_and_weights) const
+                std::vector<Weights_t> const & sources_and_weights) const {
+    return interpolate(targetNodeID, sources_and_weights);
+  }
+
+  T operator() (int const targetNodeID,
+                typename CompressedWeights<D>::Row const & sources_and_weights) const {
+    return interpolate(targetNodeID, sources_and_weights);
+  }
+
+  constexpr static int order = 1;
+
+ private:
+  /*!
+    @brief Weighted average over a list of Weights_t or a compressed row.
+  */
+  template<class SourcesAndWeights>
+  T interpolate(int const targetNodeID,
+                SourcesAndWeights const & sources_and_weights) const
   {
     if (field_type_ != Field_type::MESH_FIELD) return T(0.0);
 
@@ -564,7 +598,7 @@ class Interpolate_1stOrder<
     int nsummed = 0;
     for (auto const& wt : sources_and_weights) {
       int srcnode = wt.entityID;
-      std::vector<double> pair_weights = wt.weights;
+      auto const& pair_weights = wt.weights;
       if (fabs(pair_weights[0]) < num_tols_.min_absolute_volume)
         continue;  // skip small intersections
       val += source_vals_[srcnode] * pair_weights[0];  // 1st order
@@ -587,11 +621,8 @@ class Interpolate_1stOrder<
       val *= (1.0/wtsum0);
 
     return val;
-  }  // operator()
+  }  // interpolate
 
-  constexpr static int order = 1;
-
- private:
   SourceMeshType const & source_mesh_;
   TargetMeshType const & target_mesh_;
   SourceStateType const & source_state_;
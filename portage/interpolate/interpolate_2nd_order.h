@@ -21,7 +21,9 @@ Please see the license file at the root of this repository, or at:
 
 #include "portage/support/portage.h"
 #include "portage/interpolate/gradient.h"
+#include "portage/interpolate/compressed_weights.h"
 #include "portage/intersect/dummy_interface_reconstructor.h"
+#include "portage/intersect/matpoly_cache.h"
 #include "portage/driver/fix_mismatch.h"
 #include "portage/driver/parts.h"
 
@@ -318,6 +320,17 @@ namespace Portage {
      */
     void set_material(int m) { material_id_ = m; }
 
+#ifdef PORTAGE_HAS_TANGRAM
+    /**
+     * @brief Set the cache of material polytopes of mixed source cells.
+     *
+     * @param[in] cache: the material polytopes cache.
+     */
+    void set_matpoly_cache(std::shared_ptr<MatPolyCache<D>> cache) {
+      matpoly_cache_ = cache;
+    }
+#endif
+
 
     /**
      * @brief Set the name of the interpolation variable and the gradient field.
@@ -330,6 +343,7 @@ namespace Portage {
 
       variable_name_ = variable_name;
       gradients_ = gradient_field;
+      compressed_gradients_ = nullptr;
       field_type_ = source_state_.field_type(Entity_kind::CELL, variable_name);
 
       if (field_type_ == Field_type::MESH_FIELD) {
@@ -339,6 +353,19 @@ namespace Portage {
       }
     }
 
+    /**
+     * @brief Set the name of the interpolation variable and its gradient
+     *        field stored in single precision.
+     *
+     * @param[in] variable_name: the variable name
+     * @param[in] gradient_field: the compressed gradient field
+     */
+    void set_interpolation_variable(std::string const& variable_name,
+                                    CompressedGradients<D> const* gradient_field) {
+      set_interpolation_variable(variable_name);
+      compressed_gradients_ = gradient_field;
+    }
+
 
     /**
      * @brief Functor to compute the interpolation of cell values.
@@ -351,17 +378,35 @@ namespace Portage {
      * of the weights vector (volume of intersection) is used.
      * Source entities may be repeated in the list if the intersection of a
      * target cell and a source cell consists of two or more disjoint pieces.
+     * The list may also be a row of CompressedWeights.
      *
      * @return the interpolated value.
      * @todo must remove assumption that field is scalar.
      */
     double operator()(int cell_id,
                       std::vector<Weights_t> const& sources_and_weights) const {
+      return interpolate(cell_id, sources_and_weights);
+    }
+
+    double operator()(int cell_id,
+                      typename CompressedWeights<D>::Row const& sources_and_weights) const {
+      return interpolate(cell_id, sources_and_weights);
+    }
+
+    constexpr static int order = 2;
+
+  private:
+    /**
+     * @brief Linear reconstruction over a list of Weights_t or a compressed row.
+     */
+    template<class SourcesAndWeights>
+    double interpolate(int cell_id,
+                       SourcesAndWeights const& sources_and_weights) const {
 
       if (sources_and_weights.empty())
         return 0.;
 
-      auto const& gradient_field = *gradients_;
+      assert(gradients_ != nullptr or compressed_gradients_ != nullptr);
       double total_value = 0.;
       double normalization = 0.;
 
@@ -372,16 +417,17 @@ namespace Portage {
       int nb_summed = 0;
 
 #ifdef PORTAGE_HAS_TANGRAM
-      std::vector<std::shared_ptr<Tangram::CellMatPoly<D>>> cmp_ptrs;
+      // refer to the reconstructor's list instead of copying it per target cell
+      std::vector<std::shared_ptr<Tangram::CellMatPoly<D>>> const* cmp_list = nullptr;
       if (interface_reconstructor_ != nullptr)
-        cmp_ptrs = interface_reconstructor_->cell_matpoly_ptrs();
+        cmp_list = &(interface_reconstructor_->cell_matpoly_ptrs());
 #endif
 
       // Loop over source cells
       for (auto&& current : sources_and_weights) {
         // Get source cell and the intersection weights
         int src_cell = current.entityID;
-        auto intersect_weights = current.weights;
+        auto const& intersect_weights = current.weights;
         double intersect_volume = intersect_weights[0];
 
         if (fabs(intersect_volume) <= num_tols_.min_absolute_volume)
@@ -405,22 +451,28 @@ namespace Portage {
           bool pure_cell = non_materialistic_cells || (nb_mats == 1);
 
           if (!pure_cell) {
-            assert(interface_reconstructor_ != nullptr);
-            assert(cmp_ptrs[src_cell] != nullptr);
-            nb_mats = cmp_ptrs[src_cell]->num_materials();
-            cellmats = cmp_ptrs[src_cell]->cell_matids();
+            assert(cmp_list != nullptr);
+            assert((*cmp_list)[src_cell] != nullptr);
+            nb_mats = (*cmp_list)[src_cell]->num_materials();
+            cellmats = (*cmp_list)[src_cell]->cell_matids();
             pure_cell = (nb_mats == 1);
           }
 
           bool source_cell_has_mat = pure_cell ? non_materialistic_cells || (cellmats[0] == material_id_) :
-                                                 cmp_ptrs[src_cell]->is_cell_material(material_id_);                                 
+                                                 (*cmp_list)[src_cell]->is_cell_material(material_id_);                                 
 
           if (source_cell_has_mat) {
+            // reuse the aggregated moments computed after reconstruction if any
+            auto const* cached = (not pure_cell and matpoly_cache_)
+              ? matpoly_cache_->find(src_cell, material_id_) : nullptr;
+
             if (pure_cell) {
               source_mesh_.cell_centroid(src_cell, &source_centroid);
+            } else if (cached != nullptr) {
+              source_centroid = MatPolyCache<D>::centroid(*cached);
             } else { /* multi-material cell with this material */
               // obtain matpoly's for this material
-              auto matpolys = cmp_ptrs[src_cell]->get_matpolys(material_id_);
+              auto matpolys = (*cmp_list)[src_cell]->get_matpolys(material_id_);
 
               for (int k = 0; k < D; k++)
                 source_centroid[k] = 0;
@@ -456,7 +508,9 @@ namespace Portage {
           ? source_state_.cell_index_in_material(src_cell, material_id_)
           : src_cell);
 
-        Vector<D> gradient = gradient_field[source_index];
+        Vector<D> gradient = compressed_gradients_
+                             ? (*compressed_gradients_)[source_index]
+                             : (*gradients_)[source_index];
         Vector<D> dr = intersect_centroid - source_centroid;
         CoordSys::modify_line_element(dr, source_centroid);
 
@@ -477,10 +531,7 @@ namespace Portage {
        */
       return nb_summed ? total_value / normalization : 0.;
     }
-    
-    constexpr static int order = 2;
 
-  private:
     SourceMeshType const& source_mesh_;
     TargetMeshType const& target_mesh_;
     SourceStateType const& source_state_;
@@ -489,9 +540,11 @@ namespace Portage {
     NumericTolerances_t num_tols_;
     int material_id_ = 0;
     Wonton::vector<Wonton::Vector<D>> const* gradients_;
+    CompressedGradients<D> const* compressed_gradients_ = nullptr;
     Field_type field_type_ = Field_type::UNKNOWN_TYPE_FIELD;
 #ifdef PORTAGE_HAS_TANGRAM
     std::shared_ptr<InterfaceReconstructor> interface_reconstructor_;
+    std::shared_ptr<MatPolyCache<D>> matpoly_cache_;
 #endif
     Parts const* parts_;
   };
@@ -652,6 +705,23 @@ namespace Portage {
      */
     double operator()(int node_id,
                       std::vector<Weights_t> const& sources_and_weights) const {
+      return interpolate(node_id, sources_and_weights);
+    }
+
+    double operator()(int node_id,
+                      typename CompressedWeights<D>::Row const& sources_and_weights) const {
+      return interpolate(node_id, sources_and_weights);
+    }
+
+    constexpr static int order = 2;
+
+  private:
+    /**
+     * @brief Linear reconstruction over a list of Weights_t or a compressed row.
+     */
+    template<class SourcesAndWeights>
+    double interpolate(int node_id,
+                       SourcesAndWeights const& sources_and_weights) const {
 
       if (sources_and_weights.empty())
         return 0.;
@@ -666,7 +736,7 @@ namespace Portage {
 
       for (auto&& current : sources_and_weights) {
         int src_node = current.entityID;
-        auto intersect_weights = current.weights;
+        auto const& intersect_weights = current.weights;
         double intersect_volume = intersect_weights[0];
 
         if (fabs(intersect_volume) <= num_tols_.min_absolute_volume)
@@ -706,9 +776,6 @@ namespace Portage {
       return nb_summed ? total_value / normalization : 0.;
     }
 
-    constexpr static int order = 2;
-
-  private:
     SourceMeshType const& source_mesh_;
     TargetMeshType const& target_mesh_;
     SourceStateType const& source_state_;
@@ -12,6 +12,7 @@ Please see the license file at the root of this repository, or at:
 #include <algorithm>
 #include <string>
 #include <iostream>
+#include <memory>
 #include <utility>
 #include <vector>
 
@@ -96,8 +97,8 @@ class Interpolate_3rdOrder {
     // Compute the limited quadfits for the field
 
     Limited_Quadfit<D, on_what, SourceMeshType, SourceStateType>
-        limqfit(source_mesh_, source_state_, interp_var_name, 
-                limiter_type, boundary_limiter_type);
+        limqfit(source_mesh_, source_state_);
+    limqfit.set_interpolation_variable(interp_var_name, limiter_type, boundary_limiter_type);
 
 
     int nentities = source_mesh_.end(on_what)-source_mesh_.begin(on_what);
@@ -211,10 +212,14 @@ class Interpolate_3rdOrder<
 
     source_state_.mesh_get_data(Entity_kind::CELL, interp_var_name, &source_vals_);
 
-    // Compute the limited quadfits for the field
+    // Compute the limited quadfits for the field. The quadfit stencils
+    // only depend on the mesh, they are built for the first field and
+    // reused for the next ones
 
     Limited_Quadfit<D, Entity_kind::CELL, SourceMeshType, SourceStateType>
-        limqfit(source_mesh_, source_state_, interp_var_name_, limiter_type, boundary_limiter_type);
+        limqfit(source_mesh_, source_state_, quadfit_stencils_);
+    limqfit.set_interpolation_variable(interp_var_name_, limiter_type, boundary_limiter_type);
+    quadfit_stencils_ = limqfit.stencils();
 
     int nentities = source_mesh_.end(Entity_kind::CELL)-source_mesh_.begin(Entity_kind::CELL);
     quadfits_.resize(nentities);
@@ -241,6 +246,15 @@ class Interpolate_3rdOrder<
   /// Destructor
   ~Interpolate_3rdOrder() = default;
 
+  /*!
+    @brief Share the quadfit stencils of the source mesh.
+    @param[in] stencils stencils built by a previous interpolator on the
+    same source mesh, or empty ones to be filled by this interpolator.
+  */
+  void set_quadfit_stencils(std::shared_ptr<QuadfitStencils<D>> const& stencils) {
+    quadfit_stencils_ = stencils;
+  }
+
 
   /*!
     @brief   Functor to do the 3rd order interpolation of cell values
@@ -287,7 +301,7 @@ class Interpolate_3rdOrder<
     for (int j = 0; j < nsrccells; ++j) {
       int srccell = sources_and_weights[j].entityID;
       // int N = D*(D+3)/2;
-      std::vector<double> xsect_weights = sources_and_weights[j].weights;
+      std::vector<double> const& xsect_weights = sources_and_weights[j].weights;
       double xsect_volume = xsect_weights[0];
 
       if (xsect_volume <= num_tols_.min_absolute_volume)
@@ -300,18 +314,35 @@ class Interpolate_3rdOrder<
       for (int i = 0; i < D; ++i)
         xsect_centroid[i] = xsect_weights[1+i]/xsect_volume;  // (1st moment)/vol
 
-      Vector<D*(D+3)/2> quadfit = quadfits_[srccell];
+      Vector<D*(D+3)/2> const& quadfit = quadfits_[srccell];
       Vector<D> vec = xsect_centroid - srccell_centroid;
       Vector<D*(D+3)/2> dvec;
-      for (int j = 0; j < D; ++j) {
+
+      // If the intersector provided the second moments of the
+      // intersection, the quadratic terms are averaged exactly over it
+      // (in the order used by Wonton::ls_quadfit), otherwise they are
+      // approximated at its centroid.
+      bool const has_second_moments =
+          int(xsect_weights.size()) >= (D+1)*(D+2)/2;
+
+      if (has_second_moments) {
         int j1 = D;
-        dvec[j] = vec[j];
-        // Add the quadratic terms
-        for (int k = 0; k <= j; ++k) {
-          dvec[j1] = dvec[k]*dvec[j];
-          j1 += 1;
-          //dvec[D+j+k] = dvec[k]*dvec[j];
+        for (int j = 0; j < D; ++j) {
+          dvec[j] = vec[j];
+          for (int k = 0; k <= j; ++k) {
+            // second moments are ordered as [x^2, xy, (xz,) y^2, (yz, z^2)]
+            int const m2 = 1 + D + k*D - k*(k-1)/2 + (j-k);
+            double const x0j = srccell_centroid[j];
+            double const x0k = srccell_centroid[k];
+            // average of (x_j - x0_j)(x_k - x0_k) over the intersection
+            dvec[j1] = (xsect_weights[m2]
+                        - x0j*xsect_weights[1+k] - x0k*xsect_weights[1+j]
+                        + x0j*x0k*xsect_volume) / xsect_volume;
+            j1 += 1;
+          }
         }
+      } else {
+        quadfit_monomials<D>(vec, dvec);
       }
       double val = source_vals_[srccell] + dot(quadfit,dvec);
       val *= xsect_volume;
@@ -340,6 +371,9 @@ class Interpolate_3rdOrder<
   // Wonton::vector is generalization of std::vector and
   // Wonton::Vector<D> is a geometric vector
   Wonton::vector<Vector<D*(D+3)/2>> quadfits_;
+
+  // least-squares quadfit stencils of the source mesh, built once
+  std::shared_ptr<QuadfitStencils<D>> quadfit_stencils_;
 };
 
 //////////////////////////////////////////////////////////////////////////////
@@ -385,6 +419,15 @@ class Interpolate_3rdOrder<
   /// Destructor
   ~Interpolate_3rdOrder() = default;
 
+  /*!
+    @brief Share the quadfit stencils of the source mesh.
+    @param[in] stencils stencils built by a previous interpolator on the
+    same source mesh, or empty ones to be filled by this interpolator.
+  */
+  void set_quadfit_stencils(std::shared_ptr<QuadfitStencils<D>> const& stencils) {
+    quadfit_stencils_ = stencils;
+  }
+
 
   /// Set the name of the interpolation variable and the limiter type
 
@@ -399,10 +442,14 @@ class Interpolate_3rdOrder<
 
     source_state_.mesh_get_data(Entity_kind::NODE, interp_var_name, &source_vals_);
 
-    // Compute the limited quadfits for the field
+    // Compute the limited quadfits for the field. The quadfit stencils
+    // only depend on the mesh, they are built for the first field and
+    // reused for the next ones
 
     Limited_Quadfit<D, Entity_kind::NODE, SourceMeshType, SourceStateType>
-        limqfit(source_mesh_, source_state_, interp_var_name, limiter_type, boundary_limiter_type);
+        limqfit(source_mesh_, source_state_, quadfit_stencils_);
+    limqfit.set_interpolation_variable(interp_var_name, limiter_type, boundary_limiter_type);
+    quadfit_stencils_ = limqfit.stencils();
 
     int nentities = source_mesh_.end(Entity_kind::NODE)-source_mesh_.begin(Entity_kind::NODE);
     quadfits_.resize(nentities);
@@ -470,7 +517,7 @@ class Interpolate_3rdOrder<
 
     for (int j = 0; j < nsrcnodes; ++j) {
       int srcnode = sources_and_weights[j].entityID;
-      std::vector<double> xsect_weights = sources_and_weights[j].weights;
+      std::vector<double> const& xsect_weights = sources_and_weights[j].weights;
       double xsect_volume = xsect_weights[0];
 
       if (xsect_volume <= num_tols_.min_absolute_volume)
@@ -486,19 +533,10 @@ class Interpolate_3rdOrder<
         // (1st moment)/(vol)
         xsect_centroid[i] = xsect_weights[1+i]/xsect_volume;
 
-      Vector<D*(D+3)/2> quadfit = quadfits_[srcnode];
+      Vector<D*(D+3)/2> const& quadfit = quadfits_[srcnode];
       Vector<D> vec = xsect_centroid - srcnode_coord;
       Vector<D*(D+3)/2> dvec;
-      for (int j = 0; j < D; ++j) {
-        int j1 = D;
-        dvec[j] = vec[j];
-        // Add the quadratic terms
-        for (int k = 0; k <= j; ++k) {
-          dvec[j1] = dvec[k]*dvec[j];
-          j1 += 1;
-          // dvec[D+j+k] = dvec[k]*dvec[j];
-        }
-      }
+      quadfit_monomials<D>(vec, dvec);
       double val = source_vals_[srcnode] + dot(quadfit,dvec);
       val *= xsect_volume;
       totalval += val;
@@ -524,6 +562,9 @@ class Interpolate_3rdOrder<
   // Wonton::vector is generalization of std::vector and
   // Wonton::Vector<D> is a geometric vector
   Wonton::vector<Vector<D*(D+3)/2>> quadfits_;
+
+  // least-squares quadfit stencils of the source mesh, built once
+  std::shared_ptr<QuadfitStencils<D>> quadfit_stencils_;
 };
 }  // namespace Portage
 
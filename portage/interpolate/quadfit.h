@@ -8,12 +8,14 @@ Please see the license file at the root of this repository, or at:
 #define PORTAGE_INTERPOLATE_QUADFIT_H_
 
 #include <algorithm>
+#include <array>
+#include <cassert>
+#include <memory>
+#include <numeric>
 #include <stdexcept>
 #include <string>
 #include <vector>
 
-#include <iostream>
-
 // wonton includes
 #include "wonton/support/wonton.h"
 #include "wonton/support/lsfits.h"
@@ -30,6 +32,201 @@ using Wonton::Vector;
 
 ///////////////////////////////////////////////////////////////////////////////
 
+/*! @brief Linear and quadratic monomials of an offset
+    @param[in] vec The offset from the fit center
+    @param[out] dvec The D*(D+3)/2 monomials, in the order of the
+                coefficients of Wonton::ls_quadfit: x, y, (z,) then
+                x^2, xy, y^2, (xz, yz, z^2)
+*/
+template<int D, class Monomials>
+void quadfit_monomials(Vector<D> const& vec, Monomials& dvec) {
+  int j1 = D;
+  for (int j = 0; j < D; ++j) {
+    dvec[j] = vec[j];
+    // Add the quadratic terms
+    for (int k = 0; k <= j; ++k) {
+      dvec[j1] = vec[k]*vec[j];
+      j1 += 1;
+    }
+  }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+/*! @class QuadfitStencils quadfit.h
+    @brief Cached least-squares quadratic fit stencils of a mesh
+    @tparam D The dimension of the problem
+
+    A least-squares quadfit is linear in the field values, so the fit
+    of an entity is a weighted sum of the values of its stencil points
+    (the entity itself followed by its neighbors), each weight being a
+    vector of D*(D+3)/2 coefficients (5 in 2D, 9 in 3D). These weights
+    only depend on the geometry: they are computed once per mesh by
+    applying Wonton::ls_quadfit to unit values, which keeps its basis
+    and its linear fallback on boundary entities, and stored flat in
+    compressed sparse row (CSR) format as fixed size arrays.
+
+    The monomials of the entity vertices relative to the stencil center,
+    used by the Barth-Jespersen limiter, are stored the same way.
+
+    Fitting a field is then a dense fixed size accumulation per entity,
+    with neither mesh queries nor matrix solves nor allocations, and the
+    same stencils are shared by all the fields remapped on the mesh.
+*/
+
+template<int D>
+class QuadfitStencils {
+ public:
+  /// Number of coefficients of the quadratic fit.
+  static constexpr int N = D*(D+3)/2;
+
+  using Coefficients = std::array<double, N>;
+
+  /// Whether the stencils were built.
+  bool empty() const { return offsets_.size() <= 1; }
+
+  /*! @brief Build the stencils of a set of entities
+      @param[in] nentities Number of entities
+      @param[in] gather Callable as gather(id, &ids, &points, &vertices, &boundary)
+                 retrieving for an entity the indices and coordinates of its
+                 stencil points (entity first), its vertices and whether it
+                 lies on the exterior boundary.
+  */
+  template<class Gather>
+  void build(int nentities, Gather&& gather) {
+
+    // per-entity temporaries, flattened afterwards
+    std::vector<std::vector<int>> ids(nentities);
+    std::vector<std::vector<Coefficients>> weights(nentities);
+    std::vector<std::vector<Coefficients>> vertices(nentities);
+    std::vector<int> boundary(nentities, 0);
+
+    std::vector<int> entities(nentities);
+    std::iota(entities.begin(), entities.end(), 0);
+
+    Wonton::for_each(entities.begin(), entities.end(), [&](int n) {
+      std::vector<Point<D>> points, coords;
+      bool boundary_entity = false;
+      gather(n, &(ids[n]), &points, &coords, &boundary_entity);
+      boundary[n] = boundary_entity;
+
+      // fit of each unit value gives the weights of each stencil point
+      int const npoints = points.size();
+      std::vector<double> unit(npoints, 0.);
+      weights[n].resize(npoints);
+      for (int i = 0; i < npoints; ++i) {
+        unit[i] = 1.;
+        auto const qfit = Wonton::ls_quadfit(points, unit, boundary_entity);
+        for (int k = 0; k < N; ++k)
+          weights[n][i][k] = qfit[k];
+        unit[i] = 0.;
+      }
+
+      vertices[n].resize(coords.size());
+      for (int v = 0; v < int(coords.size()); ++v)
+        quadfit_monomials<D>(coords[v] - points[0], vertices[n][v]);
+    });
+
+    boundary_.swap(boundary);
+    offsets_.assign(nentities + 1, 0);
+    vertex_offsets_.assign(nentities + 1, 0);
+    for (int n = 0; n < nentities; ++n) {
+      offsets_[n + 1] = offsets_[n] + ids[n].size();
+      vertex_offsets_[n + 1] = vertex_offsets_[n] + vertices[n].size();
+    }
+
+    points_.resize(offsets_[nentities]);
+    weights_.resize(offsets_[nentities]);
+    vertices_.resize(vertex_offsets_[nentities]);
+
+    Wonton::for_each(entities.begin(), entities.end(), [&](int n) {
+      std::copy(ids[n].begin(), ids[n].end(), points_.begin() + offsets_[n]);
+      std::copy(weights[n].begin(), weights[n].end(), weights_.begin() + offsets_[n]);
+      std::copy(vertices[n].begin(), vertices[n].end(),
+                vertices_.begin() + vertex_offsets_[n]);
+    });
+  }
+
+  /// Whether an entity lies on the exterior boundary.
+  bool on_boundary(int n) const { return boundary_[n]; }
+
+  /// Range of the stencil points of an entity in points().
+  int begin(int n) const { return offsets_[n]; }
+  int end(int n) const { return offsets_[n + 1]; }
+
+  /// Flat indices of the stencil points.
+  std::vector<int> const& points() const { return points_; }
+
+  /*! @brief Unlimited quadfit of a field on an entity
+      @param[in] n The entity
+      @param[in] values The field values
+  */
+  Coefficients fit(int n, double const* values) const {
+    Coefficients qfit {};
+    for (int i = offsets_[n]; i < offsets_[n + 1]; ++i) {
+      double const value = values[points_[i]];
+      Coefficients const& weight = weights_[i];
+      for (int k = 0; k < N; ++k)
+        qfit[k] += weight[k] * value;
+    }
+    return qfit;
+  }
+
+  /*! @brief Barth-Jespersen limiting factor of a quadfit on an entity
+      @param[in] n The entity
+      @param[in] qfit The unlimited quadfit
+      @param[in] center The field value of the entity
+      @param[in] minval, maxval The bounds of the field among neighbors
+  */
+  double limiter(int n, Coefficients const& qfit,
+                 double center, double minval, double maxval) const {
+    double phi = 1.0;
+    for (int v = vertex_offsets_[n]; v < vertex_offsets_[n + 1]; ++v) {
+      Coefficients const& dvec = vertices_[v];
+      double diff = 0.;
+      for (int k = 0; k < N; ++k)
+        diff += qfit[k] * dvec[k];
+      double extremeval = (diff > 0.0) ? maxval : minval;
+      double phi_new = (diff == 0.0) ? 1 : (extremeval-center)/diff;
+      phi = std::min(phi_new, phi);
+    }
+    return phi;
+  }
+
+ private:
+  std::vector<int> offsets_ {0};
+  std::vector<int> points_ {};
+  std::vector<Coefficients> weights_ {};
+  std::vector<int> boundary_ {};
+  std::vector<int> vertex_offsets_ {0};
+  std::vector<Coefficients> vertices_ {};
+};
+
+namespace detail {
+
+template<class Functor, class Stencils>
+auto attach_quadfit_stencils(Functor& functor, Stencils const& stencils, int)
+  -> decltype(functor.set_quadfit_stencils(stencils), void()) {
+  functor.set_quadfit_stencils(stencils);
+}
+
+template<class Functor, class Stencils>
+void attach_quadfit_stencils(Functor&, Stencils const&, long) {}
+
+}  // namespace detail
+
+/*! @brief Hand the quadfit stencils of a mesh to an interpolation
+           functor if it is able to use them.
+    @param[in] functor The functor.
+    @param[in] stencils The stencils, built by the first functor using them.
+*/
+template<class Functor, int D>
+void attach_quadfit_stencils(Functor& functor,
+                             std::shared_ptr<QuadfitStencils<D>> const& stencils) {
+  detail::attach_quadfit_stencils(functor, stencils, 0);
+}
+
+///////////////////////////////////////////////////////////////////////////////
 
 /*! @class Limited_Quadfit quadfit.h
     @brief Compute limited quadfit of a field or components of a field
@@ -58,15 +255,31 @@ class Limited_Quadfit {
                    std::string const var_name,
                    Limiter_type limiter_type,
                    Boundary_Limiter_type Boundary_Limiter_type)
+    : Limited_Quadfit(mesh, state) {
+    set_interpolation_variable(var_name, limiter_type, Boundary_Limiter_type);
+  }
+
+  /*! @brief Constructor
+      @param[in] mesh  Mesh class than one can query for mesh info
+      @param[in] state A state manager class that one can query for field info
+   */
+
+  Limited_Quadfit(MeshType const & mesh, StateType const & state)
     : mesh_(mesh),
-      state_(state),
-      var_name_(var_name),
-      limtype_(limiter_type),
-      bnd_limtype_(Boundary_Limiter_type) {
+      state_(state) {}
+
+  /// Set the field for which the quadfit is to be computed
+
+  void set_interpolation_variable(std::string const & var_name,
+                                  Limiter_type limiter_type,
+                                  Boundary_Limiter_type Boundary_Limiter_type) {
+    var_name_ = var_name;
+    limtype_ = limiter_type;
+    bnd_limtype_ = Boundary_Limiter_type;
 
     // Extract the field data from the statemanager
 
-    state.mesh_get_data(on_what, var_name, &vals_);
+    state_.mesh_get_data(on_what, var_name, &vals_);
   }
 
   /// @todo Seems to be needed when using this in a Thrust transform call?
@@ -86,7 +299,7 @@ class Limited_Quadfit {
   /// Functor - not implemented for all types - see specialization for
   /// cells, nodes
 
-  Vector<D*(D+3)/2> operator()(int entity_id) {
+  Vector<D*(D+3)/2> operator()(int entity_id) const {
     throw std::runtime_error("Limited quadfit not implemented for this entity kind");
   }
 
@@ -94,14 +307,15 @@ class Limited_Quadfit {
   MeshType const & mesh_;
   StateType const & state_;
   std::string var_name_;
-  double const* vals_;
-  Limiter_type limtype_;
-  Boundary_Limiter_type bnd_limtype_;
+  double const* vals_ = nullptr;
+  Limiter_type limtype_ = NOLIMITER;
+  Boundary_Limiter_type bnd_limtype_ = BND_NOLIMITER;
 };
 
 
 ///////////////////////////////////////////////////////////////////////////////
 
+
 /*! @class Limited_Quadfit<MeshType,StateType,CELL> quadfit.h
     @brief Specialization of limited quadfit class for @c cell-centered field
     @tparam MeshType A mesh class that one can query for mesh info
@@ -111,6 +325,49 @@ class Limited_Quadfit {
 template<int D, typename MeshType, typename StateType>
 class Limited_Quadfit<D, Entity_kind::CELL, MeshType, StateType> {
  public:
+  /*! @brief Constructor
+      @param[in] mesh  Mesh class than one can query for mesh info
+      @param[in] state A state manager class that one can query for field info
+      @param[in] stencils Quadfit stencils of the mesh, built here if empty
+
+      The field is set afterwards with set_interpolation_variable, so
+      that the stencils are built once for all the fields of the mesh.
+   */
+
+  Limited_Quadfit(MeshType const & mesh, StateType const & state,
+                  std::shared_ptr<QuadfitStencils<D>> stencils = nullptr)
+    : mesh_(mesh),
+      state_(state),
+      stencils_(stencils ? stencils : std::make_shared<QuadfitStencils<D>>()) {
+
+    assert(D == mesh_.space_dimension());
+    assert(D == 2 || D == 3);
+
+    // Collect the centroids of each cell and its node neighbors once,
+    // as well as the cell vertices for the limiter, as it may be
+    // expensive to go to the mesh layer and collect this data for
+    // each cell and each field during the actual quadfit calculation
+
+    if (stencils_->empty()) {
+      int ncells = mesh_.num_entities(Entity_kind::CELL);
+      stencils_->build(ncells, [this](int c, std::vector<int>* ids,
+                                      std::vector<Point<D>>* points,
+                                      std::vector<Point<D>>* vertices,
+                                      bool* boundary) {
+        std::vector<int> nbrids;
+        mesh_.cell_get_node_adj_cells(c, Entity_type::ALL, &nbrids);
+        ids->resize(nbrids.size() + 1);
+        points->resize(nbrids.size() + 1);
+        (*ids)[0] = c;
+        std::copy(nbrids.begin(), nbrids.end(), ids->begin() + 1);
+        for (int i = 0; i < int(ids->size()); ++i)
+          mesh_.cell_centroid((*ids)[i], &((*points)[i]));
+        mesh_.cell_get_coordinates(c, vertices);
+        *boundary = mesh_.on_exterior_boundary(Entity_kind::CELL, c);
+      });
+    }
+  }
+
   /*! @brief Constructor
       @param[in] mesh  Mesh class than one can query for mesh info
       @param[in] state A state manager class that one can query for field info
@@ -125,27 +382,30 @@ class Limited_Quadfit<D, Entity_kind::CELL, MeshType, StateType> {
                    std::string const var_name,
                    Limiter_type limiter_type,
                    Boundary_Limiter_type Boundary_Limiter_type)
-    : mesh_(mesh),
-      state_(state),
-      var_name_(var_name),
-      limtype_(limiter_type),
-      bnd_limtype_(Boundary_Limiter_type) {
-
-    // Extract the field data from the statemanager
-    state.mesh_get_data(Entity_kind::CELL, var_name, &vals_);
+    : Limited_Quadfit(mesh, state) {
+    set_interpolation_variable(var_name, limiter_type, Boundary_Limiter_type);
+  }
 
-    // Collect and keep the list of neighbors for each NODE as it may
-    // be expensive to go to the mesh layer and collect this data for
-    // each cell during the actual quadfit calculation
+  /*! @brief Set the field for which the quadfit is to be computed
+      @param[in] var_name Name of field
+      @param[in] limiter_type An enum indicating if the limiter type (none, Barth-Jespersen, Superbee etc)
+      @param[in] Boundary_Limiter_type An enum indicating the limiter type on the boundary
+   */
 
-    int ncells = mesh_.num_entities(Entity_kind::CELL);
-    cell_neighbors_.resize(ncells);
+  void set_interpolation_variable(std::string const & var_name,
+                                  Limiter_type limiter_type,
+                                  Boundary_Limiter_type Boundary_Limiter_type) {
+    var_name_ = var_name;
+    limtype_ = limiter_type;
+    bnd_limtype_ = Boundary_Limiter_type;
 
-    Wonton::for_each(mesh_.begin(Entity_kind::CELL), mesh_.end(Entity_kind::CELL),
-                      [this](int c) { mesh_.cell_get_node_adj_cells(
-                             c, Entity_type::ALL, &(cell_neighbors_[c])); } );
+    // Extract the field data from the statemanager
+    state_.mesh_get_data(Entity_kind::CELL, var_name, &vals_);
   }
 
+  /// Quadfit stencils of the mesh, to be shared with other instances
+  std::shared_ptr<QuadfitStencils<D>> const& stencils() const { return stencils_; }
+
   /// @todo Seems to be needed when using this in a Thrust transform call?
   //
   //  //! Copy constructor (deleted)
@@ -162,16 +422,16 @@ class Limited_Quadfit<D, Entity_kind::CELL, MeshType, StateType> {
 
   /// Functor
 
-  Vector<D*(D+3)/2> operator()(int cellid);
+  Vector<D*(D+3)/2> operator()(int cellid) const;
 
  private:
   MeshType const & mesh_;
   StateType const & state_;
+  std::shared_ptr<QuadfitStencils<D>> stencils_;
   std::string var_name_;
-  double const *vals_;
-  Limiter_type limtype_;
-  Boundary_Limiter_type bnd_limtype_;
-  std::vector<std::vector<int>> cell_neighbors_;
+  double const *vals_ = nullptr;
+  Limiter_type limtype_ = NOLIMITER;
+  Boundary_Limiter_type bnd_limtype_ = BND_NOLIMITER;
 };
 
   /*! @brief Implementation of Limited_Quadfit functor for CELLs
@@ -179,44 +439,27 @@ class Limited_Quadfit<D, Entity_kind::CELL, MeshType, StateType> {
       multinomial using a Least-Squared fit. Returns an
       array of parameters.  If the CELL is on a boundary
       the stencil is too small, so it drops to linear order.
-      Uses an SVD decomposition for the LS regression.
+      The fit is applied through the cached stencil weights.
 
   */
 template<int D, typename MeshType, typename StateType>
   Vector<D*(D+3)/2>
-Limited_Quadfit<D, Entity_kind::CELL, MeshType, StateType>::operator() (int const cellid) {
+Limited_Quadfit<D, Entity_kind::CELL, MeshType, StateType>::operator() (int const cellid) const {
 
-  assert(D == mesh_.space_dimension());
-  assert(D == 2 || D == 3);
+  constexpr int N = D*(D+3)/2;
   double phi = 1.0;
-  Vector<D*(D+3)/2> qfit;
-  Vector<D*(D+3)/2> dvec;
+  Vector<N> qfit;
 
-  bool boundary_cell =  mesh_.on_exterior_boundary(Entity_kind::CELL, cellid);
+  QuadfitStencils<D> const& stencils = *stencils_;
+  bool boundary_cell = stencils.on_boundary(cellid);
   // Limit the boundary gradient to enforce monotonicity preservation
   if (bnd_limtype_ == BND_ZERO_GRADIENT && boundary_cell) {
     qfit.zero();
     return qfit;
   }
 
-  std::vector<int> const & nbrids = cell_neighbors_[cellid];
-
-  std::vector<Point<D>> cellcenters(nbrids.size()+1);
-  std::vector<double> cellvalues(nbrids.size()+1);
-
-  // get centroid and value for cellid at center of point cloud
-  mesh_.cell_centroid(cellid, &(cellcenters[0]));
-
-  cellvalues[0] = vals_[cellid];
+  auto const fit = stencils.fit(cellid, vals_);
 
-  int i = 1;
-  for (auto nbrcell : nbrids) {
-    mesh_.cell_centroid(nbrcell, &(cellcenters[i]));
-    cellvalues[i] = vals_[nbrcell];
-    i++;
-  }
-
-  qfit = Wonton::ls_quadfit(cellcenters, cellvalues, boundary_cell);
   // Limit the gradient to enforce monotonicity preservation
 
   if (limtype_ == BARTH_JESPERSEN && 
@@ -228,10 +471,14 @@ Limited_Quadfit<D, Entity_kind::CELL, MeshType, StateType>::operator() (int cons
     double minval = vals_[cellid];
     double maxval = vals_[cellid];
 
-    int nnbr = nbrids.size();
+    // the stencil starts with the cell itself, then its neighbors
+    std::vector<int> const& points = stencils.points();
+    int const first = stencils.begin(cellid);
+    int const nnbr = stencils.end(cellid) - first - 1;
     for (int ic = 0; ic < nnbr; ++ic) {
-      minval = std::min(cellvalues[ic], minval);
-      maxval = std::max(cellvalues[ic], maxval);
+      double const val = vals_[points[first + ic]];
+      minval = std::min(val, minval);
+      maxval = std::max(val, maxval);
     }
 
     // Find the min and max of the reconstructed function in the cell
@@ -239,31 +486,13 @@ Limited_Quadfit<D, Entity_kind::CELL, MeshType, StateType>::operator() (int cons
     // the nodes of the cell. So find the values of the reconstructed
     // function at the nodes of the cell
 
-    double cellcenval = vals_[cellid];
-    std::vector<Point<D>> cellcoords;
-    mesh_.cell_get_coordinates(cellid, &cellcoords);
-
-    for (auto coord : cellcoords) {
-      Vector<D> vec = coord-cellcenters[0];
-      //Vector<D*(D+3)/2> dvec;
-      for (int j = 0; j < D; ++j) {
-        dvec[j] = vec[j];
-        // Add the quadratic terms
-        for (int k = 0; k < j; ++k) {
-          dvec[j+k+D-1] = dvec[k]*dvec[j];
-        }
-      }
-
-      double diff = dot(qfit, dvec);
-      double extremeval = (diff > 0.0) ? maxval : minval;
-      double phi_new = (diff == 0.0) ? 1 : (extremeval-cellcenval)/diff;
-      phi = std::min(phi_new, phi);
-    }
-
+    phi = stencils.limiter(cellid, fit, vals_[cellid], minval, maxval);
   }
 
   // Limited quadfit is phi*fit
-  return phi*qfit;
+  for (int k = 0; k < N; ++k)
+    qfit[k] = phi * fit[k];
+  return qfit;
 }
 
 
@@ -280,6 +509,49 @@ template<int D, typename MeshType, typename StateType>
 class Limited_Quadfit<D, Entity_kind::NODE, MeshType, StateType> {
  public:
 
+  /*! @brief Constructor
+      @param[in] mesh  Mesh class than one can query for mesh info
+      @param[in] state A state manager class that one can query for field info
+      @param[in] stencils Quadfit stencils of the mesh, built here if empty
+
+      The field is set afterwards with set_interpolation_variable, so
+      that the stencils are built once for all the fields of the mesh.
+   */
+
+  Limited_Quadfit(MeshType const & mesh, StateType const & state,
+                  std::shared_ptr<QuadfitStencils<D>> stencils = nullptr)
+    : mesh_(mesh),
+      state_(state),
+      stencils_(stencils ? stencils : std::make_shared<QuadfitStencils<D>>()) {
+
+    assert(D == mesh_.space_dimension());
+    assert(D == 2 || D == 3);
+
+    // Collect the coordinates of each node and its neighbors once, as
+    // well as the dual cell vertices for the limiter, as it may be
+    // expensive to go to the mesh layer and collect this data for
+    // each node and each field during the actual quadfit calculation
+
+    if (stencils_->empty()) {
+      int nnodes = mesh_.num_entities(Entity_kind::NODE);
+      stencils_->build(nnodes, [this](int n, std::vector<int>* ids,
+                                      std::vector<Point<D>>* points,
+                                      std::vector<Point<D>>* vertices,
+                                      bool* boundary) {
+        std::vector<int> nbrids;
+        mesh_.dual_cell_get_node_adj_cells(n, Entity_type::ALL, &nbrids);
+        ids->resize(nbrids.size() + 1);
+        points->resize(nbrids.size() + 1);
+        (*ids)[0] = n;
+        std::copy(nbrids.begin(), nbrids.end(), ids->begin() + 1);
+        for (int i = 0; i < int(ids->size()); ++i)
+          mesh_.node_get_coordinates((*ids)[i], &((*points)[i]));
+        mesh_.dual_cell_get_coordinates(n, vertices);
+        *boundary = mesh_.on_exterior_boundary(Entity_kind::NODE, n);
+      });
+    }
+  }
+
   /*! @brief Constructor
       @param[in] mesh  Mesh class than one can query for mesh info
       @param[in] state A state manager class that one can query for field info
@@ -294,27 +566,30 @@ class Limited_Quadfit<D, Entity_kind::NODE, MeshType, StateType> {
                    std::string const var_name,
                    Limiter_type limiter_type, 
                    Boundary_Limiter_type Boundary_Limiter_type)
-    : mesh_(mesh),
-      state_(state),
-      var_name_(var_name),
-      limtype_(limiter_type),
-      bnd_limtype_(Boundary_Limiter_type) {
-
-    // Extract the field data from the statemanager
-    state.mesh_get_data(Entity_kind::NODE, var_name, &vals_);
+    : Limited_Quadfit(mesh, state) {
+    set_interpolation_variable(var_name, limiter_type, Boundary_Limiter_type);
+  }
 
-    // Collect and keep the list of neighbors for each NODE as it may
-    // be expensive to go to the mesh layer and collect this data for
-    // each cell during the actual quadfit calculation
+  /*! @brief Set the field for which the quadfit is to be computed
+      @param[in] var_name Name of field
+      @param[in] limiter_type An enum indicating if the limiter type (none, Barth-Jespersen, Superbee etc)
+      @param[in] Boundary_Limiter_type An enum indicating the limiter type on the boundary
+   */
 
-    int nnodes = mesh_.num_entities(Entity_kind::NODE);
-    node_neighbors_.resize(nnodes);
+  void set_interpolation_variable(std::string const & var_name,
+                                  Limiter_type limiter_type,
+                                  Boundary_Limiter_type Boundary_Limiter_type) {
+    var_name_ = var_name;
+    limtype_ = limiter_type;
+    bnd_limtype_ = Boundary_Limiter_type;
 
-    Wonton::for_each(mesh_.begin(Entity_kind::NODE), mesh_.end(Entity_kind::NODE),
-                      [this](int n) { mesh_.dual_cell_get_node_adj_cells(
-                             n, Entity_type::ALL, &(node_neighbors_[n])); } );
+    // Extract the field data from the statemanager
+    state_.mesh_get_data(Entity_kind::NODE, var_name, &vals_);
   }
 
+  /// Quadfit stencils of the mesh, to be shared with other instances
+  std::shared_ptr<QuadfitStencils<D>> const& stencils() const { return stencils_; }
+
   /// \todo Seems to be needed when using this in a Thrust transform call?
   //
   //  //! Copy constructor (deleted)
@@ -331,16 +606,16 @@ class Limited_Quadfit<D, Entity_kind::NODE, MeshType, StateType> {
 
   /// Functor
 
-  Vector<D*(D+3)/2> operator()(int nodeid);
+  Vector<D*(D+3)/2> operator()(int nodeid) const;
 
  private:
   MeshType const & mesh_;
   StateType const & state_;
+  std::shared_ptr<QuadfitStencils<D>> stencils_;
   std::string var_name_;
-  double const *vals_;
-  Limiter_type limtype_;
-  Boundary_Limiter_type bnd_limtype_;
-  std::vector<std::vector<int>> node_neighbors_;
+  double const *vals_ = nullptr;
+  Limiter_type limtype_ = NOLIMITER;
+  Boundary_Limiter_type bnd_limtype_ = BND_NOLIMITER;
 };
 
   /*! @brief Implementation of Limited_Quadfit functor for NODEs
@@ -348,43 +623,26 @@ class Limited_Quadfit<D, Entity_kind::NODE, MeshType, StateType> {
    *  multinomial using a Least-Squared fit. Returns an
    *  array of parameters.  If the MODE is on a boundary,
    *  the stencil is too small, so it drops to linear order.
-   *  Uses an SVD decomposition for the LS regression.
+   *  The fit is applied through the cached stencil weights.
    */
 
 
 template<int D, typename MeshType, typename StateType>
   Vector<D*(D+3)/2>
-Limited_Quadfit<D, Entity_kind::NODE, MeshType, StateType>::operator() (int const nodeid) {
+Limited_Quadfit<D, Entity_kind::NODE, MeshType, StateType>::operator() (int const nodeid) const {
 
-  assert(D == mesh_.space_dimension());
-  assert(D == 2 || D == 3);
+  constexpr int N = D*(D+3)/2;
   double phi = 1.0;
-  Vector<D*(D+3)/2> qfit;
-  Vector<D*(D+3)/2> dvec;
+  Vector<N> qfit;
 
-  bool boundary_node =  mesh_.on_exterior_boundary(Entity_kind::NODE, nodeid);
+  QuadfitStencils<D> const& stencils = *stencils_;
+  bool boundary_node = stencils.on_boundary(nodeid);
   if (bnd_limtype_ == BND_ZERO_GRADIENT && boundary_node) {
     qfit.zero();
     return qfit;
   }
 
-  std::vector<int> const & nbrids = node_neighbors_[nodeid];
-  std::vector<Point<D>> nodecoords(nbrids.size()+1);
-  std::vector<double> nodevalues(nbrids.size()+1);
-
-  Point<D> point;
-
-  mesh_.node_get_coordinates(nodeid, &(nodecoords[0]));
-  nodevalues[0] = vals_[nodeid];
-
-  int i = 1;
-  for (auto const & nbrnode : nbrids) {
-    mesh_.node_get_coordinates(nbrnode, &nodecoords[i]);
-    nodevalues[i] = vals_[nbrnode];
-    i++;
-  }
-
-  qfit = Wonton::ls_quadfit(nodecoords, nodevalues, boundary_node);
+  auto const fit = stencils.fit(nodeid, vals_);
 
   if (limtype_ == BARTH_JESPERSEN && 
       (!boundary_node || bnd_limtype_ == BND_BARTH_JESPERSEN)) {
@@ -394,7 +652,9 @@ Limited_Quadfit<D, Entity_kind::NODE, MeshType, StateType>::operator() (int cons
     double minval = vals_[nodeid];
     double maxval = vals_[nodeid];
 
-    for (auto const & val : nodevalues) {
+    std::vector<int> const& points = stencils.points();
+    for (int i = stencils.begin(nodeid); i < stencils.end(nodeid); ++i) {
+      double const val = vals_[points[i]];
       minval = std::min(val, minval);
       maxval = std::max(val, maxval);
     }
@@ -404,32 +664,14 @@ Limited_Quadfit<D, Entity_kind::NODE, MeshType, StateType>::operator() (int cons
     // the nodes of the cell. So find the values of the reconstructed
     // function at the nodes of the cell
 
-    double nodeval = vals_[nodeid];
-
-    std::vector<Point<D>> dualcellcoords;
-    mesh_.dual_cell_get_coordinates(nodeid, &dualcellcoords);
-
-    for (auto const & coord : dualcellcoords) {
-      Vector<D> vec = coord-nodecoords[0];
-      // Vector<D*(D+3)/2> dvec;
-	for (int j = 0; j < D; ++j) {
-	  dvec[j] = vec[j];
-	  // Add the quadratic terms
-	  for (int k = 0; k < j; ++k) {
-	    dvec[j+k+D-1] = dvec[k]*dvec[j];
-	  }
-	}
-
-      double diff = dot(qfit, dvec);
-      double extremeval = (diff > 0.0) ? maxval : minval;
-      double phi_new = (diff == 0.0) ? 1 : (extremeval-nodeval)/diff;
-      phi = std::min(phi_new, phi);
-    }
+    phi = stencils.limiter(nodeid, fit, vals_[nodeid], minval, maxval);
   }
 
   // Limited gradient is phi*qfit
 
-  return phi*qfit;
+  for (int k = 0; k < N; ++k)
+    qfit[k] = phi * fit[k];
+  return qfit;
 }
 
 }  // namespace Portage
@@ -0,0 +1,405 @@
+/*
+This file is part of the Ristra portage project.
+Please see the license file at the root of this repository, or at:
+    https://github.com/laristra/portage/blob/master/LICENSE
+*/
+
+#ifndef PORTAGE_INTERPOLATE_REMAP_OPERATOR_H_
+#define PORTAGE_INTERPOLATE_REMAP_OPERATOR_H_
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cmath>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+// wonton includes
+#include "wonton/support/wonton.h"
+
+// portage includes
+#include "portage/support/portage.h"
+#include "portage/support/bucket_sort.h"
+
+namespace Portage {
+
+/*!
+  @class RemapOperator remap_operator.h
+  @brief Sparse first order remap operator compiled from intersection weights.
+
+  The first order remap of a field is a linear map from source values
+  to target values: each target value is the average of the source
+  values weighted by the volumes of intersection. Once the weights of
+  a remap are known, that map can be stored as a sparse matrix in
+  compressed sparse row (CSR) format, where each row holds the source
+  entities and normalized weights of one target entity.
+
+  Applying the operator to a block of fields then amounts to a sparse
+  matrix - dense matrix product: the row structure is traversed once
+  per target entity and reused for every field of the block, instead
+  of walking the (scattered) weights lists once per field and per
+  target entity as Interpolate_1stOrder does.
+
+  The normalization and the volume tolerance are the ones used by
+  Interpolate_1stOrder, so that the result matches the first order
+  interpolator up to round-off for mesh fields.
+
+  The operator may also be applied source-major: the weights are then
+  transposed into a second CSR structure whose rows are the source
+  entities, and each source value is scattered into the targets it
+  contributes to. Sources are greedily colored so that two sources of a
+  same color never share a target, which lets each color be scattered
+  in parallel without any atomic update. This traversal reads every
+  source value once, which is preferable for source-driven updates and
+  diagnostics, and the transposed structure is available to callers.
+*/
+class RemapOperator {
+
+ public:
+
+  /// Order in which the weights are traversed when applying the operator.
+  enum class Traversal { TARGET_MAJOR, SOURCE_MAJOR };
+
+  /// Default constructor: empty operator.
+  RemapOperator() = default;
+
+  /*!
+    @brief Compile the operator from the intersection weights.
+    @param[in] sources_and_weights: source entities and their moments
+               for each target entity.
+    @param[in] num_tols: numerical tolerances, the intersection pieces
+               smaller than min_absolute_volume are discarded.
+    @param[in] traversal: order in which 'apply' traverses the weights.
+  */
+  RemapOperator(Wonton::vector<std::vector<Weights_t>> const& sources_and_weights,
+                NumericTolerances_t const& num_tols,
+                Traversal traversal = Traversal::TARGET_MAJOR) {
+    build(sources_and_weights, num_tols);
+    if (traversal == Traversal::SOURCE_MAJOR)
+      build_source_major();
+  }
+
+  /*!
+    @brief Compile the operator from the intersection weights.
+    @param[in] sources_and_weights: source entities and their moments
+               for each target entity.
+    @param[in] num_tols: numerical tolerances.
+  */
+  void build(Wonton::vector<std::vector<Weights_t>> const& sources_and_weights,
+             NumericTolerances_t const& num_tols) {
+
+    num_rows_ = sources_and_weights.size();
+    num_cols_ = 0;
+    offsets_.assign(num_rows_ + 1, 0);
+
+    // count the non-zero entries of each row
+    for (int t = 0; t < num_rows_; ++t) {
+      // nb: 'auto' may imply unexpected behavior with thrust enabled.
+      std::vector<Weights_t> const& row = sources_and_weights[t];
+      int count = 0;
+      for (auto const& entry : row)
+        if (std::fabs(entry.weights[0]) >= num_tols.min_absolute_volume)
+          count++;
+      offsets_[t + 1] = offsets_[t] + count;
+    }
+
+    int const nnz = offsets_[num_rows_];
+    columns_.resize(nnz);
+    values_.resize(nnz);
+
+    // fill and normalize rows independently
+    std::vector<int> rows(num_rows_);
+    std::iota(rows.begin(), rows.end(), 0);
+
+    Wonton::for_each(rows.begin(), rows.end(), [&](int t) {
+      std::vector<Weights_t> const& row = sources_and_weights[t];
+      int k = offsets_[t];
+      double volume = 0.;
+      for (auto const& entry : row) {
+        double const& weight = entry.weights[0];
+        if (std::fabs(weight) >= num_tols.min_absolute_volume) {
+          columns_[k] = entry.entityID;
+          values_[k] = weight;
+          volume += weight;
+          k++;
+        }
+      }
+      assert(k == offsets_[t + 1]);
+      if (volume != 0.) {
+        for (int j = offsets_[t]; j < k; ++j)
+          values_[j] /= volume;
+      }
+    });
+
+    for (int const& c : columns_)
+      num_cols_ = std::max(num_cols_, c + 1);
+
+    // invalidate any previous source-major structure
+    traversal_ = Traversal::TARGET_MAJOR;
+    source_offsets_.assign(1, 0);
+    source_rows_.clear();
+    source_values_.clear();
+    color_offsets_.assign(1, 0);
+    color_sources_.clear();
+  }
+
+  /*!
+    @brief Transpose the operator to apply it source-major.
+
+    The transposed weights are stored in CSR format by source entity.
+    They are bucketed in parallel by source, and since the weights are
+    stored in target order, the targets of each source remain sorted.
+    The sources are then greedily colored so that the sources of a same
+    color contribute to disjoint sets of targets.
+  */
+  void build_source_major() {
+
+    int const nnz = num_nonzeros();
+
+    // target row of each weight
+    std::vector<int> rows(num_rows_);
+    std::vector<int> row_of(nnz);
+    std::iota(rows.begin(), rows.end(), 0);
+
+    Wonton::for_each(rows.begin(), rows.end(), [&](int t) {
+      std::fill(row_of.begin() + offsets_[t], row_of.begin() + offsets_[t + 1], t);
+    });
+
+    // bucket the weights by source
+    auto source_of = [&](int j, int& first, int& last) {
+      first = columns_[j];
+      last = first + 1;
+    };
+
+    std::vector<int> order;
+    bucket_sort<int>(nnz, num_cols_, source_of, source_offsets_, order);
+
+    source_rows_.resize(nnz);
+    source_values_.resize(nnz);
+
+    std::vector<int> entries(nnz);
+    std::iota(entries.begin(), entries.end(), 0);
+
+    Wonton::for_each(entries.begin(), entries.end(), [&](int k) {
+      int const j = order[k];
+      source_rows_[k] = row_of[j];
+      source_values_[k] = values_[j];
+    });
+
+    // greedy coloring: each source takes the smallest color not taken by
+    // a source of lower index sharing a target with it. A source is
+    // colored as soon as all these neighbors are, so that the sources of
+    // each wave are colored in parallel with the same result as a serial
+    // pass by increasing index.
+    auto visit_neighbors = [&](int s, auto&& visit) {
+      for (int j = source_offsets_[s]; j < source_offsets_[s + 1]; ++j) {
+        int const t = source_rows_[j];
+        for (int i = offsets_[t]; i < offsets_[t + 1]; ++i)
+          if (columns_[i] != s)
+            visit(columns_[i]);
+      }
+    };
+
+    std::vector<int> colors(num_cols_, -1);
+    std::vector<std::atomic<int>> pending(num_cols_);
+    std::vector<int> wave(num_cols_), next_wave(num_cols_);
+    std::atomic<int> wave_size(0), next_wave_size(0);
+
+    std::vector<int> sources(num_cols_);
+    std::iota(sources.begin(), sources.end(), 0);
+
+    Wonton::for_each(sources.begin(), sources.end(), [&](int s) {
+      int count = 0;
+      visit_neighbors(s, [&](int u) { count += (u < s); });
+      pending[s].store(count, std::memory_order_relaxed);
+      if (count == 0 and source_offsets_[s] < source_offsets_[s + 1])
+        wave[wave_size.fetch_add(1, std::memory_order_relaxed)] = s;
+    });
+
+    while (wave_size > 0) {
+      auto const first = wave.begin();
+      auto const last = wave.begin() + wave_size.load();
+
+      Wonton::for_each(first, last, [&](int s) {
+        // mark the colors taken by the neighbors, then unmark them so
+        // that the per-thread markers are left clean for the next source.
+        static thread_local std::vector<char> taken;
+        auto mark = [&](char value) {
+          visit_neighbors(s, [&](int u) {
+            if (u < s) {
+              int const c = colors[u];
+              if (c >= static_cast<int>(taken.size()))
+                taken.resize(c + 1, 0);
+              taken[c] = value;
+            }
+          });
+        };
+
+        mark(1);
+        colors[s] = std::find(taken.begin(), taken.end(), 0) - taken.begin();
+        mark(0);
+
+        visit_neighbors(s, [&](int u) {
+          if (u > s and pending[u].fetch_sub(1, std::memory_order_acq_rel) == 1)
+            next_wave[next_wave_size.fetch_add(1, std::memory_order_relaxed)] = u;
+        });
+      });
+
+      wave.swap(next_wave);
+      wave_size.store(next_wave_size.load());
+      next_wave_size.store(0);
+    }
+
+    int const num_colors =
+      num_cols_ > 0 ? *std::max_element(colors.begin(), colors.end()) + 1 : 0;
+
+    // group the sources by color
+    auto color_of = [&](int s, int& first, int& last) {
+      first = colors[s];
+      last = first >= 0 ? first + 1 : first;
+    };
+
+    bucket_sort<int>(num_cols_, num_colors, color_of,
+                     color_offsets_, color_sources_);
+
+    traversal_ = Traversal::SOURCE_MAJOR;
+  }
+
+  /*!
+    @brief Apply the operator to a block of fields.
+    @param[in] source_fields: pointers to the source values of each field.
+    @param[out] target_fields: pointers to the target values of each field.
+    @param[in] num_fields: number of fields of the block.
+
+    Rows without any contribution are set to zero, as done by the
+    first order interpolator.
+  */
+  void apply(double const* const* source_fields,
+             double* const* target_fields, int num_fields) const {
+
+    if (num_fields <= 0)
+      return;
+
+    if (traversal_ == Traversal::SOURCE_MAJOR) {
+      scatter(source_fields, target_fields, num_fields);
+      return;
+    }
+
+    std::vector<int> rows(num_rows_);
+    std::iota(rows.begin(), rows.end(), 0);
+
+    Wonton::for_each(rows.begin(), rows.end(), [&](int t) {
+      int const begin = offsets_[t];
+      int const end = offsets_[t + 1];
+      for (int f = 0; f < num_fields; ++f) {
+        double const* x = source_fields[f];
+        double sum = 0.;
+        for (int j = begin; j < end; ++j)
+          sum += values_[j] * x[columns_[j]];
+        target_fields[f][t] = sum;
+      }
+    });
+  }
+
+  /*!
+    @brief Apply the operator to a block of fields packed column-major.
+    @param[in] source: source values, field 'f' starts at source + f * source_stride.
+    @param[in] source_stride: leading dimension of the source block.
+    @param[out] target: target values, field 'f' starts at target + f * target_stride.
+    @param[in] target_stride: leading dimension of the target block.
+    @param[in] num_fields: number of fields of the block.
+  */
+  void apply(double const* source, int source_stride,
+             double* target, int target_stride, int num_fields) const {
+
+    if (source_stride < num_cols_ or target_stride < num_rows_)
+      throw std::runtime_error("RemapOperator: block strides are too small");
+
+    std::vector<double const*> source_fields(num_fields);
+    std::vector<double*> target_fields(num_fields);
+    for (int f = 0; f < num_fields; ++f) {
+      source_fields[f] = source + f * source_stride;
+      target_fields[f] = target + f * target_stride;
+    }
+    apply(source_fields.data(), target_fields.data(), num_fields);
+  }
+
+  /// Order in which the weights are traversed by 'apply'.
+  Traversal traversal() const { return traversal_; }
+
+  /// Number of target entities.
+  int num_rows() const { return num_rows_; }
+
+  /// Minimum number of source entities the fields should span.
+  int num_cols() const { return num_cols_; }
+
+  /// Number of stored weights.
+  int num_nonzeros() const { return offsets_.empty() ? 0 : offsets_.back(); }
+
+  /// Row offsets, columns and values of the compressed storage.
+  std::vector<int> const& offsets() const { return offsets_; }
+  std::vector<int> const& columns() const { return columns_; }
+  std::vector<double> const& values() const { return values_; }
+
+  /// Source offsets, target rows and values of the transposed storage.
+  std::vector<int> const& source_offsets() const { return source_offsets_; }
+  std::vector<int> const& source_rows() const { return source_rows_; }
+  std::vector<double> const& source_values() const { return source_values_; }
+
+  /// Number of colors of the sources for the source-major traversal.
+  int num_colors() const { return static_cast<int>(color_offsets_.size()) - 1; }
+
+ private:
+
+  /*!
+    @brief Source-major application of the operator.
+    @param[in] source_fields: pointers to the source values of each field.
+    @param[out] target_fields: pointers to the target values of each field.
+    @param[in] num_fields: number of fields of the block.
+
+    Targets are reset then each source adds its contributions. Colors
+    are processed one after the other and the sources of a color in
+    parallel, since they never write to a same target.
+  */
+  void scatter(double const* const* source_fields,
+               double* const* target_fields, int num_fields) const {
+
+    for (int f = 0; f < num_fields; ++f)
+      std::fill(target_fields[f], target_fields[f] + num_rows_, 0.);
+
+    int const num_colors = this->num_colors();
+    for (int c = 0; c < num_colors; ++c) {
+      auto const first = color_sources_.begin() + color_offsets_[c];
+      auto const last = color_sources_.begin() + color_offsets_[c + 1];
+
+      Wonton::for_each(first, last, [&](int s) {
+        int const begin = source_offsets_[s];
+        int const end = source_offsets_[s + 1];
+        for (int f = 0; f < num_fields; ++f) {
+          double const x = source_fields[f][s];
+          double* y = target_fields[f];
+          for (int j = begin; j < end; ++j)
+            y[source_rows_[j]] += source_values_[j] * x;
+        }
+      });
+    }
+  }
+
+  int num_rows_ = 0;
+  int num_cols_ = 0;
+  std::vector<int> offsets_ {0};
+  std::vector<int> columns_ {};
+  std::vector<double> values_ {};
+
+  Traversal traversal_ = Traversal::TARGET_MAJOR;
+  std::vector<int> source_offsets_ {0};
+  std::vector<int> source_rows_ {};
+  std::vector<double> source_values_ {};
+  std::vector<int> color_offsets_ {0};
+  std::vector<int> color_sources_ {};
+};
+
+}  // namespace Portage
+
+#endif  // PORTAGE_INTERPOLATE_REMAP_OPERATOR_H_
@@ -0,0 +1,158 @@
+/*
+This file is part of the Ristra portage project.
+Please see the license file at the root of this repository, or at:
+    https://github.com/laristra/portage/blob/master/LICENSE
+*/
+
+#include <cmath>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+// wonton includes
+#include "wonton/support/wonton.h"
+#include "wonton/support/Point.h"
+#include "wonton/mesh/simple/simple_mesh.h"
+#include "wonton/mesh/simple/simple_mesh_wrapper.h"
+#include "wonton/state/simple/simple_state.h"
+#include "wonton/state/simple/simple_state_wrapper.h"
+
+// portage includes
+#include "portage/interpolate/compressed_weights.h"
+#include "portage/interpolate/interpolate_2nd_order.h"
+#include "portage/intersect/simple_intersect_for_tests.h"
+#include "portage/support/portage.h"
+#include "portage/driver/coredriver.h"
+
+/// Second order remap of a linear field with single precision weights
+/// and gradients, compared to the double precision remap
+
+TEST(CompressedWeights, Cell_Linear_2D) {
+
+  auto source_mesh = std::make_shared<Wonton::Simple_Mesh>(1.0, 1.0, 2.0, 2.0, 10, 10);
+  auto target_mesh = std::make_shared<Wonton::Simple_Mesh>(1.0, 1.0, 2.0, 2.0, 7, 9);
+
+  Wonton::Simple_Mesh_Wrapper source_mesh_wrapper(*source_mesh);
+  Wonton::Simple_Mesh_Wrapper target_mesh_wrapper(*target_mesh);
+
+  int const ncells_source = source_mesh_wrapper.num_owned_cells();
+  int const ncells_target = target_mesh_wrapper.num_owned_cells();
+
+  std::vector<double> data(ncells_source);
+  for (int c = 0; c < ncells_source; ++c) {
+    Wonton::Point<2> centroid;
+    source_mesh_wrapper.cell_centroid(c, &centroid);
+    data[c] = centroid[0] + 2 * centroid[1];
+  }
+
+  Wonton::Simple_State source_state(source_mesh);
+  Wonton::Simple_State target_state(target_mesh);
+  source_state.add("cellvars", Wonton::Entity_kind::CELL, data.data());
+
+  std::vector<double> remapped(ncells_target, 0.);
+  target_state.add("cellvars", Wonton::Entity_kind::CELL, remapped.data());
+
+  Wonton::Simple_State_Wrapper source_state_wrapper(source_state);
+  Wonton::Simple_State_Wrapper target_state_wrapper(target_state);
+
+  // compute intersection weights independently
+  std::vector<std::vector<Wonton::Point<2>>> source_coords(ncells_source);
+  std::vector<std::vector<Wonton::Point<2>>> target_coords(ncells_target);
+
+  for (int c = 0; c < ncells_source; ++c)
+    source_mesh_wrapper.cell_get_coordinates(c, &(source_coords[c]));
+  for (int c = 0; c < ncells_target; ++c)
+    target_mesh_wrapper.cell_get_coordinates(c, &(target_coords[c]));
+
+  Wonton::vector<std::vector<Portage::Weights_t>> sources_and_weights(ncells_target);
+
+  for (int c = 0; c < ncells_target; ++c) {
+    std::vector<int> xcells;
+    std::vector<std::vector<double>> xwts;
+    BOX_INTERSECT::intersection_moments<2>(target_coords[c], source_coords,
+                                           &xcells, &xwts);
+
+    int const num_intersect_cells = xcells.size();
+    std::vector<Portage::Weights_t> wtsvec(num_intersect_cells);
+    for (int i = 0; i < num_intersect_cells; ++i) {
+      wtsvec[i].entityID = xcells[i];
+      wtsvec[i].weights = xwts[i];
+    }
+    sources_and_weights[c] = wtsvec;
+  }
+
+  using Driver = Portage::CoreDriver<2, Wonton::Entity_kind::CELL,
+                                     Wonton::Simple_Mesh_Wrapper,
+                                     Wonton::Simple_State_Wrapper>;
+
+  Driver driver(source_mesh_wrapper, source_state_wrapper,
+                target_mesh_wrapper, target_state_wrapper);
+
+  // compress the weights and report the loss of accuracy
+  auto const weights = driver.compress_weights(sources_and_weights);
+  ASSERT_EQ(ncells_target, weights.size());
+
+  auto const report = weights.conservation_error(sources_and_weights);
+
+  ASSERT_LT(report.max_volume_error, 1.e-6);
+  ASSERT_LT(report.total_volume_error, 1.e-6);
+  ASSERT_LT(report.max_centroid_error, 1.e-6);
+
+  // rows expand the moments back in double precision
+  for (int c = 0; c < ncells_target; ++c) {
+    auto const row = weights[c];
+    std::vector<Portage::Weights_t> const& list = sources_and_weights[c];
+    ASSERT_EQ(static_cast<int>(list.size()), row.size());
+    int i = 0;
+    for (auto const& piece : row) {
+      ASSERT_EQ(list[i].entityID, piece.entityID);
+      for (int k = 0; k < 3; ++k)
+        ASSERT_NEAR(list[i].weights[k], piece.weights[k], 1.e-6);
+      i++;
+    }
+  }
+
+  // double precision remap
+  auto gradients = driver.compute_source_gradient("cellvars");
+  std::vector<double> expected(ncells_target);
+
+  Portage::Interpolate_2ndOrder<2, Wonton::Entity_kind::CELL,
+                                Wonton::Simple_Mesh_Wrapper,
+                                Wonton::Simple_Mesh_Wrapper,
+                                Wonton::Simple_State_Wrapper,
+                                Wonton::Simple_State_Wrapper,
+                                double>
+    interpolator(source_mesh_wrapper, target_mesh_wrapper,
+                 source_state_wrapper, Portage::DEFAULT_NUMERIC_TOLERANCES<2>);
+  interpolator.set_interpolation_variable("cellvars", &gradients);
+
+  for (int c = 0; c < ncells_target; ++c)
+    expected[c] = interpolator(c, sources_and_weights[c]);
+
+  // single precision storage, double precision accumulation
+  Portage::CompressedGradients<2> compressed_gradients(gradients);
+  ASSERT_EQ(ncells_source, compressed_gradients.size());
+
+  driver.interpolate_mesh_var<double, Portage::Interpolate_2ndOrder>(
+    "cellvars", "cellvars", weights, &compressed_gradients);
+
+  double source_integral = 0.;
+  double target_integral = 0.;
+  for (int c = 0; c < ncells_source; ++c)
+    source_integral += data[c] * source_mesh_wrapper.cell_volume(c);
+
+  for (int c = 0; c < ncells_target; ++c) {
+    Wonton::Point<2> centroid;
+    target_mesh_wrapper.cell_centroid(c, &centroid);
+    ASSERT_NEAR(expected[c], remapped[c], 1.e-5);
+    ASSERT_NEAR(centroid[0] + 2 * centroid[1], remapped[c], 1.e-5);
+    target_integral += remapped[c] * target_mesh_wrapper.cell_volume(c);
+  }
+
+  double const conservation_error =
+    std::fabs(target_integral - source_integral) / std::fabs(source_integral);
+  ASSERT_LT(conservation_error, 1.e-6);
+
+  // mismatch check accepts the compressed weights
+  ASSERT_FALSE(driver.check_mismatch(weights));
+}
@@ -5,6 +5,7 @@ Please see the license file at the root of this repository, or at:
 */
 
 
+#include <algorithm>
 #include <iostream>
 
 #include "gtest/gtest.h"
@@ -20,6 +21,7 @@ Please see the license file at the root of this repository, or at:
 // portage includes
 #include "portage/interpolate/interpolate_3rd_order.h"
 #include "portage/intersect/simple_intersect_for_tests.h"
+#include "portage/intersect/intersect_rNd.h"
 #include "portage/support/portage.h"
 
 double TOL = 1e-12;   // tolerance for constant and linear fits.
@@ -744,6 +746,112 @@ TEST(Interpolate_3rd_Order, Cell_Ctr_Quad_BJ_Limiter_2D) {
 /// Third order interpolation of constant node-centered field with no
 /// limiting in 2D
 
+/*!
+  @brief Third order interpolate of quadratic cell-centered field using the
+  second moments of the intersections in 2D. The quadratic fit is then
+  integrated exactly over each intersection, whereas it is only evaluated
+  at their centroids with first moments.
+*/
+
+TEST(Interpolate_3rd_Order, Cell_Ctr_Quad_Second_Moments_2D) {
+
+  // target cells only overlap source cells with a full stencil
+  std::shared_ptr<Wonton::Simple_Mesh> source_mesh =
+    std::make_shared<Wonton::Simple_Mesh>(0.0, 0.0, 1.0, 1.0, 8, 8);
+  std::shared_ptr<Wonton::Simple_Mesh> target_mesh =
+    std::make_shared<Wonton::Simple_Mesh>(0.25, 0.25, 0.75, 0.75, 5, 5);
+
+  Wonton::Simple_Mesh_Wrapper sourceMeshWrapper(*source_mesh);
+  Wonton::Simple_Mesh_Wrapper targetMeshWrapper(*target_mesh);
+
+  const int ncells_source = sourceMeshWrapper.num_owned_cells();
+  const int ncells_target = targetMeshWrapper.num_owned_cells();
+
+  // quadratic field sampled at source cell centroids
+  auto field = [](Wonton::Point<2> const& p) {
+    return p[0]*p[0] + p[0]*p[1] + p[1]*p[1];
+  };
+
+  Wonton::Simple_State source_state(source_mesh);
+  std::vector<double> data(ncells_source);
+  for (int c = 0; c < ncells_source; ++c) {
+    Wonton::Point<2> cen;
+    sourceMeshWrapper.cell_centroid(c, &cen);
+    data[c] = field(cen);
+  }
+  source_state.add("cellvars", Portage::Entity_kind::CELL, &(data[0]));
+  Wonton::Simple_State_Wrapper sourceStateWrapper(source_state);
+
+  Portage::NumericTolerances_t num_tols = Portage::DEFAULT_NUMERIC_TOLERANCES<2>;
+
+  Portage::IntersectRnDSecondMoments<2, Portage::Entity_kind::CELL,
+                                     Wonton::Simple_Mesh_Wrapper,
+                                     Wonton::Simple_State_Wrapper,
+                                     Wonton::Simple_Mesh_Wrapper>
+      intersect(sourceMeshWrapper, sourceStateWrapper, targetMeshWrapper, num_tols);
+
+  // intersect each target cell with all source cells, and keep
+  // the first moments only for the centroid-based path.
+  std::vector<int> candidates(ncells_source);
+  for (int c = 0; c < ncells_source; ++c)
+    candidates[c] = c;
+
+  std::vector<std::vector<Portage::Weights_t>> second_moments(ncells_target);
+  std::vector<std::vector<Portage::Weights_t>> first_moments(ncells_target);
+
+  for (int c = 0; c < ncells_target; ++c) {
+    second_moments[c] = intersect(c, candidates);
+    ASSERT_FALSE(second_moments[c].empty());
+    for (auto const& entry : second_moments[c]) {
+      ASSERT_EQ(unsigned(6), entry.weights.size());
+      std::vector<double> const moments(entry.weights.begin(), entry.weights.begin() + 3);
+      first_moments[c].emplace_back(entry.entityID, moments);
+    }
+  }
+
+  Portage::Interpolate_3rdOrder<2, Portage::Entity_kind::CELL,
+                                Wonton::Simple_Mesh_Wrapper,
+                                Wonton::Simple_Mesh_Wrapper,
+                                Wonton::Simple_State_Wrapper>
+      interpolator(sourceMeshWrapper, targetMeshWrapper, sourceStateWrapper,
+                   num_tols);
+
+  interpolator.set_interpolation_variable("cellvars");
+
+  std::vector<double> exact_vals(ncells_target);
+  std::vector<double> centroid_vals(ncells_target);
+
+  Wonton::transform(targetMeshWrapper.begin(Portage::Entity_kind::CELL),
+                    targetMeshWrapper.end(Portage::Entity_kind::CELL),
+                    second_moments.begin(), exact_vals.begin(), interpolator);
+
+  Wonton::transform(targetMeshWrapper.begin(Portage::Entity_kind::CELL),
+                    targetMeshWrapper.end(Portage::Entity_kind::CELL),
+                    first_moments.begin(), centroid_vals.begin(), interpolator);
+
+  for (int c = 0; c < ncells_target; ++c) {
+    // mean value of the field over the target cell
+    std::vector<Wonton::Point<2>> coords;
+    targetMeshWrapper.cell_get_coordinates(c, &coords);
+    double x0 = coords[0][0], x1 = x0, y0 = coords[0][1], y1 = y0;
+    for (auto const& p : coords) {
+      x0 = std::min(x0, p[0]);
+      x1 = std::max(x1, p[0]);
+      y0 = std::min(y0, p[1]);
+      y1 = std::max(y1, p[1]);
+    }
+
+    double const mean = (x0*x0 + x0*x1 + x1*x1) / 3.
+                      + 0.25 * (x0 + x1) * (y0 + y1)
+                      + (y0*y0 + y0*y1 + y1*y1) / 3.;
+
+    ASSERT_NEAR(mean, exact_vals[c], TOL);
+    // quadratic terms at centroids: error bounded by the intersection variance
+    ASSERT_NEAR(exact_vals[c], centroid_vals[c], 5.e-3);
+  }
+}
+
+
 TEST(Interpolate_3rd_Order, Node_Ctr_Const_BND_NOLIMITER) {
 
   // Create simple meshes
@@ -0,0 +1,152 @@
+/*
+This file is part of the Ristra portage project.
+Please see the license file at the root of this repository, or at:
+    https://github.com/laristra/portage/blob/master/LICENSE
+*/
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+// wonton includes
+#include "wonton/support/wonton.h"
+#include "wonton/support/Point.h"
+#include "wonton/support/Vector.h"
+
+// portage includes
+#include "portage/interpolate/interpolate_1st_order.h"
+#include "portage/interpolate/interpolate_2nd_order.h"
+#include "portage/support/portage.h"
+
+/*
+  Micro-benchmark of the interpolation functors: count the heap
+  allocations done while remapping values, which should be none since
+  the functors only read the intersection moments in place.
+*/
+
+namespace {
+
+std::atomic<long> num_allocations(0);
+
+/*
+  Minimal mesh and state wrappers over precomputed data, so that only
+  the interpolation functors themselves are measured.
+*/
+struct Mesh_Stub {
+  std::vector<Wonton::Point<2>> centroids;
+
+  void cell_centroid(int c, Wonton::Point<2>* centroid) const {
+    *centroid = centroids[c];
+  }
+};
+
+struct State_Stub {
+  std::vector<double> values;
+
+  Portage::Field_type field_type(Wonton::Entity_kind, std::string const&) const {
+    return Portage::Field_type::MESH_FIELD;
+  }
+  void mesh_get_data(Wonton::Entity_kind, std::string const&, double const** data) const {
+    *data = values.data();
+  }
+  void mat_get_celldata(std::string const&, int, double const** data) const {
+    *data = values.data();
+  }
+  int cell_index_in_material(int c, int) const { return c; }
+  int cell_get_num_mats(int) const { return 0; }
+  void cell_get_mats(int, std::vector<int>* mats) const { mats->clear(); }
+};
+
+}  // namespace
+
+void* operator new(std::size_t size) {
+  num_allocations++;
+  if (void* ptr = std::malloc(size ? size : 1))
+    return ptr;
+  throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+
+class InterpolateAllocations : public testing::Test {
+ protected:
+  InterpolateAllocations() {
+    // n x n unit source cells, each unit target cell is centered on
+    // a source node and overlaps a quarter of its 4 neighbor cells
+    int const n = 64;
+    for (int j = 0; j < n; ++j)
+      for (int i = 0; i < n; ++i) {
+        source_mesh.centroids.emplace_back(i + 0.5, j + 0.5);
+        source_state.values.push_back(i + 2. * j);
+        gradients.emplace_back(1., 2.);
+      }
+
+    for (int j = 0; j < n - 1; ++j)
+      for (int i = 0; i < n - 1; ++i) {
+        std::vector<Portage::Weights_t> list;
+        for (int dj = 0; dj < 2; ++dj)
+          for (int di = 0; di < 2; ++di) {
+            double const x = i + 0.75 + 0.5 * di;
+            double const y = j + 0.75 + 0.5 * dj;
+            list.emplace_back((j + dj) * n + i + di,
+                              std::vector<double>{0.25, 0.25 * x, 0.25 * y});
+          }
+        sources_and_weights.push_back(list);
+      }
+  }
+
+  // remap all values and return the number of allocations per value
+  template<typename Interpolator>
+  double remap(Interpolator const& interpolator, std::string const& name) {
+    int const nb_targets = sources_and_weights.size();
+    std::vector<double> result(nb_targets);
+
+    long const start = num_allocations;
+    auto const tic = std::chrono::steady_clock::now();
+    for (int t = 0; t < nb_targets; ++t)
+      result[t] = interpolator(t, sources_and_weights[t]);
+    auto const toc = std::chrono::steady_clock::now();
+    long const count = num_allocations - start;
+
+    double const elapsed =
+      std::chrono::duration<double, std::nano>(toc - tic).count();
+    std::cout << name << ": " << double(count) / nb_targets
+              << " allocations and " << elapsed / nb_targets
+              << " ns per remapped value" << std::endl;
+    return double(count) / nb_targets;
+  }
+
+  Mesh_Stub source_mesh;
+  Mesh_Stub target_mesh;
+  State_Stub source_state;
+  Wonton::vector<Wonton::Vector<2>> gradients;
+  std::vector<std::vector<Portage::Weights_t>> sources_and_weights;
+  Portage::NumericTolerances_t num_tols = Portage::DEFAULT_NUMERIC_TOLERANCES<2>;
+};
+
+TEST_F(InterpolateAllocations, FirstOrder) {
+  Portage::Interpolate_1stOrder<2, Wonton::Entity_kind::CELL,
+                                Mesh_Stub, Mesh_Stub,
+                                State_Stub, State_Stub, double>
+    interpolator(source_mesh, target_mesh, source_state, num_tols);
+  interpolator.set_interpolation_variable("field");
+
+  ASSERT_EQ(remap(interpolator, "1st order"), 0.);
+}
+
+TEST_F(InterpolateAllocations, SecondOrder) {
+  Portage::Interpolate_2ndOrder<2, Wonton::Entity_kind::CELL,
+                                Mesh_Stub, Mesh_Stub,
+                                State_Stub, State_Stub, double>
+    interpolator(source_mesh, target_mesh, source_state, num_tols);
+  interpolator.set_interpolation_variable("field", &gradients);
+
+  ASSERT_EQ(remap(interpolator, "2nd order"), 0.);
+}
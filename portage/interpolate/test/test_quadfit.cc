@@ -396,3 +396,68 @@ TEST(Quadfit, Fields_Node_Ctr) {
     }
   }
 }
+
+/// Test that quadfit stencils built once are reused for several fields
+
+TEST(Quadfit, Shared_Stencils) {
+
+  std::shared_ptr<Wonton::Simple_Mesh> mesh1 =
+      std::make_shared<Wonton::Simple_Mesh>(0.0, 0.0, 1.0, 1.0, 5, 5);
+  Wonton::Simple_Mesh_Wrapper meshWrapper(*mesh1);
+  Wonton::Simple_State mystate(mesh1);
+  Wonton::Simple_State_Wrapper stateWrapper(mystate);
+
+  const int nc1 = meshWrapper.num_owned_cells();
+
+  // a linear field x+2y and a quadratic field x*x+y*y
+  std::vector<double> data1(nc1), data2(nc1);
+  for (int c = 0; c < nc1; c++) {
+    Wonton::Point<2> ccen;
+    meshWrapper.cell_centroid(c, &ccen);
+    data1[c] = ccen[0] + 2 * ccen[1];
+    data2[c] = ccen[0]*ccen[0] + ccen[1]*ccen[1];
+  }
+  mystate.add("cellvars1", Portage::Entity_kind::CELL, &(data1[0]));
+  mystate.add("cellvars2", Portage::Entity_kind::CELL, &(data2[0]));
+
+  using Quadfit = Portage::Limited_Quadfit<2, Portage::Entity_kind::CELL,
+                                           Wonton::Simple_Mesh_Wrapper,
+                                           Wonton::Simple_State_Wrapper>;
+
+  // stencils built by a first instance and handed to a second one
+  Quadfit shared1(meshWrapper, stateWrapper);
+  Quadfit shared2(meshWrapper, stateWrapper, shared1.stencils());
+  ASSERT_EQ(shared1.stencils(), shared2.stencils());
+  ASSERT_FALSE(shared1.stencils()->empty());
+
+  shared1.set_interpolation_variable("cellvars1", Portage::BARTH_JESPERSEN,
+                                     Portage::BND_NOLIMITER);
+  shared2.set_interpolation_variable("cellvars2", Portage::BARTH_JESPERSEN,
+                                     Portage::BND_NOLIMITER);
+
+  Quadfit qfitcalc1(meshWrapper, stateWrapper, "cellvars1",
+                    Portage::BARTH_JESPERSEN, Portage::BND_NOLIMITER);
+  Quadfit qfitcalc2(meshWrapper, stateWrapper, "cellvars2",
+                    Portage::BARTH_JESPERSEN, Portage::BND_NOLIMITER);
+
+  for (int c = 0; c < nc1; ++c) {
+    Wonton::Vector<5> expected1 = qfitcalc1(c);
+    Wonton::Vector<5> expected2 = qfitcalc2(c);
+    Wonton::Vector<5> qfit1 = shared1(c);
+    Wonton::Vector<5> qfit2 = shared2(c);
+    for (int k = 0; k < 5; ++k) {
+      ASSERT_DOUBLE_EQ(expected1[k], qfit1[k]);
+      ASSERT_DOUBLE_EQ(expected2[k], qfit2[k]);
+    }
+  }
+
+  // the same instance can be switched to another field
+  shared1.set_interpolation_variable("cellvars2", Portage::BARTH_JESPERSEN,
+                                     Portage::BND_NOLIMITER);
+  for (int c = 0; c < nc1; ++c) {
+    Wonton::Vector<5> expected = qfitcalc2(c);
+    Wonton::Vector<5> qfit = shared1(c);
+    for (int k = 0; k < 5; ++k)
+      ASSERT_DOUBLE_EQ(expected[k], qfit[k]);
+  }
+}
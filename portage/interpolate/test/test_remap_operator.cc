@@ -0,0 +1,210 @@
+/*
+This file is part of the Ristra portage project.
+Please see the license file at the root of this repository, or at:
+    https://github.com/laristra/portage/blob/master/LICENSE
+*/
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+// wonton includes
+#include "wonton/support/wonton.h"
+#include "wonton/support/Point.h"
+#include "wonton/mesh/simple/simple_mesh.h"
+#include "wonton/mesh/simple/simple_mesh_wrapper.h"
+#include "wonton/state/simple/simple_state.h"
+#include "wonton/state/simple/simple_state_wrapper.h"
+
+// portage includes
+#include "portage/interpolate/interpolate_1st_order.h"
+#include "portage/interpolate/remap_operator.h"
+#include "portage/intersect/simple_intersect_for_tests.h"
+#include "portage/support/portage.h"
+
+/// Compiled first order operator applied to a block of fields in 2D
+
+TEST(RemapOperator, Cell_Block_2D) {
+
+  auto source_mesh = std::make_shared<Wonton::Simple_Mesh>(0.0, 0.0, 1.0, 1.0, 4, 4);
+  auto target_mesh = std::make_shared<Wonton::Simple_Mesh>(0.0, 0.0, 1.0, 1.0, 3, 5);
+
+  Wonton::Simple_Mesh_Wrapper source_mesh_wrapper(*source_mesh);
+  Wonton::Simple_Mesh_Wrapper target_mesh_wrapper(*target_mesh);
+
+  int const ncells_source = source_mesh_wrapper.num_owned_cells();
+  int const ncells_target = target_mesh_wrapper.num_owned_cells();
+  int const nfields = 3;
+
+  // fields packed column-major: constant, linear and quadratic
+  std::vector<double> source_block(nfields * ncells_source);
+  for (int c = 0; c < ncells_source; ++c) {
+    Wonton::Point<2> centroid;
+    source_mesh_wrapper.cell_centroid(c, &centroid);
+    source_block[c] = 1.25;
+    source_block[ncells_source + c] = centroid[0] + 2 * centroid[1];
+    source_block[2 * ncells_source + c] = centroid[0] * centroid[1];
+  }
+
+  Wonton::Simple_State source_state(source_mesh);
+  source_state.add("f0", Wonton::Entity_kind::CELL, source_block.data());
+  source_state.add("f1", Wonton::Entity_kind::CELL, source_block.data() + ncells_source);
+  source_state.add("f2", Wonton::Entity_kind::CELL, source_block.data() + 2 * ncells_source);
+  Wonton::Simple_State_Wrapper source_state_wrapper(source_state);
+
+  // compute intersection weights independently
+  std::vector<std::vector<Wonton::Point<2>>> source_coords(ncells_source);
+  std::vector<std::vector<Wonton::Point<2>>> target_coords(ncells_target);
+
+  for (int c = 0; c < ncells_source; ++c)
+    source_mesh_wrapper.cell_get_coordinates(c, &(source_coords[c]));
+  for (int c = 0; c < ncells_target; ++c)
+    target_mesh_wrapper.cell_get_coordinates(c, &(target_coords[c]));
+
+  Wonton::vector<std::vector<Portage::Weights_t>> sources_and_weights(ncells_target);
+
+  for (int c = 0; c < ncells_target; ++c) {
+    std::vector<int> xcells;
+    std::vector<std::vector<double>> xwts;
+    BOX_INTERSECT::intersection_moments<2>(target_coords[c], source_coords,
+                                           &xcells, &xwts);
+
+    int const num_intersect_cells = xcells.size();
+    std::vector<Portage::Weights_t> wtsvec(num_intersect_cells);
+    for (int i = 0; i < num_intersect_cells; ++i) {
+      wtsvec[i].entityID = xcells[i];
+      wtsvec[i].weights = xwts[i];
+    }
+    sources_and_weights[c] = wtsvec;
+  }
+
+  Portage::NumericTolerances_t num_tols = Portage::DEFAULT_NUMERIC_TOLERANCES<2>;
+
+  Portage::RemapOperator remap_op(sources_and_weights, num_tols);
+  ASSERT_EQ(remap_op.num_rows(), ncells_target);
+  ASSERT_EQ(remap_op.num_cols(), ncells_source);
+
+  std::vector<double> target_block(nfields * ncells_target, -1.);
+  remap_op.apply(source_block.data(), ncells_source,
+                 target_block.data(), ncells_target, nfields);
+
+  // compare to the first order interpolator, field by field
+  Portage::Interpolate_1stOrder<2, Wonton::Entity_kind::CELL,
+                                Wonton::Simple_Mesh_Wrapper,
+                                Wonton::Simple_Mesh_Wrapper,
+                                Wonton::Simple_State_Wrapper,
+                                Wonton::Simple_State_Wrapper,
+                                double>
+    interpolator(source_mesh_wrapper, target_mesh_wrapper,
+                 source_state_wrapper, num_tols);
+
+  std::string const names[] = {"f0", "f1", "f2"};
+  for (int f = 0; f < nfields; ++f) {
+    interpolator.set_interpolation_variable(names[f]);
+    for (int c = 0; c < ncells_target; ++c) {
+      double const expected = interpolator(c, sources_and_weights[c]);
+      ASSERT_NEAR(expected, target_block[f * ncells_target + c], 1.e-12);
+    }
+  }
+
+  // constant field is preserved
+  for (int c = 0; c < ncells_target; ++c)
+    ASSERT_NEAR(1.25, target_block[c], 1.e-12);
+}
+
+/// Target entities without any contribution are set to zero
+
+TEST(RemapOperator, Empty_Rows) {
+
+  Wonton::vector<std::vector<Portage::Weights_t>> sources_and_weights(3);
+  sources_and_weights[0] = { Portage::Weights_t(0, {0.25}),
+                             Portage::Weights_t(1, {0.75}) };
+  sources_and_weights[2] = { Portage::Weights_t(1, {1.e-20}) };
+
+  Portage::RemapOperator remap_op(sources_and_weights,
+                                  Portage::DEFAULT_NUMERIC_TOLERANCES<2>);
+  ASSERT_EQ(remap_op.num_nonzeros(), 2);
+
+  std::vector<double> source = {2., 6.};
+  std::vector<double> target(3, -1.);
+  double const* source_fields[] = {source.data()};
+  double* target_fields[] = {target.data()};
+  remap_op.apply(source_fields, target_fields, 1);
+
+  ASSERT_NEAR(5., target[0], 1.e-12);
+  ASSERT_DOUBLE_EQ(0., target[1]);
+  ASSERT_DOUBLE_EQ(0., target[2]);
+}
+
+/// Source-major application matches the target-major one
+
+TEST(RemapOperator, Source_Major) {
+
+  // each target is centered on a node of the n x n source grid and
+  // overlaps a quarter of its (up to 4) neighbor cells
+  int const n = 128;
+  int const nb_sources = n * n;
+  int const nb_targets = (n + 1) * (n + 1);
+
+  Wonton::vector<std::vector<Portage::Weights_t>> sources_and_weights(nb_targets);
+  for (int j = 0; j <= n; ++j)
+    for (int i = 0; i <= n; ++i) {
+      std::vector<Portage::Weights_t> list;
+      for (int dj = -1; dj <= 0; ++dj)
+        for (int di = -1; di <= 0; ++di) {
+          int const si = i + di;
+          int const sj = j + dj;
+          if (si >= 0 and si < n and sj >= 0 and sj < n)
+            list.emplace_back(sj * n + si, std::vector<double>{0.25});
+        }
+      sources_and_weights[j * (n + 1) + i] = list;
+    }
+
+  auto const num_tols = Portage::DEFAULT_NUMERIC_TOLERANCES<2>;
+  using Traversal = Portage::RemapOperator::Traversal;
+
+  Portage::RemapOperator target_major(sources_and_weights, num_tols);
+  Portage::RemapOperator source_major(sources_and_weights, num_tols,
+                                      Traversal::SOURCE_MAJOR);
+
+  ASSERT_EQ(Traversal::TARGET_MAJOR, target_major.traversal());
+  ASSERT_EQ(Traversal::SOURCE_MAJOR, source_major.traversal());
+  ASSERT_EQ(nb_sources, source_major.num_cols());
+  ASSERT_EQ(target_major.num_nonzeros(),
+            static_cast<int>(source_major.source_rows().size()));
+
+  // a source shares targets with its 8 neighbors: 4 colors suffice
+  ASSERT_EQ(4, source_major.num_colors());
+
+  int const nfields = 4;
+  std::vector<double> source_block(nfields * nb_sources);
+  for (int f = 0; f < nfields; ++f)
+    for (int s = 0; s < nb_sources; ++s)
+      source_block[f * nb_sources + s] = (f + 1) * (s % n) + 0.5 * (s / n);
+
+  std::vector<double> expected(nfields * nb_targets, -1.);
+  std::vector<double> result(nfields * nb_targets, -1.);
+
+  // remap the block several times and report the time per target value
+  auto remap = [&](Portage::RemapOperator const& op,
+                   std::vector<double>& target, std::string const& name) {
+    int const repeat = 20;
+    auto const tic = std::chrono::steady_clock::now();
+    for (int r = 0; r < repeat; ++r)
+      op.apply(source_block.data(), nb_sources, target.data(), nb_targets, nfields);
+    auto const toc = std::chrono::steady_clock::now();
+    double const elapsed =
+      std::chrono::duration<double, std::nano>(toc - tic).count();
+    std::cout << name << ": " << elapsed / (repeat * nfields * nb_targets)
+              << " ns per remapped value" << std::endl;
+  };
+
+  remap(target_major, expected, "target-major");
+  remap(source_major, result, "source-major");
+
+  for (int k = 0; k < nfields * nb_targets; ++k)
+    ASSERT_NEAR(expected[k], result[k], 1.e-12);
+}
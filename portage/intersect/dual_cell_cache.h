@@ -0,0 +1,525 @@
+/*
+This file is part of the Ristra portage project.
+Please see the license file at the root of this repository, or at:
+    https://github.com/laristra/portage/blob/master/LICENSE
+*/
+
+#ifndef PORTAGE_INTERSECT_DUAL_CELL_CACHE_H_
+#define PORTAGE_INTERSECT_DUAL_CELL_CACHE_H_
+
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <vector>
+
+#include "wonton/support/wonton.h"
+#include "wonton/support/Point.h"
+
+#include "portage/support/portage.h"
+#include "portage/intersect/intersect_polys_r2d.h"
+#include "portage/intersect/intersect_polys_r3d.h"
+
+namespace Portage {
+
+/**
+ * @brief Read-only view of a contiguous array.
+ *
+ * @tparam T: type of the elements.
+ */
+template<class T>
+class ConstArrayView {
+
+public:
+  ConstArrayView() = default;
+
+  /**
+   * @brief Create a view of an array.
+   *
+   * @param data: pointer to the first element.
+   * @param size: number of elements.
+   */
+  ConstArrayView(T const* data, int size) : data_(data), size_(size) {}
+
+  /**
+   * @brief Create a view of a vector.
+   *
+   * @param data: the viewed vector.
+   */
+  ConstArrayView(std::vector<T> const& data)
+    : data_(data.data()), size_(static_cast<int>(data.size())) {}
+
+  int size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+  T const& operator[](int i) const { return data_[i]; }
+  T const* begin() const { return data_; }
+  T const* end() const { return data_ + size_; }
+
+private:
+  T const* data_ = nullptr;
+  int size_ = 0;
+};
+
+/**
+ * @brief View of a faceted polyhedron stored flat, which exposes the
+ *        same members as facetedpoly_t to the r3d intersection kernel.
+ */
+struct FacetedPolyView {
+  /** facets of the polyhedron, as lists of local vertex indices */
+  struct Facets {
+    int const* offsets;
+    int const* vertices;
+    int num_facets;
+
+    int size() const { return num_facets; }
+    ConstArrayView<int> operator[](int i) const {
+      return ConstArrayView<int>(vertices + offsets[i], offsets[i + 1] - offsets[i]);
+    }
+  };
+
+  Facets facetpoints;
+  ConstArrayView<Wonton::Point<3>> points;
+};
+
+/**
+ * @brief Flat storage of the dual cells of source and target nodes as
+ *        consumed by the r2d/r3d intersection kernels.
+ *
+ * Each kind of dual cell is queried from the mesh wrapper into a buffer,
+ * from which it is appended to compressed sparse row (CSR) arrays.
+ *
+ * @tparam D: spatial dimension.
+ */
+template<int D>
+struct dual_cell_polytope {};
+
+template<>
+struct dual_cell_polytope<2> {
+  /** polygon vertices of each source node */
+  struct source_storage {
+    std::vector<int> offsets {0};
+    std::vector<Wonton::Point<2>> points {};
+  };
+
+  /** polygon vertices of each target node */
+  using target_storage = source_storage;
+  using source_view = ConstArrayView<Wonton::Point<2>>;
+  using target_view = ConstArrayView<Wonton::Point<2>>;
+  using source_buffer = std::vector<Wonton::Point<2>>;
+  using target_buffer = std::vector<Wonton::Point<2>>;
+
+  template<class Mesh>
+  static void source(Mesh const& mesh, int node, source_buffer* poly) {
+    mesh.dual_cell_get_coordinates(node, poly);
+  }
+
+  template<class Mesh>
+  static void target(Mesh const& mesh, int node, target_buffer* poly) {
+    mesh.dual_cell_get_coordinates(node, poly);
+  }
+
+  static bool is_convex(std::vector<Wonton::Point<2>> const& poly,
+                        NumericTolerances_t const& num_tols) {
+    return poly2_is_convex(poly, num_tols);
+  }
+
+  static void count(source_buffer const& poly, int* sizes) {
+    sizes[0] = poly.size();
+  }
+
+  static void resize(source_storage& storage, int const* totals) {
+    storage.points.resize(totals[0]);
+  }
+
+  static void copy(source_buffer const& poly, int const* offsets,
+                   source_storage& storage) {
+    std::copy(poly.begin(), poly.end(), storage.points.begin() + offsets[0]);
+  }
+
+  static source_view view(source_storage const& storage, int node) {
+    int const first = storage.offsets[node];
+    return source_view(storage.points.data() + first, storage.offsets[node + 1] - first);
+  }
+
+  static ConstArrayView<Wonton::Point<2>> vertices(source_storage const& storage, int node) {
+    return view(storage, node);
+  }
+
+  /** number of CSR arrays per dual cell */
+  static constexpr int num_arrays = 1;
+};
+
+template<>
+struct dual_cell_polytope<3> {
+  /** facetization of each source node */
+  struct source_storage {
+    std::vector<int> offsets {0};
+    std::vector<int> point_offsets {0};
+    std::vector<Wonton::Point<3>> points {};
+    std::vector<int> facet_offsets {0};
+    std::vector<int> facet_vertices {};
+  };
+
+  /** tetrahedral decomposition of each target node */
+  struct target_storage {
+    std::vector<int> offsets {0};
+    std::vector<std::array<Wonton::Point<3>, 4>> tets {};
+  };
+
+  using source_view = FacetedPolyView;
+  using target_view = ConstArrayView<std::array<Wonton::Point<3>, 4>>;
+  using source_buffer = facetedpoly_t;
+  using target_buffer = std::vector<std::array<Wonton::Point<3>, 4>>;
+
+  template<class Mesh>
+  static void source(Mesh const& mesh, int node, source_buffer* poly) {
+    mesh.dual_cell_get_facetization(node, &(poly->facetpoints), &(poly->points));
+  }
+
+  template<class Mesh>
+  static void target(Mesh const& mesh, int node, target_buffer* poly) {
+    mesh.dual_wedges_get_coordinates(node, poly);
+  }
+
+  // the r3d kernel handles non-convex polyhedra through the facetization
+  // of the source and the tet decomposition of the target
+  template<class Polytope>
+  static bool is_convex(Polytope const&, NumericTolerances_t const&) {
+    return true;
+  }
+
+  // source: facets, points and facet vertices
+  static void count(source_buffer const& poly, int* sizes) {
+    sizes[0] = poly.facetpoints.size();
+    sizes[1] = poly.points.size();
+    sizes[2] = 0;
+    for (auto const& facet : poly.facetpoints)
+      sizes[2] += facet.size();
+  }
+
+  static void resize(source_storage& storage, int const* totals) {
+    storage.facet_offsets.resize(totals[0] + 1);
+    storage.points.resize(totals[1]);
+    storage.facet_vertices.resize(totals[2]);
+  }
+
+  static void copy(source_buffer const& poly, int const* offsets,
+                   source_storage& storage) {
+    std::copy(poly.points.begin(), poly.points.end(),
+              storage.points.begin() + offsets[1]);
+    int k = offsets[2];
+    int const num_facets = poly.facetpoints.size();
+    for (int f = 0; f < num_facets; ++f) {
+      auto const& facet = poly.facetpoints[f];
+      std::copy(facet.begin(), facet.end(), storage.facet_vertices.begin() + k);
+      k += facet.size();
+      storage.facet_offsets[offsets[0] + f + 1] = k;
+    }
+  }
+
+  // target: tetrahedra
+  static void count(target_buffer const& poly, int* sizes) {
+    sizes[0] = poly.size();
+  }
+
+  static void resize(target_storage& storage, int const* totals) {
+    storage.tets.resize(totals[0]);
+  }
+
+  static void copy(target_buffer const& poly, int const* offsets,
+                   target_storage& storage) {
+    std::copy(poly.begin(), poly.end(), storage.tets.begin() + offsets[0]);
+  }
+
+  static source_view view(source_storage const& storage, int node) {
+    int const facet = storage.offsets[node];
+    int const point = storage.point_offsets[node];
+    FacetedPolyView poly;
+    poly.facetpoints.offsets = storage.facet_offsets.data() + facet;
+    poly.facetpoints.vertices = storage.facet_vertices.data();
+    poly.facetpoints.num_facets = storage.offsets[node + 1] - facet;
+    poly.points = ConstArrayView<Wonton::Point<3>>(storage.points.data() + point,
+                                                   storage.point_offsets[node + 1] - point);
+    return poly;
+  }
+
+  static target_view view(target_storage const& storage, int node) {
+    int const first = storage.offsets[node];
+    return target_view(storage.tets.data() + first, storage.offsets[node + 1] - first);
+  }
+
+  static ConstArrayView<Wonton::Point<3>> vertices(source_storage const& storage, int node) {
+    return view(storage, node).points;
+  }
+
+  /** number of CSR arrays per dual cell */
+  static constexpr int num_arrays = 3;
+};
+
+/**
+ * @class DualCellCache dual_cell_cache.h
+ * @brief Per-remap cache of the dual cells of source and target nodes.
+ *
+ * Node-centered remap intersects the dual cell of each target node with
+ * the dual cells of its candidate source nodes, and the nodal gradient
+ * limiter visits the vertices of each source dual cell for every field.
+ * The mesh wrappers rebuild these dual cells from the wedges on each
+ * query, so a source dual cell is otherwise assembled once per target
+ * node it overlaps. This cache builds them once, in the form expected
+ * by the intersection kernels, along with their convexity. It is then
+ * shared by the intersection and gradient phases of the remap.
+ *
+ * The dual cells of all nodes are stored contiguously in CSR arrays,
+ * and are retrieved as views. The source and target sides are built
+ * separately, so that the gradient phase only builds the source one.
+ *
+ * @tparam D: spatial dimension.
+ */
+template<int D>
+class DualCellCache {
+
+  using Polytope = dual_cell_polytope<D>;
+
+public:
+  using SourcePolytope = typename Polytope::source_view;
+  using TargetPolytope = typename Polytope::target_view;
+
+  DualCellCache() = default;
+
+  /**
+   * @brief Build the dual cells of all source and target nodes.
+   *
+   * @tparam SourceMesh: source mesh wrapper type.
+   * @tparam TargetMesh: target mesh wrapper type.
+   * @param source_mesh: source mesh wrapper.
+   * @param target_mesh: target mesh wrapper.
+   * @param num_tols: numerical tolerances used for the convexity check.
+   */
+  template<class SourceMesh, class TargetMesh>
+  void build(SourceMesh const& source_mesh, TargetMesh const& target_mesh,
+             NumericTolerances_t const& num_tols) {
+    build_sources(source_mesh, num_tols);
+    build_targets(target_mesh, num_tols);
+  }
+
+  /**
+   * @brief Build the dual cells of all source nodes.
+   *
+   * @tparam SourceMesh: source mesh wrapper type.
+   * @param source_mesh: source mesh wrapper.
+   * @param num_tols: numerical tolerances used for the convexity check.
+   */
+  template<class SourceMesh>
+  void build_sources(SourceMesh const& source_mesh, NumericTolerances_t const& num_tols) {
+    store<typename Polytope::source_buffer>(
+      source_mesh, num_tols, sources_, source_convex_,
+      [&](int n, typename Polytope::source_buffer* poly) {
+        Polytope::source(source_mesh, n, poly);
+      });
+    has_sources_ = true;
+  }
+
+  /**
+   * @brief Build the dual cells of all target nodes.
+   *
+   * @tparam TargetMesh: target mesh wrapper type.
+   * @param target_mesh: target mesh wrapper.
+   * @param num_tols: numerical tolerances used for the convexity check.
+   */
+  template<class TargetMesh>
+  void build_targets(TargetMesh const& target_mesh, NumericTolerances_t const& num_tols) {
+    store<typename Polytope::target_buffer>(
+      target_mesh, num_tols, targets_, target_convex_,
+      [&](int n, typename Polytope::target_buffer* poly) {
+        Polytope::target(target_mesh, n, poly);
+      });
+    has_targets_ = true;
+  }
+
+  /**
+   * @brief Check if the dual cells of source nodes were built.
+   *
+   * @return true if they are stored.
+   */
+  bool has_sources() const { return has_sources_; }
+
+  /**
+   * @brief Check if the dual cells of target nodes were built.
+   *
+   * @return true if they are stored.
+   */
+  bool has_targets() const { return has_targets_; }
+
+  /**
+   * @brief Check if the cache was built.
+   *
+   * @return true if no dual cell is stored.
+   */
+  bool empty() const { return not has_sources_ and not has_targets_; }
+
+  /**
+   * @brief Retrieve the dual cell of a source node.
+   *
+   * @param node: source node index.
+   * @return a view of the dual cell ready for intersection.
+   */
+  SourcePolytope source(int node) const { return Polytope::view(sources_, node); }
+
+  /**
+   * @brief Retrieve the dual cell of a target node.
+   *
+   * @param node: target node index.
+   * @return a view of the dual cell ready for intersection.
+   */
+  TargetPolytope target(int node) const { return Polytope::view(targets_, node); }
+
+  /**
+   * @brief Check if the dual cell of a source node is convex.
+   *
+   * @param node: source node index.
+   * @return true if it is convex.
+   */
+  bool source_convex(int node) const { return source_convex_[node]; }
+
+  /**
+   * @brief Check if the dual cell of a target node is convex.
+   *
+   * @param node: target node index.
+   * @return true if it is convex.
+   */
+  bool target_convex(int node) const { return target_convex_[node]; }
+
+  /**
+   * @brief Retrieve the vertices of the dual cell of a source node.
+   *
+   * @param node: source node index.
+   * @return a view of the dual cell vertices.
+   */
+  ConstArrayView<Wonton::Point<D>> vertices(int node) const {
+    return Polytope::vertices(sources_, node);
+  }
+
+private:
+  /**
+   * @brief Store the dual cells of all nodes of a mesh in CSR arrays.
+   *
+   * Dual cells are queried twice from the mesh wrapper: once to count
+   * their sizes and check their convexity, then once to be copied in
+   * place, so that they are never all held in both forms.
+   *
+   * @tparam Buffer: dual cell type returned by the mesh wrapper.
+   * @param mesh: mesh wrapper.
+   * @param num_tols: numerical tolerances used for the convexity check.
+   * @param storage: CSR arrays of the dual cells.
+   * @param convex: convexity flag of each dual cell.
+   * @param query: functor retrieving the dual cell of a node.
+   */
+  template<class Buffer, class Mesh, class Storage, class Query>
+  static void store(Mesh const& mesh, NumericTolerances_t const& num_tols,
+                    Storage& storage, std::vector<char>& convex, Query const& query) {
+
+    constexpr int const num_arrays = Polytope::num_arrays;
+    int const nb_nodes = mesh.num_entities(Wonton::NODE, Wonton::ALL);
+    std::vector<std::array<int, num_arrays>> sizes(nb_nodes + 1);
+    convex.assign(nb_nodes, 1);
+
+    Wonton::for_each(mesh.begin(Wonton::NODE, Wonton::ALL),
+                     mesh.end(Wonton::NODE, Wonton::ALL),
+                     [&](int n) {
+                       Buffer poly;
+                       query(n, &poly);
+                       Polytope::count(poly, sizes[n + 1].data());
+                       convex[n] = Polytope::is_convex(poly, num_tols);
+                     });
+
+    // exclusive prefix sum of the sizes of each array
+    for (int k = 0; k < num_arrays; ++k)
+      sizes[0][k] = 0;
+    for (int n = 0; n < nb_nodes; ++n)
+      for (int k = 0; k < num_arrays; ++k)
+        sizes[n + 1][k] += sizes[n][k];
+
+    set_offsets(storage, sizes, 0);
+    Polytope::resize(storage, sizes[nb_nodes].data());
+
+    Wonton::for_each(mesh.begin(Wonton::NODE, Wonton::ALL),
+                     mesh.end(Wonton::NODE, Wonton::ALL),
+                     [&](int n) {
+                       Buffer poly;
+                       query(n, &poly);
+                       Polytope::copy(poly, sizes[n].data(), storage);
+                     });
+  }
+
+  /**
+   * @brief Set the offsets of each dual cell in the CSR arrays.
+   *
+   * The facetized source polyhedra in 3D also have point offsets.
+   *
+   * @param storage: CSR arrays of the dual cells.
+   * @param sizes: prefix sums of the sizes of each array.
+   */
+  template<class Storage, class Sizes>
+  static auto set_offsets(Storage& storage, Sizes const& sizes, int)
+    -> decltype(storage.point_offsets, void()) {
+    int const nb_nodes = static_cast<int>(sizes.size()) - 1;
+    storage.offsets.resize(nb_nodes + 1);
+    storage.point_offsets.resize(nb_nodes + 1);
+    for (int n = 0; n <= nb_nodes; ++n) {
+      storage.offsets[n] = sizes[n][0];
+      storage.point_offsets[n] = sizes[n][1];
+    }
+    storage.facet_offsets.assign(1, 0);
+  }
+
+  template<class Storage, class Sizes>
+  static void set_offsets(Storage& storage, Sizes const& sizes, long) {
+    int const nb_nodes = static_cast<int>(sizes.size()) - 1;
+    storage.offsets.resize(nb_nodes + 1);
+    for (int n = 0; n <= nb_nodes; ++n)
+      storage.offsets[n] = sizes[n][0];
+  }
+
+  using SourceStorage = typename Polytope::source_storage;
+  using TargetStorage = typename Polytope::target_storage;
+
+  /** dual cells of source nodes */
+  SourceStorage sources_ {};
+  /** dual cells of target nodes */
+  TargetStorage targets_ {};
+  /** convexity flags, stored as char to be filled concurrently */
+  std::vector<char> source_convex_ {};
+  std::vector<char> target_convex_ {};
+  /** whether each side was built */
+  bool has_sources_ = false;
+  bool has_targets_ = false;
+};
+
+namespace detail {
+
+template<class Functor, class Cache>
+auto attach_dual_cell_cache(Functor& functor, Cache const& cache, int)
+  -> decltype(functor.set_dual_cell_cache(cache), void()) {
+  functor.set_dual_cell_cache(cache);
+}
+
+template<class Functor, class Cache>
+void attach_dual_cell_cache(Functor&, Cache const&, long) {}
+
+}  // namespace detail
+
+/**
+ * @brief Hand the dual cells cache to an intersection or gradient
+ *        functor if it is able to use it.
+ *
+ * @param functor: the functor.
+ * @param cache: the dual cells cache.
+ */
+template<class Functor, int D>
+void attach_dual_cell_cache(Functor& functor,
+                            std::shared_ptr<DualCellCache<D>> const& cache) {
+  detail::attach_dual_cell_cache(functor, cache, 0);
+}
+
+}  // namespace Portage
+
+#endif  // PORTAGE_INTERSECT_DUAL_CELL_CACHE_H_
@@ -11,6 +11,7 @@ Please see the license file at the root of this repository, or at:
 #include <cmath>
 #include <cfloat>
 #include <algorithm>
+#include <vector>
 
 #include "wonton/support/wonton.h"
 #include "wonton/support/Point.h"
@@ -53,6 +54,190 @@ std::vector<double> areaAndMomentPolygon(std::vector<Wonton::Point<2>> const& po
   return ret;
 }
 
+/*!
+  @brief Exact sign of the orientation determinant of three points.
+
+  The determinant is first evaluated in plain floating point and its sign is
+  accepted if the magnitude exceeds the forward error bound of the evaluation
+  (Shewchuk's ccwerrboundA). Otherwise it is recomputed exactly: the six
+  products of the expanded determinant are split with fma into error-free
+  pairs and summed into a nonoverlapping expansion whose leading component
+  gives the sign.
+
+  @param[in] a, b, c: the three points.
+  @returns +1 if (a, b, c) is counter-clockwise, -1 if clockwise, 0 if collinear.
+*/
+inline
+int orient2d_sign(Wonton::Point<2> const& a,
+                  Wonton::Point<2> const& b,
+                  Wonton::Point<2> const& c) {
+
+  double const detleft  = (a[0] - c[0]) * (b[1] - c[1]);
+  double const detright = (a[1] - c[1]) * (b[0] - c[0]);
+  double const det = detleft - detright;
+  double const errbound = (3.0 + 16.0 * DBL_EPSILON) * DBL_EPSILON
+                          * (std::abs(detleft) + std::abs(detright));
+
+  if (det > errbound) return 1;
+  if (-det > errbound) return -1;
+
+  // exact fallback: det = ax.by - ay.bx + bx.cy - by.cx + cx.ay - cy.ax
+  double const terms[6][2] = {{ a[0],  b[1]}, {-a[1],  b[0]},
+                              { b[0],  c[1]}, {-b[1],  c[0]},
+                              { c[0],  a[1]}, {-c[1],  a[0]}};
+  double expansion[12];
+  int length = 0;
+
+  auto grow = [&](double value) {
+    // grow-expansion with zero elimination
+    double q = value;
+    int k = 0;
+    for (int i = 0; i < length; i++) {
+      double const sum = q + expansion[i];
+      double const bv = sum - q;
+      double const err = (q - (sum - bv)) + (expansion[i] - bv);
+      q = sum;
+      if (err != 0.0)
+        expansion[k++] = err;
+    }
+    if (q != 0.0)
+      expansion[k++] = q;
+    length = k;
+  };
+
+  for (auto const& term : terms) {
+    double const prod = term[0] * term[1];
+    grow(prod);
+    grow(std::fma(term[0], term[1], -prod));
+  }
+
+  if (length == 0) return 0;
+  return expansion[length - 1] > 0.0 ? 1 : -1;
+}
+
+/*!
+  @brief Check if a polygon is strictly convex, i.e. it turns in a single
+  direction and winds around its interior exactly once.
+  @param[in] poly: polygon vertices in either orientation.
+  @param[out] orientation: +1 if counter-clockwise, -1 if clockwise.
+  @returns true if the polygon is convex.
+*/
+inline
+bool is_convex_polygon(std::vector<Wonton::Point<2>> const& poly,
+                       int* orientation) {
+
+  int const nb_points = poly.size();
+  if (nb_points < 3)
+    return false;
+
+  int turn = 0;
+  int x_flips = 0;
+  double last_dx = 0.;
+
+  for (int i = 0; i < nb_points; i++) {
+    auto const& p = poly[i];
+    auto const& q = poly[(i + 1) % nb_points];
+    auto const& r = poly[(i + 2) % nb_points];
+
+    int const sign = orient2d_sign(p, q, r);
+    if (sign != 0) {
+      if (turn == 0)
+        turn = sign;
+      else if (sign != turn)
+        return false;
+    }
+
+    // a star-shaped polygon turns one way but winds more than once,
+    // which shows up as more than two sign changes of the x-direction.
+    double const dx = q[0] - p[0];
+    if (dx != 0.) {
+      if (last_dx * dx < 0.)
+        x_flips++;
+      last_dx = dx;
+    }
+  }
+
+  // account for the direction change across the closing edge
+  for (int i = 0; i < nb_points; i++) {
+    double const dx = poly[(i + 1) % nb_points][0] - poly[i][0];
+    if (dx != 0.) {
+      if (last_dx * dx < 0.)
+        x_flips++;
+      break;
+    }
+  }
+
+  if (turn == 0 or x_flips > 2)
+    return false;
+
+  *orientation = turn;
+  return true;
+}
+
+/*!
+  @brief Clip a polygon against a convex polygon (Sutherland-Hodgman).
+
+  The inside/outside classification of each vertex uses the exact orientation
+  predicate so that the topology of the result is consistent; only the
+  position of the edge crossings is computed in floating point.
+  For a non-convex subject, the result may contain zero-area bridges between
+  its disjoint parts, which do not contribute to its moments.
+
+  @param[in] subject: polygon to be clipped.
+  @param[in] convex: convex clipping polygon.
+  @param[in] orientation: orientation of the clipping polygon (+1 or -1).
+  @returns the clipped polygon, empty if both do not overlap.
+*/
+inline
+std::vector<Wonton::Point<2>>
+clip_by_convex_polygon(std::vector<Wonton::Point<2>> const& subject,
+                       std::vector<Wonton::Point<2>> const& convex,
+                       int orientation) {
+
+  std::vector<Wonton::Point<2>> current(subject);
+  std::vector<Wonton::Point<2>> clipped;
+  clipped.reserve(subject.size() + convex.size());
+
+  int const nb_edges = convex.size();
+  for (int e = 0; e < nb_edges and not current.empty(); e++) {
+    auto const& p = convex[e];
+    auto const& q = convex[(e + 1) % nb_edges];
+
+    auto signed_area = [&](Wonton::Point<2> const& x) {
+      return orientation * ((q[0] - p[0]) * (x[1] - p[1])
+                          - (q[1] - p[1]) * (x[0] - p[0]));
+    };
+
+    clipped.clear();
+    int const nb_points = current.size();
+    auto const* prev = &current[nb_points - 1];
+    int prev_side = orientation * orient2d_sign(p, q, *prev);
+
+    for (int i = 0; i < nb_points; i++) {
+      auto const& curr = current[i];
+      int const curr_side = orientation * orient2d_sign(p, q, curr);
+
+      if (curr_side * prev_side < 0) {
+        double const d_prev = signed_area(*prev);
+        double const d_curr = signed_area(curr);
+        double const t = d_prev / (d_prev - d_curr);
+        clipped.emplace_back((*prev)[0] + t * (curr[0] - (*prev)[0]),
+                             (*prev)[1] + t * (curr[1] - (*prev)[1]));
+      }
+      if (curr_side >= 0)
+        clipped.emplace_back(curr);
+
+      prev = &curr;
+      prev_side = curr_side;
+    }
+    std::swap(current, clipped);
+  }
+
+  if (current.size() < 3)
+    current.clear();
+  return current;
+}
+
 /*!
   @class IntersectClipper "intersectClipper.h"
   @brief 2-D intersection algorithm for arbitrary convex and non-convex polyhedra
@@ -61,6 +246,10 @@ std::vector<double> areaAndMomentPolygon(std::vector<Wonton::Point<2>> const& po
 
   The intersect class is templated on MeshWrapper type.  You must provide a method to convert
   the template cells to an IntersectClipper::Poly.
+
+  If either cell is convex, the other one is clipped against it directly in double
+  precision (Sutherland-Hodgman with exact orientation predicates). ClipperLib is
+  only used when both cells are non-convex, or when the fast path is disabled.
 */
 
 template <typename SourceMeshType, typename TargetMeshType=SourceMeshType> class IntersectClipper
@@ -73,8 +262,15 @@ typedef std::vector<Wonton::Point<2>> Poly;
 /// Alias to provide volume and centroid
 typedef std::pair<double, Wonton::Point<2>> Moment;
 
-/// Constructor taking a source mesh @c s and a target mesh @c t.
-IntersectClipper(const SourceMeshType &s, const TargetMeshType &t):sourceMeshWrapper(s), targetMeshWrapper(t){}
+/*!
+  @brief Constructor taking a source mesh @c s and a target mesh @c t.
+  @param[in] s: source mesh wrapper.
+  @param[in] t: target mesh wrapper.
+  @param[in] convex_fast_path: clip convex cells without ClipperLib.
+*/
+IntersectClipper(const SourceMeshType &s, const TargetMeshType &t,
+                 bool convex_fast_path = true)
+  : sourceMeshWrapper(s), targetMeshWrapper(t), convex_fast_path_(convex_fast_path) {}
 
 /*!
   @brief Intersect two cells and return the first two moments.
@@ -86,6 +282,62 @@ std::vector<std::vector<double> > operator() (const int cellA, const int cellB)
   Poly polyA, polyB;
   sourceMeshWrapper.cell_get_coordinates(cellA, &polyA);
   targetMeshWrapper.cell_get_coordinates(cellB, &polyB);
+
+  if (convex_fast_path_) {
+    int orientation = 0;
+    if (is_convex_polygon(polyB, &orientation))
+      return convex_moments(polyA, polyB, orientation);
+    if (is_convex_polygon(polyA, &orientation))
+      return convex_moments(polyB, polyA, orientation);
+  }
+  return clipper_moments(polyA, polyB);
+}
+
+/// Default constructor.
+IntersectClipper() = default;
+
+/// Copy constructor (disabled)
+IntersectClipper(const IntersectClipper &) = delete;
+
+/// Assignment operator (disabled)
+IntersectClipper & operator = (const IntersectClipper &) = delete;
+
+
+private:
+
+/*!
+  @brief Moments of the intersection of a polygon with a convex one.
+  @param[in] subject: polygon to be clipped.
+  @param[in] convex: convex clipping polygon.
+  @param[in] orientation: orientation of the convex polygon.
+  @return list of moments of the intersection, empty if they do not overlap.
+*/
+static std::vector<std::vector<double>> convex_moments(Poly const& subject,
+                                                       Poly const& convex,
+                                                       int orientation) {
+  std::vector<std::vector<double>> moments;
+  Poly const clipped = clip_by_convex_polygon(subject, convex, orientation);
+  if (not clipped.empty()) {
+    auto polygon_moments = areaAndMomentPolygon(clipped);
+    if (polygon_moments[0] < 0.) {
+      // report moments of the counter-clockwise polygon as clipper does
+      for (auto&& value : polygon_moments)
+        value = -value;
+    }
+    if (polygon_moments[0] > 0.)
+      moments.emplace_back(std::move(polygon_moments));
+  }
+  return moments;
+}
+
+/*!
+  @brief Moments of the intersection of two arbitrary polygons using ClipperLib.
+  @param[in] polyA: first polygon.
+  @param[in] polyB: second polygon.
+  @return list of moments of each polygon of the intersection.
+*/
+static std::vector<std::vector<double>> clipper_moments(Poly const& polyA,
+                                                        Poly const& polyB) {
   double max_size_poly = 0;
   max_size_poly = IntersectClipper::updateMaxSize(polyA, max_size_poly);
   max_size_poly = IntersectClipper::updateMaxSize(polyB, max_size_poly);
@@ -122,18 +374,6 @@ std::vector<std::vector<double> > operator() (const int cellA, const int cellB)
   return moments;
 }
 
-/// Default constructor.
-IntersectClipper() = default;
-
-/// Copy constructor (disabled)
-IntersectClipper(const IntersectClipper &) = delete;
-
-/// Assignment operator (disabled)
-IntersectClipper & operator = (const IntersectClipper &) = delete;
-
-
-private:
-
 //We must use the same max size for all the polygons, so the number we are looking for is the maximum value in the set--all the X and Y values will be converted using this value
 static double updateMaxSize( const std::vector<Wonton::Point<2>> poly, double max_size_poly){
   for(auto const &i: poly){
@@ -189,6 +429,7 @@ static std::vector<ClipperLib::IntPoint> convertPoly2int(std::vector<Wonton::Poi
 private:
 const SourceMeshType &sourceMeshWrapper;
 const TargetMeshType &targetMeshWrapper;
+bool convex_fast_path_ = true;
 
 };  // class IntersectClipper
 
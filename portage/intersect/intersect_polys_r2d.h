@@ -15,6 +15,7 @@ Please see the license file at the root of this repository, or at:
 #include "wonton/support/CoordinateSystem.h"
 #include "wonton/support/wonton.h"
 #include "wonton/support/Point.h"
+#include "wonton/support/Vector.h"
 
 extern "C" {
 #include "r2d.h"
@@ -24,20 +25,57 @@ extern "C" {
 
 namespace Portage {
 
-// intersect one source polygon (possibly non-convex) with a
-// triangular decomposition of a target polygon
+// Check if polygon is truly convex (not just star convex)
+// Move to Wonton
+
+static inline
+bool poly2_is_convex(std::vector<Wonton::Point<2>> const& pverts,
+                     NumericTolerances_t const& num_tols) {
+
+  int npverts = pverts.size();
+  for (int i = 0; i < npverts; i++) {
+    
+    // Compute distance from pverts[i+1] to segment (pverts[i], pverts[i+2])
+    int ifv = i, imv = (i+1)%npverts, isv = (i+2)%npverts;
+    Wonton::Vector<2> normal( pverts[isv][1] - pverts[ifv][1], 
+                             -pverts[isv][0] + pverts[ifv][0]);
+    normal.normalize();
+    Wonton::Vector<2> fv2mv = pverts[imv] - pverts[ifv];
+    double dst = Wonton::dot(fv2mv, normal);
+    
+    if (dst <= -num_tols.min_absolute_distance)
+      return false;
+  }
+
+  return true;
+}
 
-inline
+// intersect one source polygon (possibly non-convex) with a
+// triangular decomposition of a target polygon.
+// 'order' is the max degree of the moments to compute: the default
+// returns the area and first moments, order 2 also returns the second
+// moments [x^2, xy, y^2] computed in the same clip and reduce pass.
+// Moments above first order are only supported in cartesian coordinates.
+// Polygons are lists of vertices, either vectors or array views.
+
+template<int order = 1,
+         class SourcePolygon = std::vector<Wonton::Point<2>>,
+         class TargetPolygon = std::vector<Wonton::Point<2>>>
 std::vector<double>
-intersect_polys_r2d(std::vector<Wonton::Point<2>> const & source_poly,
-                    std::vector<Wonton::Point<2>> const & target_poly,
+intersect_polys_r2d(SourcePolygon const & source_poly,
+                    TargetPolygon const & target_poly,
                     NumericTolerances_t num_tols,
                     bool trg_convex=true,
                     Wonton::CoordSysType coord_sys = Wonton::CoordSysType::Cartesian) {
 
-  int poly_order = 1;  // max degree of moments to calculate
-  if (coord_sys == Wonton::CoordSysType::CylindricalAxisymmetric)
+  static_assert(order >= 1, "intersect_polys_r2d: moment order must be at least 1");
+
+  int poly_order = order;  // max degree of moments to calculate
+  if (coord_sys == Wonton::CoordSysType::CylindricalAxisymmetric) {
+    if (order > 1)
+      throw std::runtime_error("intersect_polys_r2d.h: second moments are not supported in cylindrical coordinates");
     poly_order = 2;
+  }
 
   int nmoments = R2D_NUM_MOMENTS(poly_order);
   std::vector<double> moments(nmoments, 0);
@@ -46,8 +84,11 @@ intersect_polys_r2d(std::vector<Wonton::Point<2>> const & source_poly,
 
   const int size1 = source_poly.size();
   const int size2 = target_poly.size();
-  if (!size1 || !size2)
-    return moments;  // could allow top level code to avoid an 'if' statement
+  if (!size1 || !size2) {
+    // could allow top level code to avoid an 'if' statement
+    moments.resize(R2D_NUM_MOMENTS(order));
+    return moments;
+  }
 
   std::vector<r2d_rvec2> verts1(size1);
   for (int i = 0; i < size1; ++i) {
@@ -80,13 +121,10 @@ intersect_polys_r2d(std::vector<Wonton::Point<2>> const & source_poly,
     r2d_real om[nmoments];
     r2d_reduce(&srcpoly_r2d, om, poly_order);
 
-    // Copy and optionally shift moments:
+    // Copy moments:
     for (int j = 0; j < nmoments; ++j)
       moments[j] = om[j];
 
-    if (coord_sys == Wonton::CoordSysType::CylindricalAxisymmetric)
-      Wonton::CylindricalAxisymmetricCoordinates::shift_moments_list<2>(moments);
-
   } else {  // case 2:  target_poly is non-convex
 
     // Must divide target_poly into triangles for clipping.  Choice
@@ -174,11 +212,18 @@ intersect_polys_r2d(std::vector<Wonton::Point<2>> const & source_poly,
       r2d_reduce(&srcpoly_r2d_copy, om, poly_order);
       
       // Accumulate moments:
-      for (int j = 0; j < 3; ++j)
+      for (int j = 0; j < nmoments; ++j)
         moments[j] += om[j];
     }  // for i
   }  // if convex {} else {}
 
+  // Optionally shift moments
+  if (coord_sys == Wonton::CoordSysType::CylindricalAxisymmetric) {
+    Wonton::CylindricalAxisymmetricCoordinates::shift_moments_list<2>(moments);
+    // only keep the moments up to the requested order
+    moments.resize(R2D_NUM_MOMENTS(order));
+  }
+
   return moments;
 }
 
@@ -74,10 +74,19 @@ facetedpoly_t get_faceted_matpoly(const Tangram::MatPoly<3>& matpoly) {
 // will cut down some calls to R3D initialization routines
 // (particularly on the target mesh side)
 
+// 'order' is the max degree of the moments to compute: the default
+// returns the volume and first moments, order 2 also returns the second
+// moments [x^2, xy, xz, y^2, yz, z^2] computed in the same clip and
+// reduce pass.
+// The source polyhedron may also be a FacetedPolyView and the target
+// tets an array view, as stored by the dual cells cache.
+
+template<int order = 1,
+         class SourcePolyhedron = facetedpoly_t,
+         class TargetTets = std::vector<std::array<Point<3>, 4>>>
 std::vector<double>
-inline
-intersect_polys_r3d(const facetedpoly_t &srcpoly,
-                    const std::vector<std::array<Point<3>, 4>> &target_tet_coords,
+intersect_polys_r3d(const SourcePolyhedron &srcpoly,
+                    const TargetTets &target_tet_coords,
                     NumericTolerances_t num_tols) {
 
   // Bounding box of the target cell - will be used to compute
@@ -129,7 +138,10 @@ intersect_polys_r3d(const facetedpoly_t &srcpoly,
 
   // Finished building source poly; now intersect with tets of target cell
 
-  std::vector<double> moments(4, 0);
+  static_assert(order >= 1, "intersect_polys_r3d: moment order must be at least 1");
+  int const nmoments = R3D_NUM_MOMENTS(order);
+
+  std::vector<double> moments(nmoments, 0);
   for (auto const & target_cell_tet : target_tet_coords) {
     std::vector<r3d_plane> faces(4);
 
@@ -169,13 +181,12 @@ intersect_polys_r3d(const facetedpoly_t &srcpoly,
     if (!ok)
       throw std::runtime_error("intersect_polys_r3d.h: r3d clip failed");
 
-    // find the moments (up to quadratic order) of the clipped poly
-    const int POLY_ORDER = 1;
-    r3d_real om[R3D_NUM_MOMENTS(POLY_ORDER)];
-    r3d_reduce(&src_r3dpoly_copy, om, POLY_ORDER);
+    // find the moments (up to the requested order) of the clipped poly
+    r3d_real om[R3D_NUM_MOMENTS(order)];
+    r3d_reduce(&src_r3dpoly_copy, om, order);
 
     // Accumulate moments:
-    for (int i = 0; i < 4; i++)
+    for (int i = 0; i < nmoments; i++)
       moments[i] += om[i];
   }
 
@@ -27,6 +27,8 @@ extern "C" {
 #include "portage/support/portage.h"
 #include "portage/intersect/dummy_interface_reconstructor.h"
 #include "portage/intersect/intersect_polys_r2d.h"
+#include "portage/intersect/matpoly_cache.h"
+#include "portage/intersect/dual_cell_cache.h"
 
 #ifdef PORTAGE_HAS_TANGRAM
 #include "tangram/driver/CellMatPoly.h"
@@ -42,31 +44,6 @@ using Wonton::SIDE;
 using Wonton::WEDGE;
 using Wonton::ALL;
 
-// Check if polygon is truly convex (not just star convex)
-// Move to Wonton
-
-static inline
-bool poly2_is_convex(std::vector<Wonton::Point<2>> const& pverts,
-                     NumericTolerances_t const& num_tols) {
-
-  int npverts = pverts.size();
-  for (int i = 0; i < npverts; i++) {
-    
-    // Compute distance from pverts[i+1] to segment (pverts[i], pverts[i+2])
-    int ifv = i, imv = (i+1)%npverts, isv = (i+2)%npverts;
-    Wonton::Vector<2> normal( pverts[isv][1] - pverts[ifv][1], 
-                             -pverts[isv][0] + pverts[ifv][0]);
-    normal.normalize();
-    Wonton::Vector<2> fv2mv = pverts[imv] - pverts[ifv];
-    double dst = Wonton::dot(fv2mv, normal);
-    
-    if (dst <= -num_tols.min_absolute_distance)
-      return false;
-  }
-
-  return true;
-}
-
 #ifdef PORTAGE_DEBUG
 static inline
 void throw_validity_error_2d(Wonton::Entity_kind ekind, int entity_id,
@@ -142,6 +119,10 @@ void throw_validity_error_2d(Wonton::Entity_kind ekind, int entity_id,
 // procedure. Also, in 3D they are guaranteed to be convex since a
 // non-convex cell is decomposed into simplices and then sliced by the
 // interface plane.
+//
+// The 'moment_order' parameter sets the max degree of the intersection
+// moments: 1 (default) gives the area and first moments, 2 also gives
+// the second moments needed for an exact third order remap.
 
 
 
@@ -150,7 +131,8 @@ template <Entity_kind on_what, class SourceMeshType,
           template<class, int, class, class> class InterfaceReconstructorType =
           DummyInterfaceReconstructor,
           class Matpoly_Splitter = void,
-          class Matpoly_Clipper = void>
+          class Matpoly_Clipper = void,
+          int moment_order = 1>
 class IntersectR2D {
 
 #ifdef PORTAGE_HAS_TANGRAM
@@ -223,9 +205,11 @@ class IntersectR2D {
 template <class SourceMeshType, class SourceStateType,
           class TargetMeshType,
           template <class, int, class, class> class InterfaceReconstructorType,
-          class Matpoly_Splitter, class Matpoly_Clipper>
+          class Matpoly_Splitter, class Matpoly_Clipper,
+          int moment_order>
 class IntersectR2D<Entity_kind::CELL, SourceMeshType, SourceStateType, TargetMeshType,
-                   InterfaceReconstructorType, Matpoly_Splitter, Matpoly_Clipper> {
+                   InterfaceReconstructorType, Matpoly_Splitter, Matpoly_Clipper,
+                   moment_order> {
 
 #ifdef PORTAGE_HAS_TANGRAM
   using InterfaceReconstructor2D =
@@ -263,6 +247,14 @@ class IntersectR2D<Entity_kind::CELL, SourceMeshType, SourceStateType, TargetMes
     matid_ = m;
   }
 
+#ifdef PORTAGE_HAS_TANGRAM
+  /// \brief Set the cache of material polygons of mixed source cells
+
+  void set_matpoly_cache(std::shared_ptr<MatPolyCache<2>> cache) {
+    matpoly_cache_ = cache;
+  }
+#endif
+
   /// \brief Intersect target cell with a set of source cells
   /// \param[in] tgt_entity  Cell of target mesh to intersect
   /// \param[in] src_entities List of source cells to intersect against
@@ -366,8 +358,8 @@ class IntersectR2D<Entity_kind::CELL, SourceMeshType, SourceStateType, TargetMes
           // polygon is non-convex because R2D can deal with it.
           auto sys = sourceMeshWrapper.mesh_get_coordinate_system();
           if (trg_convex) {
-            this_wt.weights = intersect_polys_r2d(source_poly, target_poly,
-                                                  num_tols_, true, sys);
+            this_wt.weights = intersect_polys_r2d<moment_order>(source_poly, target_poly,
+                                                                num_tols_, true, sys);
           } else {
             bool src_convex = poly2_is_convex(source_poly, num_tols_);
 
@@ -376,8 +368,8 @@ class IntersectR2D<Entity_kind::CELL, SourceMeshType, SourceStateType, TargetMes
             // If it is non-convex it will be triangulated and the triangles
             // intersected with the first polygon
             
-            this_wt.weights = intersect_polys_r2d(target_poly, source_poly,
-                                                  num_tols_, src_convex, sys);
+            this_wt.weights = intersect_polys_r2d<moment_order>(target_poly, source_poly,
+                                                                num_tols_, src_convex, sys);
           }
           
         } else {
@@ -385,34 +377,43 @@ class IntersectR2D<Entity_kind::CELL, SourceMeshType, SourceStateType, TargetMes
           // polygon approximation of this material in the cell
           // (obtained from interface reconstruction)
 
-          std::vector<Tangram::MatPoly<2>> matpolys =
-              cmp_ptrs[s]->get_matpolys(matid_);
+          this_wt.weights.resize(R2D_NUM_MOMENTS(moment_order), 0.0);
+
+          // material polygons are taken from the cache when available
+          // instead of being rebuilt for each target cell
+          auto const* cached =
+              matpoly_cache_ ? matpoly_cache_->find(s, matid_) : nullptr;
 
-          this_wt.weights.resize(3, 0.0);
-          for (auto& matpoly : matpolys) {
+          std::vector<std::vector<Wonton::Point<2>>> built_polys;
+          if (cached == nullptr) {
+            std::vector<Tangram::MatPoly<2>> matpolys =
+                cmp_ptrs[s]->get_matpolys(matid_);
+
+            for (auto& matpoly : matpolys) {
 
 #ifdef PORTAGE_DEBUG
-          // Lets check the volume of the source material polygon
-          std::vector<double> smom = matpoly.moments();
-          if (smom[0] < 0.0) {
-            std::stringstream sstr;
-            sstr << "In intersect_polys_r3d.h: " <<
-                "Material polygon for material " << matid_ << " in cell " <<
-                s << " has negative volume " << smom[0] << "\n";
-            throw std::runtime_error(sstr.str());
-          }
+              // Lets check the volume of the source material polygon
+              std::vector<double> smom = matpoly.moments();
+              if (smom[0] < 0.0) {
+                std::stringstream sstr;
+                sstr << "In intersect_polys_r3d.h: " <<
+                    "Material polygon for material " << matid_ << " in cell " <<
+                    s << " has negative volume " << smom[0] << "\n";
+                throw std::runtime_error(sstr.str());
+              }
 #endif
-            
-            std::vector<Wonton::Point<2>> source_poly = matpoly.points();
+              built_polys.emplace_back(matpoly.points());
+            }
+          }
 
-            auto sys = sourceMeshWrapper.mesh_get_coordinate_system();
-            std::vector<double> momvec = intersect_polys_r2d(source_poly,
-                                                             target_poly,
-                                                             num_tols_,
-                                                             trg_convex,
-                                                             sys);
+          auto sys = sourceMeshWrapper.mesh_get_coordinate_system();
+          auto const& source_polys = cached ? cached->polytopes : built_polys;
+          for (auto const& source_poly : source_polys) {
+            std::vector<double> momvec =
+                intersect_polys_r2d<moment_order>(source_poly, target_poly,
+                                                  num_tols_, trg_convex, sys);
 
-            for (int k = 0; k < 3; k++)
+            for (int k = 0; k < R2D_NUM_MOMENTS(moment_order); k++)
               this_wt.weights[k] += momvec[k];
           }
         }
@@ -447,8 +448,8 @@ class IntersectR2D<Entity_kind::CELL, SourceMeshType, SourceStateType, TargetMes
 
       auto sys = sourceMeshWrapper.mesh_get_coordinate_system();
       if (trg_convex) {
-        this_wt.weights = intersect_polys_r2d(source_poly, target_poly,
-                                              num_tols_, true, sys);
+        this_wt.weights = intersect_polys_r2d<moment_order>(source_poly, target_poly,
+                                                            num_tols_, true, sys);
       } else {
         bool src_convex = poly2_is_convex(source_poly, num_tols_);
 
@@ -457,8 +458,8 @@ class IntersectR2D<Entity_kind::CELL, SourceMeshType, SourceStateType, TargetMes
         // If it is non-convex it will be triangulated and the triangles
         // intersected with the first polygon
         
-        this_wt.weights = intersect_polys_r2d(target_poly, source_poly,
-                                              num_tols_, src_convex, sys);
+        this_wt.weights = intersect_polys_r2d<moment_order>(target_poly, source_poly,
+                                                            num_tols_, src_convex, sys);
       }        
 #endif
 
@@ -491,6 +492,7 @@ class IntersectR2D<Entity_kind::CELL, SourceMeshType, SourceStateType, TargetMes
   int matid_ = -1;
 #ifdef PORTAGE_HAS_TANGRAM
   std::shared_ptr<InterfaceReconstructor2D> interface_reconstructor;
+  std::shared_ptr<MatPolyCache<2>> matpoly_cache_;
 #endif
   NumericTolerances_t num_tols_;
 };  // class IntersectR2D
@@ -504,9 +506,11 @@ class IntersectR2D<Entity_kind::CELL, SourceMeshType, SourceStateType, TargetMes
 template <class SourceMeshType, class SourceStateType,
           class TargetMeshType,
           template <class, int, class, class> class InterfaceReconstructorType,
-          class Matpoly_Splitter, class Matpoly_Clipper>
+          class Matpoly_Splitter, class Matpoly_Clipper,
+          int moment_order>
 class IntersectR2D<Entity_kind::NODE, SourceMeshType, SourceStateType, TargetMeshType,
-                   InterfaceReconstructorType, Matpoly_Splitter, Matpoly_Clipper> {
+                   InterfaceReconstructorType, Matpoly_Splitter, Matpoly_Clipper,
+                   moment_order> {
 
 #ifdef PORTAGE_HAS_TANGRAM
   using InterfaceReconstructor2D =
@@ -545,6 +549,13 @@ class IntersectR2D<Entity_kind::NODE, SourceMeshType, SourceStateType, TargetMes
     matid_ = m;
   }
 
+  /// \brief Use precomputed dual cells of source and target nodes
+  /// instead of querying them from the mesh wrappers on each call
+
+  void set_dual_cell_cache(std::shared_ptr<DualCellCache<2>> cache) {
+    dual_cells_ = cache;
+  }
+
   /// \brief Intersect control volume of a target node with control volumes of
   /// a set of source nodes
   /// \param[in] tgt_node  Target mesh node whose control volume we consider
@@ -552,10 +563,17 @@ class IntersectR2D<Entity_kind::NODE, SourceMeshType, SourceStateType, TargetMes
   /// \return vector of Weights_t structure containing moments of intersection
 
   std::vector<Weights_t> operator() (int tgt_node, std::vector<int> const& src_nodes) const {
-    std::vector<Wonton::Point<2>> target_poly;
-    targetMeshWrapper.dual_cell_get_coordinates(tgt_node, &target_poly);
-    
-    bool trg_convex = poly2_is_convex(target_poly, num_tols_);
+    bool const cached = dual_cells_ and dual_cells_->has_sources()
+                        and dual_cells_->has_targets();
+
+    using Polygon = ConstArrayView<Wonton::Point<2>>;
+    std::vector<Wonton::Point<2>> target_buffer;
+    if (not cached)
+      targetMeshWrapper.dual_cell_get_coordinates(tgt_node, &target_buffer);
+
+    Polygon const target_poly = cached ? dual_cells_->target(tgt_node) : Polygon(target_buffer);
+    bool trg_convex = cached ? dual_cells_->target_convex(tgt_node)
+                             : poly2_is_convex(target_buffer, num_tols_);
 
 #ifdef PORTAGE_DEBUG
     if (targetMeshWrapper.num_entities(WEDGE, ALL) == 0) {
@@ -586,8 +604,11 @@ class IntersectR2D<Entity_kind::NODE, SourceMeshType, SourceStateType, TargetMes
     int ninserted = 0;
     for (int i = 0; i < nsrc; i++) {
       int s = src_nodes[i];
-      std::vector<Wonton::Point<2>> source_poly;
-      sourceMeshWrapper.dual_cell_get_coordinates(s, &source_poly);
+      std::vector<Wonton::Point<2>> source_buffer;
+      if (not cached)
+        sourceMeshWrapper.dual_cell_get_coordinates(s, &source_buffer);
+
+      Polygon const source_poly = cached ? dual_cells_->source(s) : Polygon(source_buffer);
 
 #ifdef PORTAGE_DEBUG
       if (sourceMeshWrapper.num_entities(WEDGE, ALL) == 0) {
@@ -615,18 +636,19 @@ class IntersectR2D<Entity_kind::NODE, SourceMeshType, SourceStateType, TargetMes
       Weights_t & this_wt = sources_and_weights[ninserted];
       this_wt.entityID = s;
       if (trg_convex)
-        this_wt.weights = intersect_polys_r2d(source_poly, target_poly,
-                                              num_tols_);
+        this_wt.weights = intersect_polys_r2d<moment_order>(source_poly, target_poly,
+                                                            num_tols_);
       else {
-        bool src_convex = poly2_is_convex(source_poly, num_tols_);
+        bool src_convex = cached ? dual_cells_->source_convex(s)
+                                 : poly2_is_convex(source_buffer, num_tols_);
 
         // flip the order of the polygons and indicate whether the second
         // polygon (source masquerading as the target) is non-convex or not
         // If it is non-convex it will be triangulated and the triangles
         // intersected with the first polygon
         
-        this_wt.weights = intersect_polys_r2d(target_poly, source_poly,
-                                              num_tols_, src_convex);
+        this_wt.weights = intersect_polys_r2d<moment_order>(target_poly, source_poly,
+                                                            num_tols_, src_convex);
       }        
 
       // Increment if vol of intersection > 0; otherwise, allow overwrite
@@ -653,6 +675,7 @@ class IntersectR2D<Entity_kind::NODE, SourceMeshType, SourceStateType, TargetMes
   std::shared_ptr<InterfaceReconstructor2D> interface_reconstructor;
 #endif
   NumericTolerances_t num_tols_;
+  std::shared_ptr<DualCellCache<2>> dual_cells_;
 };  // class IntersectR2D
 
 } // namespace Portage
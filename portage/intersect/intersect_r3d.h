@@ -23,6 +23,8 @@ extern "C" {
 #include "portage/support/portage.h"
 #include "portage/intersect/dummy_interface_reconstructor.h"
 #include "portage/intersect/intersect_polys_r3d.h"
+#include "portage/intersect/matpoly_cache.h"
+#include "portage/intersect/dual_cell_cache.h"
 
 #ifdef PORTAGE_HAS_TANGRAM
 #include "tangram/driver/CellMatPoly.h"
@@ -117,6 +119,10 @@ void throw_validity_error_3d(Wonton::Entity_kind ekind, int entity_id,
 // reconstruction procedure. Also, in 3D they are guaranteed to be
 // convex since a non-convex cell is decomposed into simplices and
 // then sliced by the interface plane.
+//
+// The 'moment_order' parameter sets the max degree of the intersection
+// moments: 1 (default) gives the volume and first moments, 2 also gives
+// the second moments needed for an exact third order remap.
 
 
 
@@ -125,7 +131,8 @@ template <Entity_kind on_what, class SourceMeshType,
           template <class, int, class, class> class InterfaceReconstructorType =
           DummyInterfaceReconstructor,
           class Matpoly_Splitter = void,
-          class Matpoly_Clipper = void>
+          class Matpoly_Clipper = void,
+          int moment_order = 1>
 class IntersectR3D {
 
 #ifdef PORTAGE_HAS_TANGRAM
@@ -201,10 +208,12 @@ class IntersectR3D {
 template <class SourceMeshType, class SourceStateType,
           class TargetMeshType,
           template <class, int, class, class> class InterfaceReconstructorType,
-          class Matpoly_Splitter, class Matpoly_Clipper>
+          class Matpoly_Splitter, class Matpoly_Clipper,
+          int moment_order>
 class IntersectR3D<Entity_kind::CELL, SourceMeshType, SourceStateType, TargetMeshType,
                    InterfaceReconstructorType,
-                   Matpoly_Splitter, Matpoly_Clipper> {
+                   Matpoly_Splitter, Matpoly_Clipper,
+                   moment_order> {
 
 #ifdef PORTAGE_HAS_TANGRAM
   using InterfaceReconstructor3D =
@@ -246,6 +255,14 @@ class IntersectR3D<Entity_kind::CELL, SourceMeshType, SourceStateType, TargetMes
     matid_ = m;
   }
 
+#ifdef PORTAGE_HAS_TANGRAM
+  /// \brief Set the cache of material polyhedra of mixed source cells
+
+  void set_matpoly_cache(std::shared_ptr<MatPolyCache<3>> cache) {
+    matpoly_cache_ = cache;
+  }
+#endif
+
   /// \brief Intersect a cell with a set of candidate cells
   /// \param[in] tgt_cell cell of target mesh to intersect
   /// \param[in] src_cells list of source cells to intersect against
@@ -358,37 +375,50 @@ class IntersectR3D<Entity_kind::CELL, SourceMeshType, SourceStateType, TargetMes
           }
 #endif
 
-          this_wt.weights = intersect_polys_r3d(srcpoly, target_tet_coords,
-                                                num_tols_);
+          this_wt.weights = intersect_polys_r3d<moment_order>(srcpoly, target_tet_coords,
+                                                              num_tols_);
 
         } else if (cmp_ptrs[s]->is_cell_material(matid_)) {
           // mixed cell containing this material - intersect with
           // polygon approximation of this material in the cell
           // (obtained from interface reconstruction)
 
-          std::vector<Tangram::MatPoly<3>> matpolys =
-              cmp_ptrs[s]->get_matpolys(matid_);
+          this_wt.weights.resize(R3D_NUM_MOMENTS(moment_order), 0.0);
+
+          // faceted material polyhedra are taken from the cache when
+          // available instead of being rebuilt for each target cell
+          auto const* cached =
+              matpoly_cache_ ? matpoly_cache_->find(s, matid_) : nullptr;
 
-          this_wt.weights.resize(4,0.0);
-          for (const auto& matpoly : matpolys) {
+          std::vector<facetedpoly_t> built_polys;
+          if (cached == nullptr) {
+            std::vector<Tangram::MatPoly<3>> matpolys =
+                cmp_ptrs[s]->get_matpolys(matid_);
+
+            for (const auto& matpoly : matpolys) {
 
 #ifdef PORTAGE_DEBUG
-          // Lets check the volume of the source material polyhedron
-
-          std::vector<double> smom = matpoly.moments();
-          if (smom[0] < 0.0) {
-            std::stringstream sstr;
-            sstr << "In intersect_polys_r3d.h: " <<
-                "Material polygon for material " << matid_ << " in cell " <<
-                s << " has negative volume " << smom[0] << "\n";
-            throw std::runtime_error(sstr.str());
-          }
+              // Lets check the volume of the source material polyhedron
+
+              std::vector<double> smom = matpoly.moments();
+              if (smom[0] < 0.0) {
+                std::stringstream sstr;
+                sstr << "In intersect_polys_r3d.h: " <<
+                    "Material polygon for material " << matid_ << " in cell " <<
+                    s << " has negative volume " << smom[0] << "\n";
+                throw std::runtime_error(sstr.str());
+              }
 #endif
-            
-            facetedpoly_t srcpoly = get_faceted_matpoly(matpoly);
-            std::vector<double> momvec = intersect_polys_r3d(srcpoly,
-                                            target_tet_coords, num_tols_);
-            for (int k = 0; k < 4; k++)
+              built_polys.emplace_back(get_faceted_matpoly(matpoly));
+            }
+          }
+
+          auto const& srcpolys = cached ? cached->polytopes : built_polys;
+          for (auto const& srcpoly : srcpolys) {
+            std::vector<double> momvec =
+                intersect_polys_r3d<moment_order>(srcpoly, target_tet_coords,
+                                                  num_tols_);
+            for (int k = 0; k < R3D_NUM_MOMENTS(moment_order); k++)
               this_wt.weights[k] += momvec[k];
           }
         }
@@ -425,8 +455,8 @@ class IntersectR3D<Entity_kind::CELL, SourceMeshType, SourceStateType, TargetMes
       }        
 #endif
 
-      this_wt.weights = intersect_polys_r3d(srcpoly, target_tet_coords,
-                                            num_tols_);
+      this_wt.weights = intersect_polys_r3d<moment_order>(srcpoly, target_tet_coords,
+                                                          num_tols_);
 #endif
 
       // Increment if vol of intersection > 0; otherwise, allow overwrite
@@ -450,6 +480,7 @@ class IntersectR3D<Entity_kind::CELL, SourceMeshType, SourceStateType, TargetMes
   TargetMeshType const & targetMeshWrapper;
 #ifdef PORTAGE_HAS_TANGRAM
   std::shared_ptr<InterfaceReconstructor3D> interface_reconstructor;
+  std::shared_ptr<MatPolyCache<3>> matpoly_cache_;
 #endif
   bool rectangular_mesh_ = false;
   int matid_ = -1;
@@ -462,10 +493,12 @@ class IntersectR3D<Entity_kind::CELL, SourceMeshType, SourceStateType, TargetMes
 template <class SourceMeshType, class SourceStateType,
           class TargetMeshType,
           template <class, int, class, class> class InterfaceReconstructorType,
-          class Matpoly_Splitter, class Matpoly_Clipper>
+          class Matpoly_Splitter, class Matpoly_Clipper,
+          int moment_order>
 class IntersectR3D<Entity_kind::NODE, SourceMeshType, SourceStateType, TargetMeshType,
                    InterfaceReconstructorType,
-                   Matpoly_Splitter, Matpoly_Clipper> {
+                   Matpoly_Splitter, Matpoly_Clipper,
+                   moment_order> {
 
 #ifdef PORTAGE_HAS_TANGRAM
   using InterfaceReconstructor3D =
@@ -506,6 +539,13 @@ class IntersectR3D<Entity_kind::NODE, SourceMeshType, SourceStateType, TargetMes
     matid_ = m;
   }
 
+  /// \brief Use precomputed dual cells of source and target nodes
+  /// instead of querying them from the mesh wrappers on each call
+
+  void set_dual_cell_cache(std::shared_ptr<DualCellCache<3>> cache) {
+    dual_cells_ = cache;
+  }
+
   /// \brief Intersect a control volume corresponding to a target node
   /// with a set of control volumes corresponding to candidate source
   /// nodes
@@ -517,17 +557,16 @@ class IntersectR3D<Entity_kind::NODE, SourceMeshType, SourceStateType, TargetMes
   std::vector<Weights_t> operator() (const int tgt_node,
                                      const std::vector<int>& src_nodes) const {
 
-    // for debug
-    Point<3> tgtxyz;
-    targetMeshWrapper.node_get_coordinates(tgt_node, &tgtxyz);
-
-    std::vector<std::array<Point<3>, 4>> target_tet_coords;
+    bool const cached = dual_cells_ and dual_cells_->has_sources()
+                        and dual_cells_->has_targets();
 
     // We should avoid any decomposition for dual cells of a
     // rectangular mesh but for now we will decompose the target all
     // the time
 
-    targetMeshWrapper.dual_wedges_get_coordinates(tgt_node, &target_tet_coords);
+    std::vector<std::array<Point<3>, 4>> target_buffer;
+    if (not cached)
+      targetMeshWrapper.dual_wedges_get_coordinates(tgt_node, &target_buffer);
 
 #ifdef PORTAGE_DEBUG
     if (targetMeshWrapper.num_entities(WEDGE, ALL) == 0) {
@@ -561,9 +600,10 @@ class IntersectR3D<Entity_kind::NODE, SourceMeshType, SourceStateType, TargetMes
     for (int i = 0; i < nsrc; i++) {
       int s = src_nodes[i];
 
-      facetedpoly_t srcpoly;
-      sourceMeshWrapper.dual_cell_get_facetization(s, &srcpoly.facetpoints,
-                                                   &srcpoly.points);
+      facetedpoly_t source_buffer;
+      if (not cached)
+        sourceMeshWrapper.dual_cell_get_facetization(s, &source_buffer.facetpoints,
+                                                     &source_buffer.points);
 
       
 #ifdef PORTAGE_DEBUG
@@ -595,8 +635,10 @@ class IntersectR3D<Entity_kind::NODE, SourceMeshType, SourceStateType, TargetMes
       
       Weights_t & this_wt = sources_and_weights[ninserted];
       this_wt.entityID = s;
-      this_wt.weights = intersect_polys_r3d(srcpoly, target_tet_coords,
-                                            num_tols_);
+      this_wt.weights = cached
+        ? intersect_polys_r3d<moment_order>(dual_cells_->source(s),
+                                            dual_cells_->target(tgt_node), num_tols_)
+        : intersect_polys_r3d<moment_order>(source_buffer, target_buffer, num_tols_);
 
       // Increment if vol of intersection > 0; otherwise, allow overwrite
       if (!this_wt.weights.empty() && this_wt.weights[0] > 0.0)
@@ -623,6 +665,7 @@ class IntersectR3D<Entity_kind::NODE, SourceMeshType, SourceStateType, TargetMes
   bool rectangular_mesh_ = false;
   int matid_ = -1;
   NumericTolerances_t num_tols_ {};
+  std::shared_ptr<DualCellCache<3>> dual_cells_;
 };  // class IntersectR3D
 
 
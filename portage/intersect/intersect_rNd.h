@@ -16,7 +16,15 @@ Please see the license file at the root of this repository, or at:
 
 namespace Portage {
 
-template <int dim,
+/// \brief Dimension-independent R2D/R3D intersector computing the
+/// intersection moments up to a given order.
+///
+/// Drivers expect intersectors templated on the dimension first, so
+/// use it through the 'IntersectRnD' (first moments) or
+/// 'IntersectRnDSecondMoments' (first and second moments) aliases.
+
+template <int moment_order,
+          int dim,
           Wonton::Entity_kind ONWHAT,
           class SourceMeshType,
           class SourceStateType,
@@ -25,7 +33,7 @@ template <int dim,
           DummyInterfaceReconstructor,
           class MatPoly_Splitter = void,
           class MatPoly_Clipper = void>
-class IntersectRnD {
+class IntersectRnDMoments {
  public:
   using Intersector =
       typename std::conditional<dim == 2,
@@ -35,14 +43,16 @@ class IntersectRnD {
                                              TargetMeshType,
                                              InterfaceReconstructorType,
                                              MatPoly_Splitter,
-                                             MatPoly_Clipper>,
+                                             MatPoly_Clipper,
+                                             moment_order>,
                                 IntersectR3D<ONWHAT,
                                              SourceMeshType,
                                              SourceStateType,
                                              TargetMeshType,
                                              InterfaceReconstructorType,
                                              MatPoly_Splitter,
-                                             MatPoly_Clipper>
+                                             MatPoly_Clipper,
+                                             moment_order>
                                 >::type;
 
 #ifdef PORTAGE_HAS_TANGRAM
@@ -53,21 +63,21 @@ class IntersectRnD {
                       SourceMeshType,
                       MatPoly_Splitter, MatPoly_Clipper>;
 
-  IntersectRnD(SourceMeshType const & source_mesh,
-               SourceStateType const & source_state,
-               TargetMeshType const & target_mesh,
-               NumericTolerances_t num_tols,
-               std::shared_ptr<InterfaceReconstructor> ir)
+  IntersectRnDMoments(SourceMeshType const & source_mesh,
+                      SourceStateType const & source_state,
+                      TargetMeshType const & target_mesh,
+                      NumericTolerances_t num_tols,
+                      std::shared_ptr<InterfaceReconstructor> ir)
       : intersector_(source_mesh, source_state, target_mesh, num_tols, ir) {}
 
 #endif
 
   /// Constructor WITHOUT interface reconstructor
 
-  IntersectRnD(SourceMeshType const & source_mesh,
-               SourceStateType const & source_state,
-               TargetMeshType const & target_mesh,
-               NumericTolerances_t num_tols)
+  IntersectRnDMoments(SourceMeshType const & source_mesh,
+                      SourceStateType const & source_state,
+                      TargetMeshType const & target_mesh,
+                      NumericTolerances_t num_tols)
       : intersector_(source_mesh, source_state, target_mesh, num_tols) {}
 
   /// \brief Set the source mesh material that we have to intersect against
@@ -76,6 +86,14 @@ class IntersectRnD {
     intersector_.set_material(m);
   }
 
+#ifdef PORTAGE_HAS_TANGRAM
+  /// \brief Set the cache of material polytopes of mixed source cells
+  inline
+  void set_matpoly_cache(std::shared_ptr<MatPolyCache<dim>> cache) {
+    attach_matpoly_cache(intersector_, cache);
+  }
+#endif
+
   /// \brief Intersect control volume of a target entity with control volumes of a set of source entities
   /// \param[in] tgt_entity  Entity of target mesh to intersect
   /// \param[in] src_entities Entities of source mesh to intersect against
@@ -91,6 +109,44 @@ class IntersectRnD {
   Intersector intersector_;
 };
 
+/// \brief R2D/R3D intersector computing volumes and first moments
+
+template <int dim,
+          Wonton::Entity_kind ONWHAT,
+          class SourceMeshType,
+          class SourceStateType,
+          class TargetMeshType,
+          template<class, int, class, class> class InterfaceReconstructorType =
+          DummyInterfaceReconstructor,
+          class MatPoly_Splitter = void,
+          class MatPoly_Clipper = void>
+using IntersectRnD = IntersectRnDMoments<1, dim, ONWHAT,
+                                         SourceMeshType, SourceStateType,
+                                         TargetMeshType,
+                                         InterfaceReconstructorType,
+                                         MatPoly_Splitter, MatPoly_Clipper>;
+
+/// \brief R2D/R3D intersector also computing second moments, which
+/// are used by the third order interpolator to integrate its quadratic
+/// reconstruction exactly over each intersection.
+
+template <int dim,
+          Wonton::Entity_kind ONWHAT,
+          class SourceMeshType,
+          class SourceStateType,
+          class TargetMeshType,
+          template<class, int, class, class> class InterfaceReconstructorType =
+          DummyInterfaceReconstructor,
+          class MatPoly_Splitter = void,
+          class MatPoly_Clipper = void>
+using IntersectRnDSecondMoments = IntersectRnDMoments<2, dim, ONWHAT,
+                                                      SourceMeshType,
+                                                      SourceStateType,
+                                                      TargetMeshType,
+                                                      InterfaceReconstructorType,
+                                                      MatPoly_Splitter,
+                                                      MatPoly_Clipper>;
+
 }
 
 #endif
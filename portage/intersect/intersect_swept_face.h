@@ -205,6 +205,12 @@ namespace Portage {
     using InterfaceReconstructor2D = Tangram::Driver<
       InterfaceReconstructor, 2, SourceMesh,
       Matpoly_Splitter, Matpoly_Clipper>;
+
+    // plane clipping a swept region off a face group of a mixed cell
+    struct FaceGroupCut {
+      int face = -1;
+      Tangram::Plane_t<2> plane {};
+    };
 #endif
 
   public:
@@ -328,6 +334,51 @@ namespace Portage {
       return std::vector<double>{ area, area * centroid[0], area * centroid[1] };
     }
 
+    /**
+     * @brief Compute the moments of the polygon swept by a cell edge.
+     *
+     * The edge nodes are ordered such that the swept area is positive
+     * when the swept polygon lies outside the cell and negative otherwise.
+     *
+     * @param edge: index of the edge.
+     * @param dir: orientation of the edge with respect to the cell.
+     * @return swept polygon moments.
+     */
+    std::vector<double> compute_swept_moments(int edge, int dir) const {
+
+      std::vector<int> nodes;
+      source_mesh_.face_get_nodes(edge, &nodes);
+
+#ifndef NDEBUG
+      // ensure that we have the same nodal indices for source and target.
+      std::vector<int> target_nodes;
+      target_mesh_.face_get_nodes(edge, &target_nodes);
+      int const nb_source_nodes = nodes.size();
+      int const nb_target_nodes = target_nodes.size();
+
+      assert(nb_source_nodes == nb_target_nodes);
+      for (int j = 0; j < nb_target_nodes; ++j) {
+        assert(nodes[j] == target_nodes[j]);
+      }
+#endif
+
+      std::vector<Wonton::Point<2>> swept_polygon(4);
+
+      // if the edge has the same orientation as the cell, then reverse
+      // its nodes order such that we have a positive swept volume on
+      // outside and negative swept volume on inside.
+      // otherwise keep the same nodal order.
+      unsigned const j = (dir > 0 ? 1 : 0);
+      unsigned const k = j ^ 1;
+
+      source_mesh_.node_get_coordinates(nodes[j], swept_polygon.data());
+      source_mesh_.node_get_coordinates(nodes[k], swept_polygon.data()+1);
+      target_mesh_.node_get_coordinates(nodes[k], swept_polygon.data()+2);
+      target_mesh_.node_get_coordinates(nodes[j], swept_polygon.data()+3);
+
+      return compute_moments_divergence_theorem(swept_polygon);
+    }
+
     /**
      * @brief Check that given swept face centroid lies within the given cell.
      *
@@ -383,6 +434,40 @@ namespace Portage {
     void toggle_displacement_check(bool enable) { displacement_check = enable; }
 
 #ifdef PORTAGE_HAS_TANGRAM
+    /**
+     * @brief Precompute the cutting planes of the face groups of mixed cells.
+     *
+     * The plane clipping a swept region off a face group only depends on
+     * the geometry, not on the material. Hence it is computed once here for
+     * all materials and reused by 'compute_face_group_moments'. All faces of
+     * a cell are processed together so that the cell matpoly is built only
+     * once, and cells are processed in parallel. The planes are shared by
+     * copies of this intersector. Faces for which no valid plane is found
+     * are left to 'compute_face_group_moments' which reports the error.
+     */
+    void cache_face_group_cuts() {
+
+      if (interface_reconstructor == nullptr or face_group_cuts_ != nullptr)
+        return;
+
+      auto const& cmp_ptrs = interface_reconstructor->cell_matpoly_ptrs();
+      int const nb_ptrs = cmp_ptrs.size();
+      int const nb_cells = source_mesh_.num_entities(Entity_kind::CELL,
+                                                     Entity_type::ALL);
+
+      auto cuts = std::make_shared<std::vector<std::vector<FaceGroupCut>>>(nb_cells);
+
+      Wonton::for_each(source_mesh_.begin(Entity_kind::CELL, Entity_type::ALL),
+                       source_mesh_.end(Entity_kind::CELL, Entity_type::ALL),
+                       [&](int c) {
+                         if (c < nb_ptrs and cmp_ptrs[c] != nullptr
+                             and cmp_ptrs[c]->num_materials() > 1)
+                           (*cuts)[c] = compute_face_group_cuts(c);
+                       });
+
+      face_group_cuts_ = cuts;
+    }
+
     /**
      * @brief For a given cell and its face finds the moments associated with the
      * intersection of the swept region and MatPoly's with material_id_ that belong
@@ -408,43 +493,35 @@ namespace Portage {
       if (swept_volume < vol_tol) {
         throw std::runtime_error("Volume taken out of the face group shold NOT be below the volume tolerance used during interface reconstruction!");
       }
-      
-      std::vector<int> cfaces, cfdirs;
-      source_mesh_.cell_get_faces_and_dirs(cell_id, &cfaces, &cfdirs);
 
-      int cface_id = std::distance(
-        cfaces.begin(), std::find(cfaces.begin(), cfaces.end(), face_group_id));
-#ifndef NDEBUG
-      //Face group should be associated with one of the cell's faces
-      int nfaces = cfaces.size();
-      assert(cface_id != nfaces);
-#endif
-
-      //Create a MatPoly for the cell
-      Tangram::MatPoly<2> cell_mp;
-      Tangram::cell_get_matpoly(source_mesh_, cell_id, &cell_mp, dst_tol);
-      cell_mp.set_mat_id(0);
-      //Get the face normal and MatPoly's in the face's group
-      std::vector<Tangram::MatPoly<2>> face_group_polys;
       Tangram::Plane_t<2> cutting_plane;
-      //Normals to MatPoly faces always point outward, so we have to reverse them
-      //in order to clip the corresponding face group
-      cutting_plane.normal = 
-        -cell_mp.face_normal_and_group(cface_id, face_group_id, &face_group_polys);
 
-      //Find the cutting distance for the given swept volume
-      Tangram::CuttingDistanceSolver<2, Matpoly_Clipper> cds(face_group_polys,
-        cutting_plane.normal, ims_tols[0], true);
+      FaceGroupCut const* cached = find_face_group_cut(cell_id, face_group_id);
+      if (cached != nullptr) {
+        cutting_plane = cached->plane;
+      } else {
+        std::vector<int> cfaces, cfdirs;
+        source_mesh_.cell_get_faces_and_dirs(cell_id, &cfaces, &cfdirs);
 
-      cds.set_target_volume(swept_volume);
-      std::vector<double> cds_res = cds();
+        int cface_id = std::distance(
+          cfaces.begin(), std::find(cfaces.begin(), cfaces.end(), face_group_id));
+#ifndef NDEBUG
+        //Face group should be associated with one of the cell's faces
+        int nfaces = cfaces.size();
+        assert(cface_id != nfaces);
+#endif
 
-      //Check if we had enough volume in the face group
-      if (cds_res[1] < swept_volume - vol_tol) {
-        throw std::runtime_error("Mesh displacement is too big for the implemented swept-face method");
-      }
+        //Create a MatPoly for the cell
+        Tangram::MatPoly<2> cell_mp;
+        Tangram::cell_get_matpoly(source_mesh_, cell_id, &cell_mp, dst_tol);
+        cell_mp.set_mat_id(0);
 
-      cutting_plane.dist2origin = cds_res[0];
+        //Check if we had enough volume in the face group
+        if (!solve_cutting_plane(cell_mp, cface_id, face_group_id,
+                                 swept_volume, &cutting_plane)) {
+          throw std::runtime_error("Mesh displacement is too big for the implemented swept-face method");
+        }
+      }
 
       //Get the face group MatPoly's with material_id_ from the reconstructor
       Tangram::CellMatPoly<2> const& cellmatpoly =
@@ -460,6 +537,106 @@ namespace Portage {
 
       return moments;
     }
+
+  private:
+
+    /**
+     * @brief Find the plane clipping the given volume off a face group.
+     *
+     * @param cell_mp: matpoly of the whole cell.
+     * @param cface_id: local index of the face in the cell.
+     * @param face_group_id: index of the cell's face group.
+     * @param swept_volume: volume to clip off the face group.
+     * @param cutting_plane: the resulting plane.
+     * @return true if the face group contains enough volume.
+     */
+    bool solve_cutting_plane(Tangram::MatPoly<2> const& cell_mp,
+                             int cface_id, int face_group_id,
+                             double swept_volume,
+                             Tangram::Plane_t<2>* cutting_plane) const {
+
+      const std::vector<Tangram::IterativeMethodTolerances_t>& ims_tols =
+        interface_reconstructor->iterative_methods_tolerances();
+      double vol_tol = ims_tols[0].fun_eps;
+
+      //Get the face normal and MatPoly's in the face's group
+      std::vector<Tangram::MatPoly<2>> face_group_polys;
+      //Normals to MatPoly faces always point outward, so we have to reverse them
+      //in order to clip the corresponding face group
+      cutting_plane->normal =
+        -cell_mp.face_normal_and_group(cface_id, face_group_id, &face_group_polys);
+
+      //Find the cutting distance for the given swept volume
+      Tangram::CuttingDistanceSolver<2, Matpoly_Clipper> cds(face_group_polys,
+        cutting_plane->normal, ims_tols[0], true);
+
+      cds.set_target_volume(swept_volume);
+      std::vector<double> cds_res = cds();
+
+      cutting_plane->dist2origin = cds_res[0];
+      return cds_res[1] >= swept_volume - vol_tol;
+    }
+
+    /**
+     * @brief Compute the cutting planes of the face groups of a mixed cell
+     *        through which it loses volume.
+     *
+     * @param cell_id: index of the cell.
+     * @return the cutting plane of each such face.
+     */
+    std::vector<FaceGroupCut> compute_face_group_cuts(int cell_id) const {
+
+      const std::vector<Tangram::IterativeMethodTolerances_t>& ims_tols =
+        interface_reconstructor->iterative_methods_tolerances();
+      double dst_tol = ims_tols[0].arg_eps;
+      double vol_tol = ims_tols[0].fun_eps;
+
+      std::vector<int> cfaces, cfdirs;
+      source_mesh_.cell_get_faces_and_dirs(cell_id, &cfaces, &cfdirs);
+      int const nfaces = cfaces.size();
+
+      std::vector<FaceGroupCut> cuts;
+      Tangram::MatPoly<2> cell_mp;
+      bool cell_mp_built = false;
+
+      for (int i = 0; i < nfaces; ++i) {
+        // only swept regions lying inside the cell are clipped off its face groups
+        double const swept_volume = -compute_swept_moments(cfaces[i], cfdirs[i])[0];
+        if (swept_volume < num_tols_.min_absolute_volume or swept_volume < vol_tol)
+          continue;
+
+        // the cell matpoly is shared by all its faces
+        if (not cell_mp_built) {
+          Tangram::cell_get_matpoly(source_mesh_, cell_id, &cell_mp, dst_tol);
+          cell_mp.set_mat_id(0);
+          cell_mp_built = true;
+        }
+
+        FaceGroupCut cut;
+        cut.face = cfaces[i];
+        if (solve_cutting_plane(cell_mp, i, cfaces[i], swept_volume, &cut.plane))
+          cuts.emplace_back(cut);
+      }
+      return cuts;
+    }
+
+    /**
+     * @brief Retrieve the precomputed cutting plane of a face group.
+     *
+     * @param cell_id: index of the cell.
+     * @param face_group_id: index of the cell's face group.
+     * @return the cached cut or nullptr if not available.
+     */
+    FaceGroupCut const* find_face_group_cut(int cell_id, int face_group_id) const {
+      if (face_group_cuts_ == nullptr)
+        return nullptr;
+      for (auto const& cut : (*face_group_cuts_)[cell_id])
+        if (cut.face == face_group_id)
+          return &cut;
+      return nullptr;
+    }
+
+  public:
 #endif
 
     /**
@@ -527,7 +704,7 @@ namespace Portage {
 #endif
 
       // Step 2: Obtain all facets and normals of the source cell
-      std::vector<int> edges, dirs, nodes;
+      std::vector<int> edges, dirs;
 
       // retrieve current source cell faces/edges and related directions
       source_mesh_.cell_get_faces_and_dirs(source_id, &edges, &dirs);
@@ -535,7 +712,7 @@ namespace Portage {
 
 #ifndef NDEBUG
       // ensure that we have the same face/edge index for source and target.
-      std::vector<int> target_edges, target_dirs, target_nodes;
+      std::vector<int> target_edges, target_dirs;
       target_mesh_.cell_get_faces_and_dirs(target_id, &target_edges, &target_dirs);
       int const nb_target_edges = target_edges.size();
 
@@ -548,39 +725,9 @@ namespace Portage {
       // Step 3: Main loop over all facets of the source cell
       for (int i = 0; i < nb_edges; ++i) {
 
-        // step 3a: retrieve nodes and reorder them according to edge direction
-        nodes.clear();
-        source_mesh_.face_get_nodes(edges[i], &nodes);
-
-#ifndef NDEBUG
-        // ensure that we have the same nodal indices for source and target.
-        target_mesh_.face_get_nodes(target_edges[i], &target_nodes);
-        int const nb_source_nodes = nodes.size();
-        int const nb_target_nodes = target_nodes.size();
-
-        assert(nb_source_nodes == nb_target_nodes);
-        for (int j = 0; j < nb_target_nodes; ++j) {
-          assert(nodes[j] == target_nodes[j]);
-        }
-#endif
-
-        // step 3b: construct the swept face polygon
-        std::vector<Wonton::Point<2>> swept_polygon(4);
-
-        // if the edge has the same orientation as the cell, then reverse
-        // its nodes order such that we have a positive swept volume on
-        // outside and negative swept volume on inside.
-        // otherwise keep the same nodal order.
-        unsigned const j = (dirs[i] > 0 ? 1 : 0);
-        unsigned const k = j ^ 1;
-
-        source_mesh_.node_get_coordinates(nodes[j], swept_polygon.data());
-        source_mesh_.node_get_coordinates(nodes[k], swept_polygon.data()+1);
-        target_mesh_.node_get_coordinates(nodes[k], swept_polygon.data()+2);
-        target_mesh_.node_get_coordinates(nodes[j], swept_polygon.data()+3);
-
-        // step 3c: compute swept polygon moment using divergence theorem
-        auto moments = compute_moments_divergence_theorem(swept_polygon);
+        // step 3a-c: construct the swept face polygon according to the
+        // edge direction and compute its moments.
+        auto moments = compute_swept_moments(edges[i], dirs[i]);
 
         // step 3d: add the source cells and their correct swept-moments to 
         // the weights vector.  Approaches to compute the amount
@@ -678,6 +825,7 @@ namespace Portage {
     bool displacement_check = false;
 #ifdef PORTAGE_HAS_TANGRAM
     std::shared_ptr<InterfaceReconstructor2D> interface_reconstructor;
+    std::shared_ptr<std::vector<std::vector<FaceGroupCut>>> face_group_cuts_;
 #endif
   }; // class IntersectSweptFace::2D::CELL
 
@@ -708,6 +856,12 @@ namespace Portage {
       InterfaceReconstructor, 3, SourceMesh,
       Matpoly_Splitter, Matpoly_Clipper
     >;
+
+    // plane clipping a swept region off a face group of a mixed cell
+    struct FaceGroupCut {
+      int face = -1;
+      Tangram::Plane_t<3> plane {};
+    };
 #endif
 
     using Polyhedron = Wonton::Polytope<3>;
@@ -833,6 +987,130 @@ namespace Portage {
                                  centroid[2] * volume};
     }
 
+    /**
+     * @brief Compute the moments of the polyhedron swept by a cell face.
+     *
+     * The face nodes are ordered such that the swept volume is positive
+     * when the swept polyhedron lies outside the cell and negative otherwise.
+     *
+     * @param face: index of the face.
+     * @param dir: orientation of the face with respect to the cell.
+     * @return swept polyhedron moments.
+     */
+    std::vector<double> compute_swept_moments(int face, int dir) const {
+
+      // step 0: retrieve nodes and reorder them according to face orientation
+      std::vector<int> nodes;
+      source_mesh_.face_get_nodes(face, &nodes);
+
+      int const nb_face_nodes = nodes.size();
+      int const nb_poly_nodes = 2 * nb_face_nodes;
+      int const nb_poly_faces = nb_poly_nodes + 2;
+
+#ifndef NDEBUG
+      // ensure that we have the same nodal indices for source and target.
+      std::vector<int> target_nodes;
+      target_mesh_.face_get_nodes(face, &target_nodes);
+      int const nb_source_nodes = nodes.size();
+      int const nb_target_nodes = target_nodes.size();
+
+      assert(nb_source_nodes == nb_target_nodes);
+      for (int j = 0; j < nb_target_nodes; ++j) {
+        assert(nodes[j] == target_nodes[j]);
+      }
+#endif
+
+      /* step 1: construct the swept volume polyhedron which can be:
+        * - a prism for a triangular face,
+        * - a hexahedron for a quadrilateral face,
+        * - a (n+2)-face polyhedron for an arbitrary n-polygon.
+        */
+      std::vector<Wonton::Point<3>> swept_poly_coords(nb_poly_nodes);
+      std::vector<std::vector<int>> swept_poly_faces(nb_poly_faces);
+
+      /* the swept polyhedron must be formed in a way that the vertices of
+        * each of its faces are ordered such that their normals outside that
+        * swept volume - this is necessarily true except for the original face
+        * inherited from the cell itself.
+        * for this face, if the ordering of its vertices is such that the normal
+        * points out of the cell, then the normal points into the swept volume.
+        * in such a case, the vertex ordering must be reversed.
+        *
+        *   source hex        target hex       face swept polyhedron:
+        *                     7'......6'
+        *                      .:    .:             4'......5'
+        *    7______6         . :   . :             /:    /:
+        *    /|    /|      4'...:..5' :            / :   / :
+        *   / |   / |       :   :..:..2'          /  :  /  :  
+        * 4 __|__5  |       :  .   :  .         4____:_5...:
+        * |   3__|__2       : .    : .          |   /0'|  /1'
+        * |  /   |  /       :......:            |  /   | /
+        * | /    | /        0'     1'           | /    |/
+        * |/_____|/                             |/_____/
+        * 0      1                              0      1
+        *                                 ∙dirs[f] > 0: [4,5,1,0,4',5',1',0']
+        *                                 ∙dirs[f] < 0: [0,1,5,4,0',1',5',4']
+        */
+      bool const outward_normal = dir > 0;
+
+      for (int current = 0; current < nb_face_nodes; ++current) {
+        int const reverse = (nb_face_nodes - 1) - current;
+        int const index   = (outward_normal ? reverse : current);
+        int const offset  = current + nb_face_nodes;
+        source_mesh_.node_get_coordinates(nodes[index], swept_poly_coords.data() + current);
+        target_mesh_.node_get_coordinates(nodes[index], swept_poly_coords.data() + offset);
+      }
+
+      /* now build the swept polyhedron faces, which vertices are indexed
+        * RELATIVELY to the polyhedron vertices list.
+        * - first allocate memory for vertices list of each face.
+        * - then add the original face and its twin induced by sweeping.
+        * - eventually construct the other faces induced by edge sweeping.
+        */
+      for (int current = 0; current < nb_poly_faces; ++current) {
+        // for each twin face induced by sweeping, its number of vertices is
+        // exactly that of the current cell face, whereas the number of
+        // vertices of the other faces is exactly 4.
+        int const size = (current < 2 ? nb_face_nodes : 4);
+        swept_poly_faces[current].resize(size);
+      }
+
+
+      /* swept polyhedron face construction rules:
+        *
+        *       3'_____2'     n_poly_faces: 2 + n_face_edges = 2 + 4 = 6.
+        *       /|    /|      n_poly_nodes: 2 * n_face_edges = 2 * 4 = 8 = n.
+        *      / |   / |      ordered vertex list: [3,2,1,0,3',2',1',0']
+        *     /  |__/__|
+        *    /  /  /  / 1'             absolute         relative
+        *  3___/_2/  /        ∙f[0]: (3 |2 |1 |0 )      (0,1,2,3)
+        *  |  /  |  /         ∙f[1]: (3'|2'|1'|0')      (4,5,6,7)
+        *  | /   | /          ∙f[2]: (3 |3'|2'|2 )  =>  (0,4,5,1)
+        *  |/____|/           ∙f[3]: (2 |2'|1'|1 )      (1,5,6,2)
+        *  0     1            ∙f[4]: (1 |1'|0'|0 )      (2,6,7,3)
+        *                     ∙f[5]: (0 |0'|3'|3 )      (3,7,4,0)
+        *
+        *  let m = n/2 with n the number of polyhedron vertices.
+        *  - twin faces: [0, m-1] and [m-1, n].
+        *  - side faces: [i, i+m, ((i+1) % m)+m, (i+1) % m]
+        */
+      for (int current = 0; current < nb_face_nodes; ++current) {
+        // a) set twin faces vertices
+        swept_poly_faces[0][current] = current;
+        swept_poly_faces[1][current] = nb_poly_nodes - current - 1;
+
+        // b) set side faces vertices while keeping them counterclockwise.
+        int const index = current + 2;
+        swept_poly_faces[index][0] = current;
+        swept_poly_faces[index][3] = (current + 1) % nb_face_nodes;
+        swept_poly_faces[index][1] = swept_poly_faces[index][0] + nb_face_nodes;
+        swept_poly_faces[index][2] = swept_poly_faces[index][3] + nb_face_nodes;
+      }
+
+      /* step 2: compute swept polygon moments using divergence theorem */
+      return compute_moments(swept_poly_coords, swept_poly_faces);
+    }
+
     /**
      * @brief Verify if the displacement is valid or not.
      *
@@ -901,6 +1179,40 @@ namespace Portage {
     void toggle_displacement_check(bool enable) { displacement_check = enable; }
 
 #ifdef PORTAGE_HAS_TANGRAM
+    /**
+     * @brief Precompute the cutting planes of the face groups of mixed cells.
+     *
+     * The plane clipping a swept region off a face group only depends on
+     * the geometry, not on the material. Hence it is computed once here for
+     * all materials and reused by 'compute_face_group_moments'. All faces of
+     * a cell are processed together so that the cell matpoly is built only
+     * once, and cells are processed in parallel. The planes are shared by
+     * copies of this intersector. Faces for which no valid plane is found
+     * are left to 'compute_face_group_moments' which reports the error.
+     */
+    void cache_face_group_cuts() {
+
+      if (interface_reconstructor == nullptr or face_group_cuts_ != nullptr)
+        return;
+
+      auto const& cmp_ptrs = interface_reconstructor->cell_matpoly_ptrs();
+      int const nb_ptrs = cmp_ptrs.size();
+      int const nb_cells = source_mesh_.num_entities(Entity_kind::CELL,
+                                                     Entity_type::ALL);
+
+      auto cuts = std::make_shared<std::vector<std::vector<FaceGroupCut>>>(nb_cells);
+
+      Wonton::for_each(source_mesh_.begin(Entity_kind::CELL, Entity_type::ALL),
+                       source_mesh_.end(Entity_kind::CELL, Entity_type::ALL),
+                       [&](int c) {
+                         if (c < nb_ptrs and cmp_ptrs[c] != nullptr
+                             and cmp_ptrs[c]->num_materials() > 1)
+                           (*cuts)[c] = compute_face_group_cuts(c);
+                       });
+
+      face_group_cuts_ = cuts;
+    }
+
     /**
      * @brief For a given cell and its face finds the moments associated with the
      * intersection of the swept region and MatPoly's with material_id_ that belong
@@ -926,43 +1238,35 @@ namespace Portage {
       if (swept_volume < vol_tol) {
         throw std::runtime_error("Volume taken out of the face group shold NOT be below the volume tolerance used during interface reconstruction!");
       }
-      
-      std::vector<int> cfaces, cfdirs;
-      source_mesh_.cell_get_faces_and_dirs(cell_id, &cfaces, &cfdirs);
-
-      int cface_id = std::distance(
-        cfaces.begin(), std::find(cfaces.begin(), cfaces.end(), face_group_id));
-#ifndef NDEBUG
-      //Face group should be associated with one of the cell's faces
-      int nfaces = cfaces.size();
-      assert(cface_id != nfaces);
-#endif
 
-      //Create a MatPoly for the cell
-      Tangram::MatPoly<3> cell_mp;
-      Tangram::cell_get_matpoly(source_mesh_, cell_id, &cell_mp, dst_tol);
-      cell_mp.set_mat_id(0);
-      //Get the face normal and MatPoly's in the face's group
-      std::vector<Tangram::MatPoly<3>> face_group_polys;
       Tangram::Plane_t<3> cutting_plane;
-      //Normals to MatPoly faces always point outward, so we have to reverse them
-      //in order to clip the corresponding face group
-      cutting_plane.normal = 
-        -cell_mp.face_normal_and_group(cface_id, face_group_id, &face_group_polys);
 
-      //Find the cutting distance for the given swept volume
-      Tangram::CuttingDistanceSolver<3, Matpoly_Clipper> cds(face_group_polys,
-        cutting_plane.normal, ims_tols[0], true);
+      FaceGroupCut const* cached = find_face_group_cut(cell_id, face_group_id);
+      if (cached != nullptr) {
+        cutting_plane = cached->plane;
+      } else {
+        std::vector<int> cfaces, cfdirs;
+        source_mesh_.cell_get_faces_and_dirs(cell_id, &cfaces, &cfdirs);
 
-      cds.set_target_volume(swept_volume);
-      std::vector<double> cds_res = cds();
+        int cface_id = std::distance(
+          cfaces.begin(), std::find(cfaces.begin(), cfaces.end(), face_group_id));
+#ifndef NDEBUG
+        //Face group should be associated with one of the cell's faces
+        int nfaces = cfaces.size();
+        assert(cface_id != nfaces);
+#endif
 
-      //Check if we had enough volume in the face group
-      if (cds_res[1] < swept_volume - vol_tol) {
-        throw std::runtime_error("Mesh displacement is too big for the implemented swept-face method");
-      }
+        //Create a MatPoly for the cell
+        Tangram::MatPoly<3> cell_mp;
+        Tangram::cell_get_matpoly(source_mesh_, cell_id, &cell_mp, dst_tol);
+        cell_mp.set_mat_id(0);
 
-      cutting_plane.dist2origin = cds_res[0];
+        //Check if we had enough volume in the face group
+        if (!solve_cutting_plane(cell_mp, cface_id, face_group_id,
+                                 swept_volume, &cutting_plane)) {
+          throw std::runtime_error("Mesh displacement is too big for the implemented swept-face method");
+        }
+      }
 
       //Get the face group MatPoly's with material_id_ from the reconstructor
       Tangram::CellMatPoly<3> const& cellmatpoly =
@@ -978,6 +1282,106 @@ namespace Portage {
 
       return moments;
     }
+
+  private:
+
+    /**
+     * @brief Find the plane clipping the given volume off a face group.
+     *
+     * @param cell_mp: matpoly of the whole cell.
+     * @param cface_id: local index of the face in the cell.
+     * @param face_group_id: index of the cell's face group.
+     * @param swept_volume: volume to clip off the face group.
+     * @param cutting_plane: the resulting plane.
+     * @return true if the face group contains enough volume.
+     */
+    bool solve_cutting_plane(Tangram::MatPoly<3> const& cell_mp,
+                             int cface_id, int face_group_id,
+                             double swept_volume,
+                             Tangram::Plane_t<3>* cutting_plane) const {
+
+      const std::vector<Tangram::IterativeMethodTolerances_t>& ims_tols =
+        interface_reconstructor->iterative_methods_tolerances();
+      double vol_tol = ims_tols[0].fun_eps;
+
+      //Get the face normal and MatPoly's in the face's group
+      std::vector<Tangram::MatPoly<3>> face_group_polys;
+      //Normals to MatPoly faces always point outward, so we have to reverse them
+      //in order to clip the corresponding face group
+      cutting_plane->normal =
+        -cell_mp.face_normal_and_group(cface_id, face_group_id, &face_group_polys);
+
+      //Find the cutting distance for the given swept volume
+      Tangram::CuttingDistanceSolver<3, Matpoly_Clipper> cds(face_group_polys,
+        cutting_plane->normal, ims_tols[0], true);
+
+      cds.set_target_volume(swept_volume);
+      std::vector<double> cds_res = cds();
+
+      cutting_plane->dist2origin = cds_res[0];
+      return cds_res[1] >= swept_volume - vol_tol;
+    }
+
+    /**
+     * @brief Compute the cutting planes of the face groups of a mixed cell
+     *        through which it loses volume.
+     *
+     * @param cell_id: index of the cell.
+     * @return the cutting plane of each such face.
+     */
+    std::vector<FaceGroupCut> compute_face_group_cuts(int cell_id) const {
+
+      const std::vector<Tangram::IterativeMethodTolerances_t>& ims_tols =
+        interface_reconstructor->iterative_methods_tolerances();
+      double dst_tol = ims_tols[0].arg_eps;
+      double vol_tol = ims_tols[0].fun_eps;
+
+      std::vector<int> cfaces, cfdirs;
+      source_mesh_.cell_get_faces_and_dirs(cell_id, &cfaces, &cfdirs);
+      int const nfaces = cfaces.size();
+
+      std::vector<FaceGroupCut> cuts;
+      Tangram::MatPoly<3> cell_mp;
+      bool cell_mp_built = false;
+
+      for (int i = 0; i < nfaces; ++i) {
+        // only swept regions lying inside the cell are clipped off its face groups
+        double const swept_volume = -compute_swept_moments(cfaces[i], cfdirs[i])[0];
+        if (swept_volume < num_tols_.min_absolute_volume or swept_volume < vol_tol)
+          continue;
+
+        // the cell matpoly is shared by all its faces
+        if (not cell_mp_built) {
+          Tangram::cell_get_matpoly(source_mesh_, cell_id, &cell_mp, dst_tol);
+          cell_mp.set_mat_id(0);
+          cell_mp_built = true;
+        }
+
+        FaceGroupCut cut;
+        cut.face = cfaces[i];
+        if (solve_cutting_plane(cell_mp, i, cfaces[i], swept_volume, &cut.plane))
+          cuts.emplace_back(cut);
+      }
+      return cuts;
+    }
+
+    /**
+     * @brief Retrieve the precomputed cutting plane of a face group.
+     *
+     * @param cell_id: index of the cell.
+     * @param face_group_id: index of the cell's face group.
+     * @return the cached cut or nullptr if not available.
+     */
+    FaceGroupCut const* find_face_group_cut(int cell_id, int face_group_id) const {
+      if (face_group_cuts_ == nullptr)
+        return nullptr;
+      for (auto const& cut : (*face_group_cuts_)[cell_id])
+        if (cut.face == face_group_id)
+          return &cut;
+      return nullptr;
+    }
+
+  public:
 #endif
 
     /**
@@ -1053,7 +1457,7 @@ namespace Portage {
         }
       }
 #endif
-      std::vector<int> faces, dirs, nodes;
+      std::vector<int> faces, dirs;
 
       // retrieve current source cell faces/edges and related directions
       source_mesh_.cell_get_faces_and_dirs(source_id, &faces, &dirs);
@@ -1061,7 +1465,7 @@ namespace Portage {
 
 #ifndef NDEBUG
         // ensure that we have the same face index for source and target.
-        std::vector<int> target_faces, target_dirs, target_nodes;
+        std::vector<int> target_faces, target_dirs;
         target_mesh_.cell_get_faces_and_dirs(target_id, &target_faces, &target_dirs);
         int const nb_target_faces = target_faces.size();
 
@@ -1072,115 +1476,9 @@ namespace Portage {
 #endif
 
       for (int i = 0; i < nb_faces; ++i) {
-        // step 0: retrieve nodes and reorder them according to face orientation
-        nodes.clear();
-        source_mesh_.face_get_nodes(faces[i], &nodes);
-
-        int const nb_face_nodes = nodes.size();
-        int const nb_poly_nodes = 2 * nb_face_nodes;
-        int const nb_poly_faces = nb_poly_nodes + 2;
-
-#ifndef NDEBUG
-          // ensure that we have the same nodal indices for source and target.
-          target_mesh_.face_get_nodes(target_faces[i], &target_nodes);
-          int const nb_source_nodes = nodes.size();
-          int const nb_target_nodes = target_nodes.size();
-
-          assert(nb_source_nodes == nb_target_nodes);
-          for (int j = 0; j < nb_target_nodes; ++j) {
-            assert(nodes[j] == target_nodes[j]);
-          }
-#endif
-
-        /* step 1: construct the swept volume polyhedron which can be:
-          * - a prism for a triangular face,
-          * - a hexahedron for a quadrilateral face,
-          * - a (n+2)-face polyhedron for an arbitrary n-polygon.
-          */
-        std::vector<Wonton::Point<3>> swept_poly_coords(nb_poly_nodes);
-        std::vector<std::vector<int>> swept_poly_faces(nb_poly_faces);
-
-        /* the swept polyhedron must be formed in a way that the vertices of
-          * each of its faces are ordered such that their normals outside that
-          * swept volume - this is necessarily true except for the original face
-          * inherited from the cell itself.
-          * for this face, if the ordering of its vertices is such that the normal
-          * points out of the cell, then the normal points into the swept volume.
-          * in such a case, the vertex ordering must be reversed.
-          *
-          *   source hex        target hex       face swept polyhedron:
-          *                     7'......6'
-          *                      .:    .:             4'......5'
-          *    7______6         . :   . :             /:    /:
-          *    /|    /|      4'...:..5' :            / :   / :
-          *   / |   / |       :   :..:..2'          /  :  /  :  
-          * 4 __|__5  |       :  .   :  .         4____:_5...:
-          * |   3__|__2       : .    : .          |   /0'|  /1'
-          * |  /   |  /       :......:            |  /   | /
-          * | /    | /        0'     1'           | /    |/
-          * |/_____|/                             |/_____/
-          * 0      1                              0      1
-          *                                 ∙dirs[f] > 0: [4,5,1,0,4',5',1',0']
-          *                                 ∙dirs[f] < 0: [0,1,5,4,0',1',5',4']
-          */
-        bool const outward_normal = dirs[i] > 0;
-
-        for (int current = 0; current < nb_face_nodes; ++current) {
-          int const reverse = (nb_face_nodes - 1) - current;
-          int const index   = (outward_normal ? reverse : current);
-          int const offset  = current + nb_face_nodes;
-          source_mesh_.node_get_coordinates(nodes[index], swept_poly_coords.data() + current);
-          target_mesh_.node_get_coordinates(nodes[index], swept_poly_coords.data() + offset);
-        }
-
-        /* now build the swept polyhedron faces, which vertices are indexed
-          * RELATIVELY to the polyhedron vertices list.
-          * - first allocate memory for vertices list of each face.
-          * - then add the original face and its twin induced by sweeping.
-          * - eventually construct the other faces induced by edge sweeping.
-          */
-        for (int current = 0; current < nb_poly_faces; ++current) {
-          // for each twin face induced by sweeping, its number of vertices is
-          // exactly that of the current cell face, whereas the number of
-          // vertices of the other faces is exactly 4.
-          int const size = (current < 2 ? nb_face_nodes : 4);
-          swept_poly_faces[current].resize(size);
-        }
-
-
-        /* swept polyhedron face construction rules:
-          *
-          *       3'_____2'     n_poly_faces: 2 + n_face_edges = 2 + 4 = 6.
-          *       /|    /|      n_poly_nodes: 2 * n_face_edges = 2 * 4 = 8 = n.
-          *      / |   / |      ordered vertex list: [3,2,1,0,3',2',1',0']
-          *     /  |__/__|
-          *    /  /  /  / 1'             absolute         relative
-          *  3___/_2/  /        ∙f[0]: (3 |2 |1 |0 )      (0,1,2,3)
-          *  |  /  |  /         ∙f[1]: (3'|2'|1'|0')      (4,5,6,7)
-          *  | /   | /          ∙f[2]: (3 |3'|2'|2 )  =>  (0,4,5,1)
-          *  |/____|/           ∙f[3]: (2 |2'|1'|1 )      (1,5,6,2)
-          *  0     1            ∙f[4]: (1 |1'|0'|0 )      (2,6,7,3)
-          *                     ∙f[5]: (0 |0'|3'|3 )      (3,7,4,0)
-          *
-          *  let m = n/2 with n the number of polyhedron vertices.
-          *  - twin faces: [0, m-1] and [m-1, n].
-          *  - side faces: [i, i+m, ((i+1) % m)+m, (i+1) % m]
-          */
-        for (int current = 0; current < nb_face_nodes; ++current) {
-          // a) set twin faces vertices
-          swept_poly_faces[0][current] = current;
-          swept_poly_faces[1][current] = nb_poly_nodes - current - 1;
-
-          // b) set side faces vertices while keeping them counterclockwise.
-          int const index = current + 2;
-          swept_poly_faces[index][0] = current;
-          swept_poly_faces[index][3] = (current + 1) % nb_face_nodes;
-          swept_poly_faces[index][1] = swept_poly_faces[index][0] + nb_face_nodes;
-          swept_poly_faces[index][2] = swept_poly_faces[index][3] + nb_face_nodes;
-        }
-
-        /* step 2: compute swept polygon moments using divergence theorem */
-        auto moments = compute_moments(swept_poly_coords, swept_poly_faces);
+        // step 0-2: construct the swept polyhedron according to the face
+        // orientation and compute its moments.
+        auto moments = compute_swept_moments(faces[i], dirs[i]);
 
         /* step 3: assign the computed moments to the source cell or one
           * of its neighbors according to the sign of the swept region volume.
@@ -1275,6 +1573,7 @@ namespace Portage {
     bool displacement_check = false;
 #ifdef PORTAGE_HAS_TANGRAM
     std::shared_ptr<InterfaceReconstructor3D> interface_reconstructor;
+    std::shared_ptr<std::vector<std::vector<FaceGroupCut>>> face_group_cuts_;
 #endif
   }; // class IntersectSweptFace::3D::CELL
 
@@ -0,0 +1,216 @@
+/*
+This file is part of the Ristra portage project.
+Please see the license file at the root of this repository, or at:
+    https://github.com/laristra/portage/blob/master/LICENSE
+*/
+
+#ifndef PORTAGE_INTERSECT_MATPOLY_CACHE_H_
+#define PORTAGE_INTERSECT_MATPOLY_CACHE_H_
+
+#include <memory>
+#include <vector>
+
+#include "wonton/support/wonton.h"
+#include "wonton/support/Point.h"
+
+#include "portage/support/portage.h"
+
+#ifdef PORTAGE_HAS_TANGRAM
+#include "tangram/driver/CellMatPoly.h"
+#include "tangram/support/MatPoly.h"
+#include "portage/intersect/intersect_polys_r3d.h"
+
+namespace Portage {
+
+/**
+ * @brief Representation of a material polytope as consumed by the
+ *        r2d/r3d intersection kernels.
+ *
+ * @tparam D: spatial dimension.
+ */
+template<int D>
+struct cached_polytope {};
+
+template<>
+struct cached_polytope<2> {
+  using type = std::vector<Wonton::Point<2>>;
+  static type convert(Tangram::MatPoly<2> const& matpoly) {
+    return matpoly.points();
+  }
+};
+
+template<>
+struct cached_polytope<3> {
+  using type = facetedpoly_t;
+  static type convert(Tangram::MatPoly<3> const& matpoly) {
+    return get_faceted_matpoly(matpoly);
+  }
+};
+
+/**
+ * @class MatPolyCache matpoly_cache.h
+ * @brief Per-remap cache of the material polytopes of mixed source cells.
+ *
+ * Material polytopes returned by the interface reconstructor are rebuilt
+ * on each 'get_matpolys' call, and their moments are integrated again by
+ * each consumer. This cache is filled once after interface reconstruction
+ * and stores, for each (cell, material) pair of a mixed cell, the polytopes
+ * in the form expected by the intersectors, their aggregated moments and
+ * their vertices. It is then shared by the intersection, gradient and
+ * interpolation phases of the remap.
+ *
+ * Pure cells are not stored since they are handled through the mesh.
+ *
+ * @tparam D: spatial dimension.
+ */
+template<int D>
+class MatPolyCache {
+
+public:
+  using Polytope = typename cached_polytope<D>::type;
+
+  /** data cached for a material in a mixed cell */
+  struct Entry {
+    int material = -1;
+    /** material polytopes ready for intersection */
+    std::vector<Polytope> polytopes {};
+    /** aggregated volume and first moments of the polytopes */
+    std::vector<double> moments {};
+    /** vertices of all the polytopes */
+    std::vector<Wonton::Point<D>> points {};
+  };
+
+  MatPolyCache() = default;
+
+  /**
+   * @brief Fill the cache from a completed interface reconstruction.
+   *
+   * @tparam Mesh: source mesh wrapper type.
+   * @tparam InterfaceReconstructor: interface reconstructor driver type.
+   * @param mesh: source mesh wrapper.
+   * @param reconstructor: interface reconstructor after 'reconstruct'.
+   */
+  template<class Mesh, class InterfaceReconstructor>
+  void build(Mesh const& mesh, InterfaceReconstructor const& reconstructor) {
+
+    auto const& cmp_ptrs = reconstructor.cell_matpoly_ptrs();
+    int const nb_cells = mesh.num_entities(Wonton::CELL, Wonton::ALL);
+    int const nb_ptrs = cmp_ptrs.size();
+
+    entries_.clear();
+    entries_.resize(nb_cells);
+
+    Wonton::for_each(mesh.begin(Wonton::CELL, Wonton::ALL),
+                     mesh.end(Wonton::CELL, Wonton::ALL),
+                     [&](int c) {
+                       if (c >= nb_ptrs or cmp_ptrs[c] == nullptr)
+                         return;
+
+                       auto const& cellmatpoly = *(cmp_ptrs[c]);
+                       if (cellmatpoly.num_materials() < 2)
+                         return;
+
+                       for (int m : cellmatpoly.cell_matids()) {
+                         Entry entry;
+                         entry.material = m;
+                         entry.moments.assign(D + 1, 0.);
+                         for (auto const& matpoly : cellmatpoly.get_matpolys(m)) {
+                           auto const moments = matpoly.moments();
+                           for (int k = 0; k <= D; k++)
+                             entry.moments[k] += moments[k];
+                           auto const points = matpoly.points();
+                           entry.points.insert(entry.points.end(),
+                                               points.begin(), points.end());
+                           entry.polytopes.emplace_back(
+                             cached_polytope<D>::convert(matpoly));
+                         }
+                         entries_[c].emplace_back(std::move(entry));
+                       }
+                     });
+  }
+
+  /**
+   * @brief Retrieve the cached data of a material in a mixed cell.
+   *
+   * @param cell: source cell index.
+   * @param material: material index.
+   * @return the cached entry or nullptr if the cell is not a mixed
+   *         cell containing the material.
+   */
+  Entry const* find(int cell, int material) const {
+    for (auto const& entry : entries_[cell])
+      if (entry.material == material)
+        return &entry;
+    return nullptr;
+  }
+
+  /**
+   * @brief Retrieve the centroid of a material in a mixed cell.
+   *
+   * @param entry: the cached data of the material in the cell.
+   * @return the centroid of the aggregated material polytopes.
+   */
+  static Wonton::Point<D> centroid(Entry const& entry) {
+    Wonton::Point<D> result;
+    for (int k = 0; k < D; k++)
+      result[k] = entry.moments[k + 1] / entry.moments[0];
+    return result;
+  }
+
+private:
+  /** cached material data per cell, empty for pure cells */
+  std::vector<std::vector<Entry>> entries_ {};
+};
+
+namespace detail {
+
+template<class Functor, class Cache>
+auto attach_matpoly_cache(Functor& functor, Cache const& cache, int)
+  -> decltype(functor.set_matpoly_cache(cache), void()) {
+  functor.set_matpoly_cache(cache);
+}
+
+template<class Functor, class Cache>
+void attach_matpoly_cache(Functor&, Cache const&, long) {}
+
+template<class Functor>
+auto cache_face_group_cuts(Functor& functor, int)
+  -> decltype(functor.cache_face_group_cuts(), void()) {
+  functor.cache_face_group_cuts();
+}
+
+template<class Functor>
+void cache_face_group_cuts(Functor&, long) {}
+
+}  // namespace detail
+
+/**
+ * @brief Hand the material polytopes cache to an intersection, gradient
+ *        or interpolation functor if it is able to use it.
+ *
+ * @param functor: the functor.
+ * @param cache: the material polytopes cache.
+ */
+template<class Functor, int D>
+void attach_matpoly_cache(Functor& functor,
+                          std::shared_ptr<MatPolyCache<D>> const& cache) {
+  detail::attach_matpoly_cache(functor, cache, 0);
+}
+
+/**
+ * @brief Let a swept-face intersector precompute the cutting planes of
+ *        the face groups of mixed cells, once the interface reconstruction
+ *        is done. Other intersectors are left untouched.
+ *
+ * @param functor: the intersector.
+ */
+template<class Functor>
+void cache_face_group_cuts(Functor& functor) {
+  detail::cache_face_group_cuts(functor, 0);
+}
+
+}  // namespace Portage
+
+#endif  // PORTAGE_HAS_TANGRAM
+
+#endif  // PORTAGE_INTERSECT_MATPOLY_CACHE_H_
@@ -3,12 +3,16 @@ This file is part of the Ristra portage project.
 Please see the license file at the root of this repository, or at:
     https://github.com/laristra/portage/blob/master/LICENSE
 */
+#include <array>
+#include <vector>
+
 #include "gtest/gtest.h"
 
 #include "wonton/support/wonton.h"
 #include "wonton/support/Point.h"
 #include "wonton/mesh/jali/jali_mesh_wrapper.h"
 #include "portage/intersect/intersect_clipper.h"
+#include "portage/support/timer.h"
 
 #include "Mesh.hh"
 #include "MeshFactory.hh"
@@ -42,6 +46,92 @@ TEST(intersectClipper, simple){
   ASSERT_EQ(moments[0][2], 1.5);
 }
 
+/*!
+ * @brief Compare the convex fast path against the ClipperLib path on all
+ * overlapping cell pairs of two non-matching meshes, and report timings.
+ */
+TEST(intersectClipper, convex_fast_path) {
+  Jali::MeshFactory mf(MPI_COMM_WORLD);
+  std::shared_ptr<Jali::Mesh> sm = mf(0, 0, 1, 1, 40, 40);
+  std::shared_ptr<Jali::Mesh> tm = mf(0, 0, 1, 1, 27, 27);
+  Wonton::Jali_Mesh_Wrapper s(*sm);
+  Wonton::Jali_Mesh_Wrapper t(*tm);
+
+  int const nb_source = s.num_owned_cells();
+  int const nb_target = t.num_owned_cells();
+
+  // bounding boxes of source cells to skip obviously disjoint pairs
+  std::vector<std::array<double, 4>> boxes(nb_source);
+  for (int c = 0; c < nb_source; c++) {
+    std::vector<Wonton::Point<2>> points;
+    s.cell_get_coordinates(c, &points);
+    boxes[c] = { points[0][0], points[0][1], points[0][0], points[0][1] };
+    for (auto const& p : points) {
+      boxes[c][0] = std::min(boxes[c][0], p[0]);
+      boxes[c][1] = std::min(boxes[c][1], p[1]);
+      boxes[c][2] = std::max(boxes[c][2], p[0]);
+      boxes[c][3] = std::max(boxes[c][3], p[1]);
+    }
+  }
+
+  std::vector<std::pair<int, int>> pairs;
+  for (int c = 0; c < nb_target; c++) {
+    std::vector<Wonton::Point<2>> points;
+    t.cell_get_coordinates(c, &points);
+    double xmin = points[0][0], ymin = points[0][1];
+    double xmax = xmin, ymax = ymin;
+    for (auto const& p : points) {
+      xmin = std::min(xmin, p[0]);
+      ymin = std::min(ymin, p[1]);
+      xmax = std::max(xmax, p[0]);
+      ymax = std::max(ymax, p[1]);
+    }
+    for (int i = 0; i < nb_source; i++) {
+      if (boxes[i][0] < xmax and boxes[i][2] > xmin and
+          boxes[i][1] < ymax and boxes[i][3] > ymin)
+        pairs.emplace_back(i, c);
+    }
+  }
+
+  Portage::IntersectClipper<Wonton::Jali_Mesh_Wrapper> fast(s, t, true);
+  Portage::IntersectClipper<Wonton::Jali_Mesh_Wrapper> slow(s, t, false);
+
+  // sum the moments of each intersection
+  auto reduce = [](std::vector<std::vector<double>> const& moments) {
+    std::array<double, 3> total {0., 0., 0.};
+    for (auto const& m : moments)
+      for (int j = 0; j < 3; j++)
+        total[j] += m[j];
+    return total;
+  };
+
+  int const nb_pairs = pairs.size();
+  std::vector<std::array<double, 3>> fast_moments(nb_pairs);
+  std::vector<std::array<double, 3>> slow_moments(nb_pairs);
+
+  auto tic = timer::now();
+  for (int i = 0; i < nb_pairs; i++)
+    fast_moments[i] = reduce(fast(pairs[i].first, pairs[i].second));
+  float const fast_time = timer::elapsed(tic, true);
+
+  for (int i = 0; i < nb_pairs; i++)
+    slow_moments[i] = reduce(slow(pairs[i].first, pairs[i].second));
+  float const slow_time = timer::elapsed(tic);
+
+  double const eps = 1.e-12;
+  double area = 0.;
+  for (int i = 0; i < nb_pairs; i++) {
+    for (int j = 0; j < 3; j++)
+      ASSERT_NEAR(fast_moments[i][j], slow_moments[i][j], eps);
+    area += fast_moments[i][0];
+  }
+  ASSERT_NEAR(area, 1.0, eps);
+
+  std::cout << "intersected " << nb_pairs << " pairs: ";
+  std::cout << "convex fast path " << fast_time << " s, ";
+  std::cout << "clipper " << slow_time << " s" << std::endl;
+}
+
 //@todo Figure out a way to convert this older test to an intersection test in the current framework
 // TEST(intersectClipper, convex){
 //   std::vector<JaliGeometry::Point> cellA, cellB;
@@ -18,6 +18,7 @@ Please see the license file at the root of this repository, or at:
 // portage includes
 #include "portage/support/portage.h"
 #include "portage/intersect/intersect_r2d.h"
+#include "portage/intersect/intersect_polys_r2d.h"
 
 /*!
  * @brief Intersect two cells on two single cell meshes to compute moments.
@@ -82,3 +83,145 @@ INSTANTIATE_TEST_CASE_P(
   intersectR2D,
   ::testing::Values(Wonton::CoordSysType::Cartesian, Wonton::CoordSysType::CylindricalAxisymmetric));
 
+/*!
+ * @brief Compute the second moments of the intersection of
+ * (0, 0) (2, 0) (2, 2) (0,2) with (1,1) (2,1) (2,2) (1,2).
+ */
+TEST(intersectR2D, second_moments) {
+
+  auto sourcemesh = std::make_shared<Wonton::Simple_Mesh>(0, 0, 2, 2, 1, 1);
+  auto targetmesh = std::make_shared<Wonton::Simple_Mesh>(1, 1, 2, 2, 1, 1);
+
+  const Wonton::Simple_Mesh_Wrapper sm(*sourcemesh);
+  const Wonton::Simple_Mesh_Wrapper tm(*targetmesh);
+
+  auto sourcestate = std::make_shared<Wonton::Simple_State>(sourcemesh);
+  const Wonton::Simple_State_Wrapper ss(*sourcestate);
+
+  Portage::NumericTolerances_t num_tols = Portage::DEFAULT_NUMERIC_TOLERANCES<2>;
+
+  Portage::IntersectR2D<Portage::Entity_kind::CELL,
+                        Wonton::Simple_Mesh_Wrapper,
+                        Wonton::Simple_State_Wrapper,
+                        Wonton::Simple_Mesh_Wrapper,
+                        Portage::DummyInterfaceReconstructor,
+                        void, void, 2>
+      isect{sm, ss, tm, num_tols};
+
+  std::vector<int> srccells({0});
+
+  std::vector<Portage::Weights_t> srcwts = isect(0, srccells);
+  ASSERT_EQ(unsigned(1), srcwts.size());
+  std::vector<double> moments = srcwts[0].weights;
+  ASSERT_EQ(unsigned(6), moments.size());
+
+  double const eps = 1.E-12;
+  ASSERT_NEAR(moments[0], 1.0, eps);
+  ASSERT_NEAR(moments[1], 1.5, eps);
+  ASSERT_NEAR(moments[2], 1.5, eps);
+  ASSERT_NEAR(moments[3], 7./3, eps);   // x^2
+  ASSERT_NEAR(moments[4], 2.25, eps);   // xy
+  ASSERT_NEAR(moments[5], 7./3, eps);   // y^2
+}
+
+
+/*!
+ * @brief Intersect (0, 0) (2, 0) (2, 2) (0,2) with (1,1) (2,1) (2,2) (1,2)
+ * in cylindrical coordinates, with the target treated as convex or not.
+ * Both paths should give the same shifted moments.
+ */
+TEST(intersectR2D, nonconvex_cylindrical) {
+
+  std::vector<Wonton::Point<2>> const source = {{0, 0}, {2, 0}, {2, 2}, {0, 2}};
+  std::vector<Wonton::Point<2>> const target = {{1, 1}, {2, 1}, {2, 2}, {1, 2}};
+
+  auto const sys = Wonton::CoordSysType::CylindricalAxisymmetric;
+  Portage::NumericTolerances_t num_tols = Portage::DEFAULT_NUMERIC_TOLERANCES<2>;
+
+  auto const convex = Portage::intersect_polys_r2d(source, target, num_tols, true, sys);
+  auto const nonconvex = Portage::intersect_polys_r2d(source, target, num_tols, false, sys);
+  ASSERT_EQ(unsigned(3), convex.size());
+  ASSERT_EQ(convex.size(), nonconvex.size());
+
+  double const area = 2 * M_PI * 1.5;
+  double const eps = 1.E-12;
+  ASSERT_NEAR(nonconvex[0], area, eps);
+  ASSERT_NEAR(nonconvex[1], area * 14./9, eps);
+  ASSERT_NEAR(nonconvex[2], area * 1.5, eps);
+  for (int j = 0; j < 3; ++j)
+    ASSERT_NEAR(nonconvex[j], convex[j], eps);
+}
+
+
+/*!
+ * @brief Intersect dual cells of target nodes with the dual cells of
+ * all source nodes, with and without precomputing the dual cells.
+ */
+TEST(intersectR2D, dual_cell_cache) {
+
+  auto sourcemesh = std::make_shared<Wonton::Simple_Mesh>(0, 0, 1, 1, 4, 4);
+  auto targetmesh = std::make_shared<Wonton::Simple_Mesh>(0, 0, 1, 1, 3, 5);
+
+  const Wonton::Simple_Mesh_Wrapper sm(*sourcemesh);
+  const Wonton::Simple_Mesh_Wrapper tm(*targetmesh);
+
+  auto sourcestate = std::make_shared<Wonton::Simple_State>(sourcemesh);
+  const Wonton::Simple_State_Wrapper ss(*sourcestate);
+
+  Portage::NumericTolerances_t num_tols = Portage::DEFAULT_NUMERIC_TOLERANCES<2>;
+
+  using Intersect = Portage::IntersectR2D<Portage::Entity_kind::NODE,
+                                          Wonton::Simple_Mesh_Wrapper,
+                                          Wonton::Simple_State_Wrapper,
+                                          Wonton::Simple_Mesh_Wrapper>;
+
+  Intersect isect{sm, ss, tm, num_tols};
+  Intersect cached_isect{sm, ss, tm, num_tols};
+
+  auto cache = std::make_shared<Portage::DualCellCache<2>>();
+  cache->build(sm, tm, num_tols);
+  Portage::attach_dual_cell_cache(cached_isect, cache);
+
+  int const nsrcnodes = sm.num_entities(Wonton::NODE, Wonton::ALL);
+  int const ntgtnodes = tm.num_entities(Wonton::NODE, Wonton::ALL);
+  std::vector<int> srcnodes(nsrcnodes);
+  for (int n = 0; n < nsrcnodes; n++)
+    srcnodes[n] = n;
+
+  double const eps = 1.E-12;
+  double total_area = 0.0;
+
+  for (int n = 0; n < ntgtnodes; n++) {
+    std::vector<Portage::Weights_t> expected = isect(n, srcnodes);
+    std::vector<Portage::Weights_t> srcwts = cached_isect(n, srcnodes);
+    ASSERT_EQ(expected.size(), srcwts.size());
+
+    for (unsigned i = 0; i < srcwts.size(); i++) {
+      ASSERT_EQ(expected[i].entityID, srcwts[i].entityID);
+      ASSERT_EQ(expected[i].weights.size(), srcwts[i].weights.size());
+      for (unsigned j = 0; j < srcwts[i].weights.size(); j++)
+        ASSERT_NEAR(expected[i].weights[j], srcwts[i].weights[j], eps);
+      total_area += srcwts[i].weights[0];
+    }
+  }
+
+  // dual cells of both meshes tile the unit square
+  ASSERT_NEAR(total_area, 1.0, eps);
+
+  // the gradient phase only needs the dual cells of source nodes
+  Portage::DualCellCache<2> source_cache;
+  source_cache.build_sources(sm, num_tols);
+  ASSERT_TRUE(source_cache.has_sources());
+  ASSERT_FALSE(source_cache.has_targets());
+
+  for (int n = 0; n < nsrcnodes; n++) {
+    std::vector<Wonton::Point<2>> expected;
+    sm.dual_cell_get_coordinates(n, &expected);
+    auto const vertices = source_cache.vertices(n);
+    ASSERT_EQ(static_cast<int>(expected.size()), vertices.size());
+    for (int i = 0; i < vertices.size(); i++) {
+      ASSERT_DOUBLE_EQ(expected[i][0], vertices[i][0]);
+      ASSERT_DOUBLE_EQ(expected[i][1], vertices[i][1]);
+    }
+  }
+}
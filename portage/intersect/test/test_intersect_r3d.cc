@@ -54,6 +54,45 @@ TEST(intersectR3D, simple1) {
   ASSERT_NEAR(moments[3]/moments[0], 1.5, eps);
 }
 
+TEST(intersectR3D, second_moments) {
+  auto sourcemesh = std::make_shared<Wonton::Simple_Mesh>(0, 0, 0, 2, 2, 2, 1, 1, 1);
+  auto targetmesh = std::make_shared<Wonton::Simple_Mesh>(1, 1, 1, 2, 2, 2, 1, 1, 1);
+  const Wonton::Simple_Mesh_Wrapper sm(*sourcemesh);
+  const Wonton::Simple_Mesh_Wrapper tm(*targetmesh);
+
+  auto sourcestate = std::make_shared<Wonton::Simple_State>(sourcemesh);
+  const Wonton::Simple_State_Wrapper ss(*sourcestate);
+
+  const double eps = 1.E-12;
+
+  Portage::NumericTolerances_t num_tols = Portage::DEFAULT_NUMERIC_TOLERANCES<3>;
+
+  const Portage::IntersectR3D<Portage::Entity_kind::CELL,
+                              Wonton::Simple_Mesh_Wrapper,
+                              Wonton::Simple_State_Wrapper,
+                              Wonton::Simple_Mesh_Wrapper,
+                              Portage::DummyInterfaceReconstructor,
+                              void, void, 2> isect{sm, ss, tm, num_tols};
+
+  std::vector<int> srccells({0});
+  const std::vector<Portage::Weights_t> srcwts = isect(0, srccells);
+
+  ASSERT_EQ(unsigned(1), srcwts.size());
+
+  // intersection is the unit cube [1,2]^3
+  auto const moments = srcwts[0].weights;
+  int const num_moments = moments.size();
+
+  ASSERT_EQ(num_moments, 10);
+  ASSERT_NEAR(moments[0], 1.0, eps);
+  for (int j = 1; j < 4; j++)
+    ASSERT_NEAR(moments[j], 1.5, eps);
+  // [x^2, xy, xz, y^2, yz, z^2]
+  double const expected[] = {7./3, 2.25, 2.25, 7./3, 2.25, 7./3};
+  for (int j = 0; j < 6; j++)
+    ASSERT_NEAR(moments[4 + j], expected[j], eps);
+}
+
 TEST(intersectR3D, simple2) {
   auto sourcemesh = std::make_shared<Wonton::Simple_Mesh>(0, 0, 0, 2, 2, 2, 1, 1, 1);
   auto targetmesh = std::make_shared<Wonton::Simple_Mesh>(0, 0, 0, 2, 2, 2, 1, 1, 1);
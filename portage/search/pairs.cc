@@ -6,9 +6,14 @@ Please see the license file at the root of this repository, or at:
 
 #include <cmath>
 #include <cassert>
-#include <list>
 #include <limits>
+#include <numeric>
+#include <stdexcept>
 #include <vector>
+
+#include "wonton/support/wonton.h"
+
+#include "portage/support/bucket_sort.h"
 #include "pairs.hh"
 
 namespace Portage { namespace Meshfree { namespace Pairs {
@@ -55,22 +60,24 @@ namespace Portage { namespace Meshfree { namespace Pairs {
  */
 void CellPairFinder::init(vpile const& in_x, vpile const& in_y,
                           vpile const& in_h, bool in_do_scatter) {
-  x = in_x;
   y = in_y;
   h = in_h;
   dim = in_x.size()[0];
   do_scatter = in_do_scatter;
 
+  if (dim < 1 or dim > max_dim)
+    throw std::runtime_error("CellPairFinder: unsupported dimension");
+
   // get sizes and check
-  ulong nx = x.size()[1];
+  ulong nx = in_x.size()[1];
   ulong ny = y.size()[1];
   assert(y.size()[0] == unsigned(dim));
   assert(h.size()[0] >= unsigned(dim));
   assert(h.size()[1] == (do_scatter ? nx : ny));
 
   // find min and max of enclosing boxes to get bounding box for cells
-  cminmax = (do_scatter ? PairsMinMax(x, h) : PairsMinMax(y, h));
-  delta = cminmax[1] - cminmax[0];
+  vpile cminmax = (do_scatter ? PairsMinMax(in_x, h) : PairsMinMax(y, h));
+  pile cdelta = cminmax[1] - cminmax[0];
 
   // decide on size of grid - this is a maximum value
   ulong maxmemory = (do_scatter ? nx / 10 : ny / 10);
@@ -86,110 +93,108 @@ void CellPairFinder::init(vpile const& in_x, vpile const& in_y,
   havg = (do_scatter ? 4. * havg / (1. * nx) + epsilon
                      : 4. * havg / (1. * ny) + epsilon);
 
-  vulong nsideh(dim);
-  for (int m = 0; m < dim; m++)
-    nsideh[m] = static_cast<size_t>(ceil(delta[m] / havg[m]));
-
-  // set number of cells each coordinate direction
-  vulong nsides(dim);
-  for (int m = 0; m < dim; m++)
-    nsides[m] = std::min<ulong>(nsidemax, nsideh[m]);
+  vindex nsides {};
+  for (int m = 0; m < dim; m++) {
+    cmin[m] = cminmax[0][m];
+    cmax[m] = cminmax[1][m];
+    delta[m] = cdelta[m];
+    // set number of cells each coordinate direction
+    ulong nsideh = static_cast<size_t>(ceil(cdelta[m] / havg[m]));
+    nsides[m] = std::min<ulong>(nsidemax, nsideh);
+    nsidesm[m] = nsides[m] - 1;
+  }
 
   size_t ncells = 1;
   for (int m = 0; m < dim; m++)
     ncells *= nsides[m];
 
-  nsidesm = nsides - static_cast<ulong>(1);
-
-  // allocate grid of lists
-  cells.resize(ncells);
-
   // strides
-  strides.resize(dim);
   strides[dim - 1] = 1;
   for (int m = dim - 2; m >= 0; m--) {
     strides[m] = strides[m + 1] * nsides[m + 1];
   }
 
-  // hash x-corners for scatter form
-  if (do_scatter) {
-    for (ulong i = 0; i < nx; i++) {
+  // bucket the points by a parallel counting sort on the range of
+  // cells of each point, the lists of each cell stay sorted.
+  auto cell_range = [&](ulong i, ulong& first, ulong& last) {
+    if (do_scatter) {
       // get lower left and upper right bounds and indices for source box
-      pile xll(dim), xur(dim);
+      double xll[max_dim] {}, xur[max_dim] {};
       for (int m = 0; m < dim; m++) {
-        xll[m] = x[m][i] - 2. * h[m][i];
-        xur[m] = x[m][i] + 2. * h[m][i];
+        xll[m] = in_x[m][i] - 2. * h[m][i];
+        xur[m] = in_x[m][i] + 2. * h[m][i];
       }
-      vulong ixl(dim), ixu(dim);
-      PairsIntegize(dim, xll, cminmax, delta, nsidesm, ixl);
-      PairsIntegize(dim, xur, cminmax, delta, nsidesm, ixu);
-      size_t ndxll = cellindex(dim, strides, ixl);
-      size_t ndxur = cellindex(dim, strides, ixu) + 1;
-
-      // add x to all cells covered or intersected by this source box
-      for (size_t ndx = ndxll; ndx < ndxur; ndx++) {
-        cells[ndx].push_back(i);
-      }
-    }
-  } else {
-    // hash x-points for gather form
-    for (ulong i = 0; i < nx; i++) {
+      vindex ixl {}, ixu {};
+      PairsIntegize(xll, ixl);
+      PairsIntegize(xur, ixu);
+
+      // x is added to all cells covered or intersected by this source box
+      first = cellindex(ixl);
+      last = cellindex(ixu) + 1;
+    } else {
       // ignore x values outside bounding box
-      bool outside = false;
-      pile xi(dim);
+      double xi[max_dim] {};
       for (int m = 0; m < dim; m++) {
-        if (x[m][i] <= cminmax[0][m] or x[m][i] >= cminmax[1][m]) { outside = true; }
-        xi[m] = x[m][i];
+        if (in_x[m][i] <= cminmax[0][m] or in_x[m][i] >= cminmax[1][m]) { return; }
+        xi[m] = in_x[m][i];
       }
-      if (outside) continue;
 
-      // get cell indices this x
-      vulong ix(dim);
-      PairsIntegize(dim, xi, cminmax, delta, nsidesm, ix);
+      // x is added to the cell containing it
+      vindex ix {};
+      PairsIntegize(xi, ix);
+      first = cellindex(ix);
+      last = first + 1;
+    }
+  };
 
-      // add this x to cell list
-      ulong ndx = cellindex(dim, strides, ix);
-      cells[ndx].push_back(i);
+  bucket_sort<ulong>(nx, ncells, cell_range, cell_offsets, cell_points);
+
+  // copy the coordinates or box corners of each entry next to it
+  ulong const stride = do_scatter ? 2 * dim : dim;
+  cell_coords.resize(cell_points.size() * stride);
+
+  std::vector<ulong> cells(ncells);
+  std::iota(cells.begin(), cells.end(), 0);
+
+  Wonton::for_each(cells.begin(), cells.end(), [&](ulong c) {
+    for (ulong k = cell_offsets[c]; k < cell_offsets[c + 1]; k++) {
+      ulong const i = cell_points[k];
+      double* coords = cell_coords.data() + k * stride;
+      if (do_scatter) {
+        for (int m = 0; m < dim; m++) {
+          coords[m] = in_x[m][i] - 2. * h[m][i];
+          coords[dim + m] = in_x[m][i] + 2. * h[m][i];
+        }
+      } else {
+        for (int m = 0; m < dim; m++)
+          coords[m] = in_x[m][i];
+      }
     }
-  }
+  });
 }
 
 /**
  * @brief Get pairs for target point j, gather case.
  *
  * @param j: current point index.
- * @return a lst of neighbors of the j-th point.
+ * @param neighbors: list of neighbors of the j-th point.
  */
-std::list<ulong> CellPairFinder::find_gather(const ulong j) const {
-  std::list<ulong> pairlist;
+void CellPairFinder::find_gather(const ulong j, std::vector<int>& neighbors) const {
 
   // get cell indices lower left and upper right corners of box
-  pile yll(dim), yur(dim);
+  double yll[max_dim] {}, yur[max_dim] {};
   for (int m = 0; m < dim; m++) {
     yll[m] = y[m][j] - 2. * h[m][j];
     yur[m] = y[m][j] + 2. * h[m][j];
   }
-  vulong iyl(dim), iyu(dim);
-  PairsIntegize(dim, yll, cminmax, delta, nsidesm, iyl);
-  PairsIntegize(dim, yur, cminmax, delta, nsidesm, iyu);
-
-  // total number of cells for this y
-  ulong ncellsy = iyu[dim - 1] - iyl[dim - 1] + 1;
-  vulong ystrides(dim);
-  ystrides[dim - 1] = 1;
-  for (int m = dim - 2; m >= 0; m--) {
-    ystrides[m] = ncellsy;
-    ncellsy *= iyu[m] - iyl[m] + 1;
-  }
+  vindex iyl {}, iyu {};
+  PairsIntegize(yll, iyl);
+  PairsIntegize(yur, iyu);
 
-  // scan cells for this y
-  for (ulong cell = 0; cell < ncellsy; cell++) {
-    // convert local y-cell indices to global cell index
-    vulong yndx(dim);
-    cellindices(dim, ystrides, cell, yndx);
-    vulong cellis(dim);
-    for (int m = 0; m < dim; m++) cellis[m] = iyl[m] + yndx[m];
-    size_t celli = cellindex(dim, strides, cellis);
+  // scan cells for this y, last dimension running fastest
+  vindex cellis = iyl;
+  while (true) {
+    size_t celli = cellindex(cellis);
 
     // determine if in interior or boundary of y-cell
     bool ybndry = false;
@@ -197,77 +202,67 @@ std::list<ulong> CellPairFinder::find_gather(const ulong j) const {
       if (cellis[m] == iyl[m] || cellis[m] == iyu[m]) ybndry = true;
 
     // loop over all x's in this cell's list
-    for (auto&& i : cells[celli]) {
+    for (ulong k = cell_offsets[celli]; k < cell_offsets[celli + 1]; k++) {
       // if on y-cell boundary, check that x's are contained
       bool inside = true;
       if (ybndry) {
+        double const* xk = cell_coords.data() + k * dim;
         for (int m = 0; m < dim; m++) {
-          if (x[m][i] <= yll[m]) inside = false;
-          if (x[m][i] >= yur[m]) inside = false;
+          if (xk[m] <= yll[m]) inside = false;
+          if (xk[m] >= yur[m]) inside = false;
         }
       }
 
       // add pair: put x's in this y-cell onto neighbor list, if inside
       if (inside) {
-        pairlist.push_back(i);
+        neighbors.push_back(static_cast<int>(cell_points[k]));
       }
-    }  // for i
-  }  // for cell
+    }  // for k
 
-  return pairlist;
+    // move to the next cell of the y-box
+    int m = dim - 1;
+    while (m >= 0 and cellis[m] == iyu[m]) {
+      cellis[m] = iyl[m];
+      m--;
+    }
+    if (m < 0)
+      break;
+    cellis[m]++;
+  }  // for cell
 }  // CellPairFinder::find_gather
 
 /**
  * @brief Get pairs for target point j, scatter case.
  *
  * @param j: current point index.
- * @return a lst of neighbors of the j-th point.
+ * @param neighbors: list of neighbors of the j-th point.
  */
-std::list<ulong> CellPairFinder::find_scatter(const ulong j) const {
-  std::list<ulong> pairlist;
-
-  // get a compact representation of this point
-  pile ypt(dim);
-  for (int m = 0; m < dim; m++)
-    ypt[m] = y[m][j];
+void CellPairFinder::find_scatter(const ulong j, std::vector<int>& neighbors) const {
 
-  // check for completely outside source boxes
-  bool outside = false;
+  // get a compact representation of this point and check for
+  // completely outside source boxes
+  double ypt[max_dim] {};
   for (int m = 0; m < dim; m++) {
-    if (y[m][j] <= cminmax[0][m]) {
-      outside = true;
-      break;
-    }
-    if (y[m][j] >= cminmax[1][m]) {
-      outside = true;
-      break;
-    }
+    ypt[m] = y[m][j];
+    if (ypt[m] <= cmin[m] or ypt[m] >= cmax[m])
+      return;
   }
-  if (outside)
-    return pairlist;
 
   // get cell indices of input y-point
-  vulong iy(dim);
-  PairsIntegize(dim, ypt, cminmax, delta, nsidesm, iy);
-  size_t ndx = cellindex(dim, strides, iy);
+  vindex iy {};
+  PairsIntegize(ypt, iy);
+  size_t ndx = cellindex(iy);
 
   // loop over all x's in this y-cell's list
-  for (auto&& i : cells[ndx]) {
+  for (ulong k = cell_offsets[ndx]; k < cell_offsets[ndx + 1]; k++) {
     // get lower left and upper right coords for this x
-    pile xll(dim), xur(dim);
-    for (int m = 0; m < dim; m++) {
-      xll[m] = x[m][i] - 2. * h[m][i];
-      xur[m] = x[m][i] + 2. * h[m][i];
-    }
+    double const* xll = cell_coords.data() + 2 * k * dim;
+    double const* xur = xll + dim;
 
     // check that y is contained
     bool inside = true;
     for (int m = 0; m < dim; m++) {
-      if (y[m][j] <= xll[m]) {
-        inside = false;
-        break;
-      }
-      if (y[m][j] >= xur[m]) {
+      if (ypt[m] <= xll[m] or ypt[m] >= xur[m]) {
         inside = false;
         break;
       }
@@ -275,11 +270,9 @@ std::list<ulong> CellPairFinder::find_scatter(const ulong j) const {
 
     // add pair: put x's in this y-cell onto neighbor list, if inside
     if (inside) {
-      pairlist.push_back(i);
+      neighbors.push_back(static_cast<int>(cell_points[k]));
     }
-  }  // for i
-
-  return pairlist;
+  }  // for k
 }  // CellPairFinder::find_scatter
 
 
@@ -332,56 +325,30 @@ vpile CellPairFinder::PairsMinMax(const vpile &in_c, const pile &in_h) const {
 /**
  * @brief convert real coordinates scaled to unit box to integers in [0,ulong_max]
  *
- * @param in_dim
  * @param in_value
- * @param in_minmax
- * @param in_delta
- * @param in_sizes
  * @param in_ivalue
  */
-void CellPairFinder::PairsIntegize(int in_dim, const pile &in_value,
-                                   const vpile &in_minmax, const pile &in_delta,
-                                   const vulong &in_sizes, vulong &in_ivalue) const {
-  for (int m = 0; m < in_dim; m++) {
-    auto value = in_sizes[m] * (in_value[m] - in_minmax[0][m]) / in_delta[m];
+void CellPairFinder::PairsIntegize(const double* in_value, vindex &in_ivalue) const {
+  for (int m = 0; m < dim; m++) {
+    auto value = nsidesm[m] * (in_value[m] - cmin[m]) / delta[m];
     value = static_cast<ulong>(std::floor(value));
-    in_ivalue[m] = std::max<ulong>(std::min<ulong>(value, in_sizes[m] - 1), 0);
+    in_ivalue[m] = std::max<ulong>(std::min<ulong>(value, nsidesm[m] - 1), 0);
   }
 }
 
 /**
  * @brief Get index from indices.
  *
- * @param in_dim
- * @param in_strides
  * @param in_indices
  * @return
  */
-ulong CellPairFinder::cellindex(int in_dim, const vulong &in_strides,
-                                const vulong &in_indices) const {
+ulong CellPairFinder::cellindex(const vindex &in_indices) const {
   ulong result = 0;
-  for (int m = 0; m < in_dim; m++) {
-    result += in_indices[m] * in_strides[m];
+  for (int m = 0; m < dim; m++) {
+    result += in_indices[m] * strides[m];
   }
   return result;
 }
 
-/**
- * @brief Update indices from base index
- *
- * @param in_dim
- * @param in_strides
- * @param in_index
- * @param in_indices
- */
-void CellPairFinder::cellindices(int in_dim, const vulong &in_strides,
-                                 const ulong &in_index, vulong &in_indices) const {
-  size_t offset = 0;
-  for (int m = 0; m < in_dim; m++) {
-    in_indices[m] = (in_index - offset) / in_strides[m];
-    offset += in_indices[m] * in_strides[m];
-  }
-}
-
 }}} // namespace Portage::Meshfree::Pairs
 
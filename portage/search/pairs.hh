@@ -7,8 +7,8 @@ Please see the license file at the root of this repository, or at:
 #ifndef pairs_INCLUDED
 #define pairs_INCLUDED
 
+#include <array>
 #include <vector>
-#include <list>
 
 #include "pile.hh"
 #include "lretypes.hh"
@@ -67,39 +67,65 @@ public:
   void init(vpile const& in_x, vpile const& in_y,
             vpile const& in_h, bool in_do_scatter);
 
+  /**
+   * @brief Find neighbors of a given point based on containment.
+   *
+   * Neighbors are appended to the given list, which is not cleared
+   * so that callers can reuse its storage across queries.
+   *
+   * @param j: current point index.
+   * @param neighbors: list of neighbors of the j-th point.
+   */
+  void find(ulong j, std::vector<int>& neighbors) const {
+    if (do_scatter)
+      find_scatter(j, neighbors);
+    else
+      find_gather(j, neighbors);
+  }
+
   /**
    * @brief Find neighbors of a given point based on containment.
    *
    * @param j: current point index.
-   * @return a lst of neighbors of the j-th point.
+   * @return a list of neighbors of the j-th point.
    */
-  std::list<ulong> find(ulong j) const {
-    return do_scatter ? find_scatter(j) : find_gather(j);
+  std::vector<int> find(ulong j) const {
+    std::vector<int> neighbors;
+    find(j, neighbors);
+    return neighbors;
   }
 
+  /// maximum spatial dimension supported
+  static constexpr int max_dim = 3;
+
 protected:
-  std::list<ulong> find_gather(ulong j) const;
-  std::list<ulong> find_scatter(ulong j) const;
+  using vindex = std::array<ulong, max_dim>;
+
+  void find_gather(ulong j, std::vector<int>& neighbors) const;
+  void find_scatter(ulong j, std::vector<int>& neighbors) const;
   vpile PairsMinMax(const vpile &in_y, const vpile &in_h) const;
   vpile PairsMinMax(const vpile &in_c, const pile &in_h) const;
-  void PairsIntegize(int in_dim, const pile &in_value,
-                     const vpile &in_minmax, const pile &in_delta,
-                     const vulong &in_sizes, vulong &in_ivalue) const;
-  ulong cellindex(int in_dim, const vulong &in_strides,
-                  const vulong &in_indices) const;
-  void cellindices(int in_dim, const vulong &in_strides,
-                   const ulong &in_index, vulong &in_indices) const;
+  void PairsIntegize(const double* in_value, vindex &in_ivalue) const;
+  ulong cellindex(const vindex &in_indices) const;
 
 
 private:
   int dim = 1;
   bool do_scatter = false;
-  vpile x, y, h;
-  vpile cminmax;
-  pile delta;
-  vulong nsidesm;
-  vulong strides;
-  std::vector<std::vector<ulong>> cells;
+  vpile y, h;
+  std::array<double, max_dim> cmin {};
+  std::array<double, max_dim> cmax {};
+  std::array<double, max_dim> delta {};
+  vindex nsidesm {};
+  vindex strides {};
+
+  /** offsets of each cell in the bucketed lists below */
+  std::vector<ulong> cell_offsets;
+  /** contained points or source boxes sorted by cell */
+  std::vector<ulong> cell_points;
+  /** their coordinates in gather form, or the lower then upper corners
+      of their boxes in scatter form, stored contiguously per entry */
+  std::vector<double> cell_coords;
 };
 
 }}} // namespace Portage::Meshfree::Pairs
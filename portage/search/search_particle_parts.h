@@ -0,0 +1,91 @@
+/*
+ * This file is part of the Ristra portage project.
+ * Please see the license file at the root of this repository, or at:
+ * https://github.com/laristra/portage/blob/master/LICENSE
+ */
+#ifndef PORTAGE_SEARCH_PARTICLE_PARTS_H_
+#define PORTAGE_SEARCH_PARTICLE_PARTS_H_
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "wonton/support/wonton.h"
+
+namespace Portage {
+
+/**
+ * @class SearchParticleParts search_particle_parts.h
+ * @brief Search decorator keeping only the neighbors of a target particle
+ *        that lie in the same part as the target.
+ *
+ * The part of a target particle is the one of the source particle whose
+ * weight function support contains it, which is evaluated on the
+ * neighbors found by the wrapped search. The neighbors of another part
+ * are then removed from the list in place. Since the whole filtering is
+ * done per target particle, it runs within the parallel search itself.
+ *
+ * @tparam Search: the wrapped particle search functor.
+ * @tparam Accumulator: a functor giving the weight of a (target, source)
+ *                      pair, positive within the source part support.
+ */
+template<class Search, class Accumulator>
+class SearchParticleParts {
+
+public:
+  /**
+   * @brief Wrap a search functor.
+   *
+   * @param search: the wrapped particle search functor.
+   * @param accumulator: evaluates the part support of source particles.
+   * @param source_parts: part value of each source particle.
+   * @param tolerance: tolerance on part values.
+   */
+  SearchParticleParts(Search const& search,
+                      Accumulator const& accumulator,
+                      double const* source_parts,
+                      double tolerance)
+    : search_(search),
+      accumulator_(accumulator),
+      source_parts_(source_parts),
+      tolerance_(tolerance) {}
+
+  /**
+   * @brief Find the neighbors of a target particle in the same part.
+   *
+   * @param target: target particle index.
+   * @return the list of its source neighbors in the same part.
+   */
+  std::vector<int> operator()(int target) const {
+
+    std::vector<int> candidates = search_(target);
+
+    // part of the target: no target is expected to lie within several
+    // source supports, if it does the last one is kept.
+    double part = 0.;
+    for (auto it = candidates.rbegin(); it != candidates.rend(); ++it) {
+      if (accumulator_.weight(target, *it) > 0.) {
+        part = source_parts_[*it];
+        break;
+      }
+    }
+
+    // dismiss neighbors that aren't in the same part
+    auto const last = std::remove_if(candidates.begin(), candidates.end(),
+                                     [&](int source) {
+                                       return not (std::abs(part - source_parts_[source]) < tolerance_);
+                                     });
+    candidates.erase(last, candidates.end());
+    return candidates;
+  }
+
+private:
+  Search const& search_;
+  Accumulator const& accumulator_;
+  double const* source_parts_;
+  double tolerance_;
+};
+
+}  // namespace Portage
+
+#endif  // PORTAGE_SEARCH_PARTICLE_PARTS_H_
@@ -10,6 +10,7 @@
 #include "wonton/support/Point.h"
 #include "portage/support/portage.h"
 #include "portage/accumulate/accumulate.h"
+#include "portage/support/bucket_sort.h"
 
 namespace Portage {
 
@@ -149,26 +150,22 @@ public:
     /* --------------------------------------------------------------
      *  step 3: filter source points and push them to the bins
      * --------------------------------------------------------------
-     * After resizing the container, it puts each source point to the
-     * correct bin by hashing its coordinates while discarding those
-     * outside the helper grid extents.
+     * It puts each source point to the correct bin by hashing its
+     * coordinates while discarding those outside the helper grid
+     * extents. Bins are filled by a parallel counting sort and stored
+     * contiguously, each bin listing its points in increasing order.
      */
-    bucket_.resize(num_bins);
-
-    for (int s = 0; s < num_source_points; ++s) {
+    auto bin_range = [&](int s, int& first, int& last) {
       auto const& p = source_swarm.get_particle_coordinates(s);
-      bool inside = true;
       for (int d = 0; d < dim; ++d) {
-        if (p[d] < p_min[d] or p[d] > p_max[d]) {
-          inside = false;
-          break;
-        }
-      }
-      if (inside) {
-        int const i = deduce_bin_index(p);
-        bucket_[i].emplace_back(s);
+        if (p[d] < p_min[d] or p[d] > p_max[d])
+          return;
       }
-    }
+      first = deduce_bin_index(p);
+      last = first + 1;
+    };
+
+    bucket_sort<int>(num_source_points, num_bins, bin_range, offsets_, bins_);
   }
 
   /**
@@ -253,7 +250,8 @@ public:
      */
     std::vector<int> neighbors;
     for (int c : cells) {
-      for (int s : bucket_[c]) {
+      for (int k = offsets_[c]; k < offsets_[c + 1]; ++k) {
+        int const s = bins_[k];
         bool contained = true;
         auto const& q = source_swarm_.get_particle_coordinates(s);
         for (int d = 0; d < dim; ++d) {
@@ -348,8 +346,10 @@ private:
   double radius_scale_ = 1.;
   /** helper grid extents */
   Wonton::Point<dim> orig_, span_;
-  /** source points bins */
-  std::vector<std::vector<int>> bucket_;
+  /** offsets of each bin in the sorted source points list */
+  std::vector<int> offsets_;
+  /** source points sorted by bin */
+  std::vector<int> bins_;
   /** number of edges per axis */
   int num_edges_[dim] {};
 };
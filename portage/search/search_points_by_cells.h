@@ -9,7 +9,6 @@ Please see the license file at the root of this repository, or at:
 #include <memory>
 #include <vector>
 #include <cmath>
-#include <list>
 
 #include "wonton/support/wonton.h"
 #include "wonton/support/Point.h"
@@ -137,8 +136,7 @@ public:
     points in the source swarm.
   */
   std::vector<int> operator() (int pointId) const {
-    auto result = pair_finder_->find(pointId);
-    return std::vector<int>(result.begin(), result.end());
+    return pair_finder_->find(pointId);
   }
 
 private:
@@ -0,0 +1,356 @@
+/*
+ * This file is part of the Ristra portage project.
+ * Please see the license file at the root of this repository, or at:
+ * https://github.com/laristra/portage/blob/master/LICENSE
+ */
+#ifndef PORTAGE_SEARCH_POINTS_KNN_H_
+#define PORTAGE_SEARCH_POINTS_KNN_H_
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <limits>
+#include <queue>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "wonton/support/wonton.h"
+#include "wonton/support/Point.h"
+#include "portage/support/portage.h"
+#include "portage/accumulate/accumulate.h"
+#include "portage/support/bucket_sort.h"
+
+namespace Portage {
+
+using namespace Meshfree;
+
+/**
+ * @class SearchPointsKNN.
+ *
+ * @brief A k-nearest neighbors search for particles.
+ *
+ * Principle:
+ * It retrieves the 'k' nearest source points of each target point,
+ * whatever their smoothing lengths. It bounds the number of neighbors
+ * used by the regression of each target point. It is suited only for
+ * gather weight forms, whose smoothing lengths should then cover the
+ * neighbors found: see 'SwarmDriver::set_adaptive_smoothing'.
+ *
+ * Details:
+ * During the initialization step, it creates a cartesian grid that encloses
+ * all source points with about two points per cell, and puts the source
+ * points into the cells that contain them. To find the neighbors of a
+ * target point, it scans the rings of cells around the cell of the target
+ * point by increasing distance while keeping the 'k' nearest points found.
+ * It stops once the next ring is farther than the current k-th nearest
+ * point. Ties are broken by source index so that results are reproducible.
+ *
+ * @tparam dim: dimension of source/target points.
+ * @tparam SourceSwarm: source point cloud type.
+ * @tparam TargetSwarm: target point cloud type.
+ */
+template<int dim, class SourceSwarm, class TargetSwarm>
+class SearchPointsKNN {
+
+public:
+  /**
+   * @brief Default constructor (disabled).
+   */
+  SearchPointsKNN() = delete;
+
+  /**
+   * @brief Create an instance of the search kernel.
+   *
+   * @param source_swarm: the source points.
+   * @param target_swarm: the target points.
+   * @param source_search_radius: search radius of each source point (unused).
+   * @param target_search_radius: search radius of each target point (unused).
+   * @param center: weight form (gather only)
+   * @param num_neighbors: number of neighbors to retrieve per target point.
+   */
+  SearchPointsKNN(SourceSwarm const& source_swarm,
+                  TargetSwarm const& target_swarm,
+                  Wonton::vector<Wonton::Point<dim>> const& /* unused */,
+                  Wonton::vector<Wonton::Point<dim>> const& /* unused */,
+                  WeightCenter const center = Gather,
+                  int num_neighbors = default_num_neighbors)
+    : source_swarm_(source_swarm),
+      target_swarm_(target_swarm),
+      num_neighbors_(num_neighbors) {
+
+    static_assert(dim > 0 and dim < 4, "invalid dimension");
+
+    if (center == Scatter)
+      throw std::runtime_error("scatter weight form not supported");
+
+    assert(num_neighbors > 0);
+    int const num_source_points = source_swarm.num_particles();
+
+    /* ------------------------------------------------------------
+     *  step 1: create the helper grid from source points.
+     * ------------------------------------------------------------
+     * It encloses the source points in a bounding box, and deduces
+     * a uniform cell size such that there are about two points per
+     * cell. Flat axes get a single cell.
+     */
+    Wonton::Point<dim> p_min, p_max;
+    for (int d = 0; d < dim; ++d) {
+      p_min[d] = std::numeric_limits<double>::max();
+      p_max[d] = std::numeric_limits<double>::lowest();
+    }
+
+    for (int s = 0; s < num_source_points; ++s) {
+      auto const& p = source_swarm.get_particle_coordinates(s);
+      for (int d = 0; d < dim; ++d) {
+        p_min[d] = std::min(p_min[d], p[d]);
+        p_max[d] = std::max(p_max[d], p[d]);
+      }
+    }
+
+    double volume = 1.;
+    int num_flat = 0;
+    for (int d = 0; d < dim; ++d) {
+      orig_[d] = p_min[d];
+      span_[d] = std::max(p_max[d] - p_min[d], 0.);
+      if (span_[d] > 0.)
+        volume *= span_[d];
+      else
+        num_flat++;
+    }
+
+    double const points_per_cell = 2.;
+    double const num_cells = std::max(num_source_points / points_per_cell, 1.);
+    double const step = num_flat < dim
+                        ? std::pow(volume / num_cells, 1. / (dim - num_flat)) : 1.;
+
+    int num_bins = 1;
+    min_step_ = std::numeric_limits<double>::max();
+    for (int d = 0; d < dim; ++d) {
+      num_edges_[d] = span_[d] > 0.
+                      ? std::max(static_cast<int>(std::ceil(span_[d] / step)), 1) : 1;
+      if (span_[d] > 0.)
+        min_step_ = std::min(min_step_, span_[d] / num_edges_[d]);
+      num_bins *= num_edges_[d];
+    }
+
+    if (num_source_points == 0)
+      min_step_ = 0.;
+
+    /* --------------------------------------------------------------
+     *  step 2: push source points to the bins.
+     * --------------------------------------------------------------
+     * Bins are filled by a parallel counting sort and stored
+     * contiguously, each bin listing its points in increasing order.
+     */
+    auto bin_range = [&](int s, int& first, int& last) {
+      auto const& p = source_swarm.get_particle_coordinates(s);
+      first = deduce_bin_index(deduce_cell_index(p));
+      last = first + 1;
+    };
+
+    bucket_sort<int>(num_source_points, num_bins, bin_range, offsets_, bins_);
+  }
+
+  /**
+   * @brief Set the number of neighbors to retrieve per target point.
+   *
+   * @param num_neighbors: number of neighbors.
+   */
+  void set_num_neighbors(int num_neighbors) {
+    assert(num_neighbors > 0);
+    num_neighbors_ = num_neighbors;
+  }
+
+  /**
+   * @brief Get the number of neighbors retrieved per target point.
+   *
+   * @return the number of neighbors.
+   */
+  int num_neighbors() const { return num_neighbors_; }
+
+  /**
+   * @brief Retrieve the k nearest source points of a given target point.
+   *
+   * @param id: the given target point.
+   * @return the list of its nearest source points, in increasing order.
+   */
+  std::vector<int> operator() (int id) const {
+
+    auto const p = target_swarm_.get_particle_coordinates(id);
+    auto const center = deduce_cell_index(p);
+
+    // max-heap on (squared distance, index) of the current k nearest
+    using Entry = std::pair<double, int>;
+    std::vector<Entry> storage;
+    storage.reserve(num_neighbors_ + 1);
+    std::priority_queue<Entry, std::vector<Entry>> nearest(std::less<Entry>(),
+                                                           std::move(storage));
+
+    int max_ring = 0;
+    for (int d = 0; d < dim; ++d)
+      max_ring = std::max(max_ring, std::max(center[d], num_edges_[d] - 1 - center[d]));
+
+    for (int ring = 0; ring <= max_ring; ++ring) {
+
+      // cells of the next rings are at least 'ring' cells away
+      if (static_cast<int>(nearest.size()) == num_neighbors_) {
+        double const bound = ring > 0 ? (ring - 1) * min_step_ : 0.;
+        if (bound * bound > nearest.top().first)
+          break;
+      }
+
+      visit_ring(center, ring, [&](int bin) {
+        for (int k = offsets_[bin]; k < offsets_[bin + 1]; ++k) {
+          int const s = bins_[k];
+          auto const& q = source_swarm_.get_particle_coordinates(s);
+          double distance = 0.;
+          for (int d = 0; d < dim; ++d)
+            distance += (q[d] - p[d]) * (q[d] - p[d]);
+
+          Entry const entry(distance, s);
+          if (static_cast<int>(nearest.size()) < num_neighbors_) {
+            nearest.push(entry);
+          } else if (entry < nearest.top()) {
+            nearest.pop();
+            nearest.push(entry);
+          }
+        }
+      });
+    }
+
+    std::vector<int> neighbors;
+    neighbors.reserve(nearest.size());
+    while (not nearest.empty()) {
+      neighbors.emplace_back(nearest.top().second);
+      nearest.pop();
+    }
+    std::sort(neighbors.begin(), neighbors.end());
+    return neighbors;
+  }
+
+  /** default number of neighbors: twice the size of the quadratic basis */
+  static constexpr int default_num_neighbors = (dim + 1) * (dim + 2);
+
+private:
+  /**
+   * @brief Visit the bins of the cells at a given ring around a cell.
+   *
+   * The ring 'r' is made of the cells whose largest index offset from
+   * the central cell along any axis is exactly 'r'.
+   *
+   * @param center: index of the central cell.
+   * @param ring: ring index.
+   * @param visit: functor called on each bin index.
+   */
+  template<class Visitor>
+  void visit_ring(std::array<int, dim> const& center, int ring, Visitor&& visit) const {
+    std::array<int, dim> first, last;
+    for (int d = 0; d < dim; ++d) {
+      first[d] = std::max(center[d] - ring, 0);
+      last[d]  = std::min(center[d] + ring, num_edges_[d] - 1);
+    }
+
+    std::array<int, dim> cell = first;
+    while (true) {
+      bool on_ring = false;
+      for (int d = 0; d < dim; ++d)
+        on_ring = on_ring or std::abs(cell[d] - center[d]) == ring;
+      if (on_ring)
+        visit(deduce_bin_index(cell));
+
+      // next cell of the box
+      int d = 0;
+      while (d < dim and cell[d] == last[d]) {
+        cell[d] = first[d];
+        d++;
+      }
+      if (d == dim)
+        break;
+      cell[d]++;
+    }
+  }
+
+  /**
+   * @brief Deduce cell indices (i,j,k) from physical coordinates (x,y,z).
+   *
+   * Points outside of the helper grid are assigned the nearest cell.
+   *
+   * @param p: current point coordinates.
+   * @return index of the cell containing the point in helper grid.
+   */
+  std::array<int, dim> deduce_cell_index(Wonton::Point<dim> const& p) const {
+    std::array<int, dim> cell;
+    for (int d = 0; d < dim; ++d) {
+      double const shift = span_[d] > 0. ? (p[d] - orig_[d]) * num_edges_[d] / span_[d] : 0.;
+      int const index = static_cast<int>(std::floor(std::max(shift, 0.)));
+      cell[d] = std::min(index, num_edges_[d] - 1);
+    }
+    return cell;
+  }
+
+  /**
+   * @brief Deduce bin index i' from cell indices (i,j,k).
+   *
+   * @param cell: cell indices.
+   * @return index of the bin in the flat array.
+   */
+  int deduce_bin_index(std::array<int, dim> const& cell) const {
+    switch (dim) {
+      case 1: return cell[0];
+      case 2: return cell[0] + cell[1] * num_edges_[0];
+      case 3: return cell[0] + cell[1] * num_edges_[0] + cell[2] * num_edges_[0] * num_edges_[1];
+      default: return -1;
+    }
+  }
+
+  /** reference to source points */
+  SourceSwarm const& source_swarm_;
+  /** reference to target points */
+  TargetSwarm const& target_swarm_;
+  /** number of neighbors per target point */
+  int num_neighbors_ = default_num_neighbors;
+  /** helper grid extents */
+  Wonton::Point<dim> orig_, span_;
+  /** smallest cell size */
+  double min_step_ = 0.;
+  /** offsets of each bin in the sorted source points list */
+  std::vector<int> offsets_;
+  /** source points sorted by bin */
+  std::vector<int> bins_;
+  /** number of edges per axis */
+  int num_edges_[dim] {};
+};
+
+template<int dim, class SourceSwarm, class TargetSwarm>
+constexpr int SearchPointsKNN<dim, SourceSwarm, TargetSwarm>::default_num_neighbors;
+
+namespace detail {
+
+template<class Search>
+auto set_search_num_neighbors(Search& search, int num_neighbors, int)
+  -> decltype(search.set_num_neighbors(num_neighbors), void()) {
+  search.set_num_neighbors(num_neighbors);
+}
+
+template<class Search>
+void set_search_num_neighbors(Search&, int, long) {}
+
+}  // namespace detail
+
+/**
+ * @brief Set the number of neighbors of a search functor if it
+ *        retrieves a fixed number of neighbors per point.
+ *
+ * @param search: the search functor.
+ * @param num_neighbors: number of neighbors per point.
+ */
+template<class Search>
+void set_search_num_neighbors(Search& search, int num_neighbors) {
+  detail::set_search_num_neighbors(search, num_neighbors, 0);
+}
+
+}  // namespace Portage
+
+#endif  // PORTAGE_SEARCH_POINTS_KNN_H_
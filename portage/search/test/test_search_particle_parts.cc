@@ -0,0 +1,71 @@
+/*
+This file is part of the Ristra portage project.
+Please see the license file at the root of this repository, or at:
+    https://github.com/laristra/portage/blob/master/LICENSE
+*/
+
+#include <cmath>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "wonton/support/wonton.h"
+
+#include "portage/search/search_particle_parts.h"
+
+namespace {
+
+// source particles are the centers of unit cells along the x-axis
+// and target particles are placed at the given abscissas.
+struct LineSearch {
+  std::vector<double> const& targets;
+  int num_sources;
+
+  // sources of the cell of the target and of its two neighbors
+  std::vector<int> operator()(int target) const {
+    std::vector<int> result;
+    int const cell = static_cast<int>(std::floor(targets[target]));
+    for (int s = cell - 1; s <= cell + 1; ++s)
+      if (s >= 0 and s < num_sources)
+        result.push_back(s);
+    return result;
+  }
+};
+
+// step weight: positive if the target lies within the source cell
+struct CellWeight {
+  std::vector<double> const& targets;
+
+  double weight(int target, int source) const {
+    double const x = targets[target];
+    return (x >= source and x < source + 1) ? 1. : 0.;
+  }
+};
+
+}
+
+TEST(SearchParticleParts, Line) {
+
+  // two parts: cells [0,3) and [3,6)
+  std::vector<double> const parts = { 1., 1., 1., 2., 2., 2. };
+  std::vector<double> const targets = { 0.5, 2.5, 3.5, 5.5, 2.9 };
+  int const num_targets = targets.size();
+
+  LineSearch search { targets, 6 };
+  CellWeight accumulator { targets };
+  Portage::SearchParticleParts<LineSearch, CellWeight>
+    search_parts(search, accumulator, parts.data(), 0.5);
+
+  Wonton::vector<std::vector<int>> candidates(num_targets);
+  std::vector<int> ids = { 0, 1, 2, 3, 4 };
+  Wonton::transform(ids.begin(), ids.end(), candidates.begin(), search_parts);
+
+  std::vector<std::vector<int>> const expected = {
+    { 0, 1 }, { 1, 2 }, { 3, 4 }, { 4, 5 }, { 1, 2 }
+  };
+
+  for (int t = 0; t < num_targets; ++t) {
+    std::vector<int> const result = candidates[t];
+    ASSERT_EQ(expected[t], result);
+  }
+}
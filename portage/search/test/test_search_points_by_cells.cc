@@ -699,3 +699,38 @@ TEST(search_by_cells, scatter_2d_random_edge) {
 } // TEST(search_by_cells, scatter_2d_random_edge)
 
 
+
+TEST(search_by_cells, pair_finder_buffer) {
+
+  using namespace Portage::Meshfree::Pairs;
+
+  // 1D gather: 10 points on a line, containing boxes of half-width 0.3
+  // around 3 points, the last one straddling the end of the line
+  int const nx = 10;
+  int const ny = 3;
+  vpile x(1, nx), y(1, ny), h(1, ny);
+  for (int i = 0; i < nx; i++)
+    x[0][i] = 0.25 * i;
+  for (int j = 0; j < ny; j++) {
+    y[0][j] = 0.5 + j;
+    h[0][j] = 0.15;
+  }
+
+  CellPairFinder finder(x, y, h, false);
+
+  // neighbors of all points are appended to the same buffer
+  std::vector<int> buffer;
+  std::vector<int> offsets = {0};
+  for (int j = 0; j < ny; j++) {
+    finder.find(j, buffer);
+    offsets.push_back(buffer.size());
+  }
+
+  std::vector<std::vector<int>> const expected = {{1, 2, 3}, {5, 6, 7}, {9}};
+  for (int j = 0; j < ny; j++) {
+    std::vector<int> list(buffer.begin() + offsets[j],
+                          buffer.begin() + offsets[j + 1]);
+    ASSERT_EQ(expected[j], list);
+    ASSERT_EQ(expected[j], finder.find(j));
+  }
+}
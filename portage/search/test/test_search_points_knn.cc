@@ -0,0 +1,144 @@
+/*
+ * This file is part of the Ristra portage project.
+ * Please see the license file at the root of this repository, or at:
+ * https://github.com/laristra/portage/blob/master/LICENSE
+ */
+
+#include <algorithm>
+#include <random>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "wonton/support/wonton.h"
+#include "wonton/support/Point.h"
+#include "wonton/swarm/swarm.h"
+
+#include "portage/search/search_points_knn.h"
+
+using Portage::Meshfree::Gather;
+using Portage::Meshfree::Scatter;
+
+class SearchKNN : public ::testing::Test {
+protected:
+  /**
+   * @brief Retrieve the k nearest points by brute force.
+   *
+   * @param sources: source points.
+   * @param p: the target point.
+   * @param k: number of neighbors.
+   * @return the sorted list of nearest source points.
+   */
+  template<int dim>
+  static std::vector<int> nearest(Wonton::vector<Wonton::Point<dim>> const& sources,
+                                  Wonton::Point<dim> const& p, int k) {
+    int const num_sources = sources.size();
+    std::vector<std::pair<double, int>> distances(num_sources);
+    for (int s = 0; s < num_sources; ++s) {
+      Wonton::Point<dim> const q = sources[s];
+      double distance = 0.;
+      for (int d = 0; d < dim; ++d)
+        distance += (q[d] - p[d]) * (q[d] - p[d]);
+      distances[s] = { distance, s };
+    }
+
+    int const num_kept = std::min(k, num_sources);
+    std::partial_sort(distances.begin(), distances.begin() + num_kept, distances.end());
+
+    std::vector<int> result(num_kept);
+    for (int i = 0; i < num_kept; ++i)
+      result[i] = distances[i].second;
+    std::sort(result.begin(), result.end());
+    return result;
+  }
+
+  /**
+   * @brief Verify results on random point clouds against brute force.
+   *
+   * @param num_source_points: number of source points.
+   * @param num_target_points: number of target points.
+   * @param k: number of neighbors.
+   */
+  template<int dim>
+  static void test_random(int num_source_points, int num_target_points, int k) {
+
+    using Search = Portage::SearchPointsKNN<dim, Wonton::Swarm<dim>, Wonton::Swarm<dim>>;
+
+    Wonton::vector<Wonton::Point<dim>> source_points(num_source_points);
+    Wonton::vector<Wonton::Point<dim>> target_points(num_target_points);
+    Wonton::vector<Wonton::Point<dim>> unused;
+
+    std::random_device device;
+    std::mt19937 engine { device() };
+    std::uniform_real_distribution<double> generator(0.0, 1.0);
+
+    // targets may lie outside of the source bounding box
+    for (int j = 0; j < num_source_points; ++j) {
+      Wonton::Point<dim> p;
+      for (int d = 0; d < dim; ++d)
+        p[d] = generator(engine);
+      source_points[j] = p;
+    }
+
+    for (int j = 0; j < num_target_points; ++j) {
+      Wonton::Point<dim> p;
+      for (int d = 0; d < dim; ++d)
+        p[d] = 1.4 * generator(engine) - 0.2;
+      target_points[j] = p;
+    }
+
+    Wonton::Swarm<dim> source_swarm(source_points);
+    Wonton::Swarm<dim> target_swarm(target_points);
+
+    Search search(source_swarm, target_swarm, unused, unused, Gather, k);
+
+    for (int i = 0; i < num_target_points; i++) {
+      auto const expected = nearest<dim>(source_points, target_points[i], k);
+      ASSERT_EQ(expected, search(i));
+    }
+  }
+};
+
+TEST_F(SearchKNN, random_2d_case1) { test_random<2>(128, 128, 12); }
+
+TEST_F(SearchKNN, random_2d_case2) { test_random<2>(1000, 256, 6); }
+
+TEST_F(SearchKNN, random_3d_case1) { test_random<3>(1000, 512, 20); }
+
+TEST_F(SearchKNN, random_3d_case2) { test_random<3>(64, 128, 40); }
+
+TEST_F(SearchKNN, fewer_sources) { test_random<2>(5, 16, 12); }
+
+TEST_F(SearchKNN, flat_3d) {
+
+  using Search = Portage::SearchPointsKNN<3, Wonton::Swarm<3>, Wonton::Swarm<3>>;
+
+  // sources on a line: the helper grid is degenerated along y and z
+  Wonton::vector<Wonton::Point<3>> source_points(10);
+  Wonton::vector<Wonton::Point<3>> target_points(1);
+  Wonton::vector<Wonton::Point<3>> unused;
+
+  for (int i = 0; i < 10; ++i)
+    source_points[i] = { double(i), 0., 0. };
+  target_points[0] = { 4.2, 1., -1. };
+
+  Wonton::Swarm<3> source_swarm(source_points);
+  Wonton::Swarm<3> target_swarm(target_points);
+
+  Search search(source_swarm, target_swarm, unused, unused, Gather, 3);
+  ASSERT_EQ(std::vector<int>({ 3, 4, 5 }), search(0));
+
+  search.set_num_neighbors(4);
+  ASSERT_EQ(std::vector<int>({ 3, 4, 5, 6 }), search(0));
+}
+
+TEST_F(SearchKNN, scatter) {
+
+  using Search = Portage::SearchPointsKNN<2, Wonton::Swarm<2>, Wonton::Swarm<2>>;
+
+  Wonton::vector<Wonton::Point<2>> points(4);
+  Wonton::Swarm<2> swarm(points);
+  ASSERT_THROW(Search(swarm, swarm, points, points, Scatter), std::runtime_error);
+}
@@ -0,0 +1,82 @@
+/*
+ * This file is part of the Ristra portage project.
+ * Please see the license file at the root of this repository, or at:
+ * https://github.com/laristra/portage/blob/master/LICENSE
+ */
+#ifndef PORTAGE_SUPPORT_BUCKET_SORT_H_
+#define PORTAGE_SUPPORT_BUCKET_SORT_H_
+
+#include <algorithm>
+#include <atomic>
+#include <numeric>
+#include <vector>
+
+#include "wonton/support/wonton.h"
+
+namespace Portage {
+
+/**
+ * @brief Sort items into bins.
+ *
+ * It is a parallel counting sort: each item is assigned a contiguous
+ * range of bins, the number of items per bin is counted, the offsets
+ * of the bins are deduced by a prefix sum, then the items are placed
+ * in their bins. Counting and placement are threaded and use atomic
+ * counters per bin, so each bin is finally sorted by item index. The
+ * result is then identical to a serial insertion of the items in
+ * increasing order whatever the number of threads.
+ *
+ * @tparam Index: integral type of item and bin indices.
+ * @tparam Range: functor (item, first, last) setting the half-open
+ *                range of bins of the item, empty if it is discarded.
+ * @param num_items: number of items.
+ * @param num_bins: number of bins.
+ * @param range: bins range functor.
+ * @param offsets: offsets of each bin in the sorted items list.
+ * @param items: items sorted by bin.
+ */
+template<class Index, class Range>
+void bucket_sort(Index num_items, Index num_bins, Range const& range,
+                 std::vector<Index>& offsets, std::vector<Index>& items) {
+
+  std::vector<Index> ids(num_items);
+  std::vector<Index> bins(num_bins);
+  std::iota(ids.begin(), ids.end(), Index(0));
+  std::iota(bins.begin(), bins.end(), Index(0));
+
+  // step 1: count items per bin
+  std::vector<Index> first(num_items, 0), last(num_items, 0);
+  std::vector<std::atomic<Index>> counts(num_bins);
+
+  Wonton::for_each(ids.begin(), ids.end(), [&](Index i) {
+    range(i, first[i], last[i]);
+    for (Index b = first[i]; b < last[i]; ++b)
+      counts[b].fetch_add(1, std::memory_order_relaxed);
+  });
+
+  // step 2: deduce offsets, there are far less bins than items
+  offsets.assign(num_bins + 1, 0);
+  for (Index b = 0; b < num_bins; ++b)
+    offsets[b + 1] = offsets[b] + counts[b].load(std::memory_order_relaxed);
+
+  // step 3: place items, counters are reused as insertion cursors
+  Wonton::for_each(bins.begin(), bins.end(), [&](Index b) {
+    counts[b].store(offsets[b], std::memory_order_relaxed);
+  });
+
+  items.resize(offsets[num_bins]);
+
+  Wonton::for_each(ids.begin(), ids.end(), [&](Index i) {
+    for (Index b = first[i]; b < last[i]; ++b)
+      items[counts[b].fetch_add(1, std::memory_order_relaxed)] = i;
+  });
+
+  // step 4: restore the item order within each bin
+  Wonton::for_each(bins.begin(), bins.end(), [&](Index b) {
+    std::sort(items.begin() + offsets[b], items.begin() + offsets[b + 1]);
+  });
+}
+
+}  // namespace Portage
+
+#endif  // PORTAGE_SUPPORT_BUCKET_SORT_H_
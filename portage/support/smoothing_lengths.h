@@ -0,0 +1,276 @@
+/*
+This file is part of the Ristra portage project.
+Please see the license file at the root of this repository, or at:
+    https://github.com/laristra/portage/blob/master/LICENSE
+*/
+#ifndef PORTAGE_SUPPORT_SMOOTHING_LENGTHS_H_
+#define PORTAGE_SUPPORT_SMOOTHING_LENGTHS_H_
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+#include "wonton/support/wonton.h"
+
+namespace Portage { namespace Meshfree {
+
+/**
+ * @class SmoothingLengthArray smoothing_lengths.h
+ * @brief Flat storage of the smoothing lengths of a swarm.
+ *
+ * The smoothing lengths of a particle are made of rows of the same size:
+ * a single row of 'dim' lengths for elliptic and tensor weights, or one
+ * row per facet holding its normal then its smoothing length for faceted
+ * weights. The rows of all particles are stored contiguously. They are
+ * accessed with a fixed stride as long as every particle has the same
+ * number of rows of the same size, and through offsets and per-particle
+ * row counts otherwise, so that elliptic and faceted particles may be
+ * mixed. It replaces the nested vectors of smoothing lengths, from which
+ * it can be implicitly built.
+ */
+class SmoothingLengthArray {
+
+public:
+  /**
+   * @brief Create an empty array.
+   */
+  SmoothingLengthArray() = default;
+
+  /**
+   * @brief Create an empty array with a given row size.
+   *
+   * @param row_size: default number of values per row.
+   */
+  explicit SmoothingLengthArray(int row_size) : row_size_(row_size) {}
+
+  /**
+   * @brief Create an array with the same smoothing lengths for all particles.
+   *
+   * @param num_particles: number of particles.
+   * @param rows: smoothing lengths rows of each particle.
+   */
+  SmoothingLengthArray(std::size_t num_particles,
+                       std::vector<std::vector<double>> const& rows) {
+    std::size_t const num_values = rows.empty() ? 0 : rows.size() * rows[0].size();
+    reserve(num_particles, num_particles * num_values);
+    for (std::size_t i = 0; i < num_particles; i++)
+      push_back(rows);
+  }
+
+  /**
+   * @brief Adapt nested smoothing lengths.
+   *
+   * @param nested: smoothing lengths rows of each particle.
+   */
+  SmoothingLengthArray(Wonton::vector<std::vector<std::vector<double>>> const& nested) {
+    std::size_t const num_particles = nested.size();
+    for (std::size_t i = 0; i < num_particles; i++) {
+      std::vector<std::vector<double>> const rows = nested[i];
+      push_back(rows);
+    }
+  }
+
+  /**
+   * @brief Reserve storage.
+   *
+   * @param num_particles: expected number of particles.
+   * @param num_values: expected total number of values.
+   */
+  void reserve(std::size_t num_particles, std::size_t num_values) {
+    if (not fixed_) {
+      offsets_.reserve(num_particles + 1);
+      rows_.reserve(num_particles);
+    }
+    values_.reserve(num_values);
+  }
+
+  /**
+   * @brief Append the smoothing lengths of a particle.
+   *
+   * @param rows: its smoothing lengths rows, all of the same size.
+   */
+  void push_back(std::vector<std::vector<double>> const& rows) {
+    int const row_size = rows.empty() ? row_size_ : rows[0].size();
+
+    std::vector<double> values;
+    values.reserve(rows.size() * row_size);
+    for (auto const& row : rows) {
+      if (static_cast<int>(row.size()) != row_size)
+        throw std::runtime_error("inconsistent smoothing lengths row size");
+      values.insert(values.end(), row.begin(), row.end());
+    }
+    push_back(values.data(), rows.size(), row_size);
+  }
+
+  /**
+   * @brief Append the smoothing lengths of a particle.
+   *
+   * @param values: its packed rows.
+   * @param num_rows: number of rows.
+   * @param row_size: number of values per row, the default one if negative.
+   */
+  void push_back(double const* values, int num_rows, int row_size = -1) {
+    if (row_size < 0)
+      row_size = row_size_;
+    assert(num_rows == 0 or row_size > 0);
+    std::size_t const num_values = static_cast<std::size_t>(num_rows) * row_size;
+
+    if (num_particles_ == 0) {
+      stride_ = num_values;
+      stride_rows_ = num_rows;
+    }
+
+    if (fixed_ and (num_values != stride_ or num_rows != stride_rows_)) {
+      // switch to variable layout
+      offsets_.resize(num_particles_ + 1);
+      for (std::size_t i = 0; i <= num_particles_; i++)
+        offsets_[i] = i * stride_;
+      rows_.assign(num_particles_, stride_rows_);
+      fixed_ = false;
+    }
+
+    if (num_rows > 0)
+      row_size_ = std::max(row_size_, row_size);
+
+    values_.insert(values_.end(), values, values + num_values);
+    num_particles_++;
+    if (not fixed_) {
+      offsets_.push_back(values_.size());
+      rows_.push_back(num_rows);
+    }
+  }
+
+  /**
+   * @brief Get the number of particles.
+   *
+   * @return the number of particles.
+   */
+  std::size_t size() const { return num_particles_; }
+
+  /**
+   * @brief Check if the array is empty.
+   *
+   * @return true if there is no particle.
+   */
+  bool empty() const { return num_particles_ == 0; }
+
+  /**
+   * @brief Get the largest number of values per row.
+   *
+   * @return the row size.
+   */
+  int row_size() const { return row_size_; }
+
+  /**
+   * @brief Get the number of values per row of a particle.
+   *
+   * @param i: particle index.
+   * @return its row size.
+   */
+  int row_size(int i) const {
+    int const nrows = num_rows(i);
+    return nrows > 0 ? data_size(i) / nrows : row_size_;
+  }
+
+  /**
+   * @brief Check if all particles have the same rows layout.
+   *
+   * @return true if particles are accessed with a fixed stride.
+   */
+  bool fixed_stride() const { return fixed_; }
+
+  /**
+   * @brief Get the number of values of a particle.
+   *
+   * @param i: particle index.
+   * @return its number of values.
+   */
+  int data_size(int i) const {
+    return static_cast<int>(fixed_ ? stride_ : offsets_[i + 1] - offsets_[i]);
+  }
+
+  /**
+   * @brief Get the number of rows of a particle.
+   *
+   * @param i: particle index.
+   * @return its number of rows.
+   */
+  int num_rows(int i) const { return fixed_ ? stride_rows_ : rows_[i]; }
+
+  /**
+   * @brief Get the packed rows of a particle.
+   *
+   * @param i: particle index.
+   * @return a pointer to its first value.
+   */
+  double const* data(int i) const {
+    std::size_t const index = i;
+    return values_.data() + (fixed_ ? index * stride_ : offsets_[index]);
+  }
+
+  /**
+   * @brief Get a smoothing length value.
+   *
+   * @param i: particle index.
+   * @param row: row index.
+   * @param k: value index in the row.
+   * @return the value.
+   */
+  double operator()(int i, int row, int k) const {
+    int const size = row_size(i);
+    assert(row < num_rows(i) and k < size);
+    return data(i)[row * size + k];
+  }
+
+  /**
+   * @brief Get the smoothing lengths rows of a particle.
+   *
+   * @param i: particle index.
+   * @return its rows.
+   */
+  std::vector<std::vector<double>> rows(int i) const {
+    int const nrows = num_rows(i);
+    int const size = row_size(i);
+    double const* values = data(i);
+    std::vector<std::vector<double>> result(nrows);
+    for (int j = 0; j < nrows; j++)
+      result[j].assign(values + j * size, values + (j + 1) * size);
+    return result;
+  }
+
+  /**
+   * @brief Convert back to nested smoothing lengths.
+   *
+   * @return smoothing lengths rows of each particle.
+   */
+  Wonton::vector<std::vector<std::vector<double>>> nested() const {
+    Wonton::vector<std::vector<std::vector<double>>> result(num_particles_);
+    for (std::size_t i = 0; i < num_particles_; i++)
+      result[i] = rows(i);
+    return result;
+  }
+
+private:
+  /** number of particles */
+  std::size_t num_particles_ = 0;
+  /** largest number of values per row */
+  int row_size_ = 0;
+  /** number of values per particle if fixed */
+  std::size_t stride_ = 0;
+  /** number of rows per particle if fixed */
+  int stride_rows_ = 0;
+  /** whether particles have the same rows layout */
+  bool fixed_ = true;
+  /** offsets of each particle values if not fixed */
+  std::vector<std::size_t> offsets_ {};
+  /** number of rows of each particle if not fixed */
+  std::vector<int> rows_ {};
+  /** packed rows of all particles */
+  std::vector<double> values_ {};
+};
+
+}}  // namespace Portage::Meshfree
+
+#endif  // PORTAGE_SUPPORT_SMOOTHING_LENGTHS_H_
@@ -0,0 +1,124 @@
+/*
+This file is part of the Ristra portage project.
+Please see the license file at the root of this repository, or at:
+    https://github.com/laristra/portage/blob/master/LICENSE
+*/
+#include <stdexcept>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "wonton/support/wonton.h"
+
+#include "portage/support/smoothing_lengths.h"
+
+using Portage::Meshfree::SmoothingLengthArray;
+
+// Same rows for all particles are accessed with a fixed stride
+TEST(SmoothingLengths, FixedStride) {
+  std::vector<std::vector<double>> const h = {{1., 2., 3.}};
+  SmoothingLengthArray lengths(4, h);
+
+  ASSERT_EQ(lengths.size(), 4u);
+  ASSERT_EQ(lengths.row_size(), 3);
+  ASSERT_TRUE(lengths.fixed_stride());
+
+  for (int i = 0; i < 4; i++) {
+    ASSERT_EQ(lengths.num_rows(i), 1);
+    ASSERT_EQ(lengths.data_size(i), 3);
+    ASSERT_EQ(lengths.data(i), lengths.data(0) + 3 * i);
+    for (int k = 0; k < 3; k++)
+      ASSERT_DOUBLE_EQ(lengths(i, 0, k), h[0][k]);
+  }
+}
+
+// Particles with different number of facets switch to offsets
+TEST(SmoothingLengths, VariableRows) {
+  Wonton::vector<std::vector<std::vector<double>>> nested(3);
+  nested[0] = {{1., 0., .5}, {0., 1., .5}};
+  nested[1] = {{1., 0., .25}, {0., 1., .25}, {-1., 0., .25}};
+  nested[2] = {{0., -1., .75}};
+
+  SmoothingLengthArray lengths = nested;
+
+  ASSERT_EQ(lengths.size(), 3u);
+  ASSERT_EQ(lengths.row_size(), 3);
+  ASSERT_FALSE(lengths.fixed_stride());
+  ASSERT_EQ(lengths.num_rows(0), 2);
+  ASSERT_EQ(lengths.num_rows(1), 3);
+  ASSERT_EQ(lengths.num_rows(2), 1);
+  ASSERT_EQ(lengths.data(1), lengths.data(0) + 6);
+  ASSERT_EQ(lengths.data(2), lengths.data(1) + 9);
+  ASSERT_DOUBLE_EQ(lengths(1, 2, 0), -1.);
+  ASSERT_DOUBLE_EQ(lengths(2, 0, 2), .75);
+
+  // round trip to nested smoothing lengths
+  auto const result = lengths.nested();
+  ASSERT_EQ(result.size(), nested.size());
+  for (int i = 0; i < 3; i++) {
+    std::vector<std::vector<double>> const expected = nested[i];
+    std::vector<std::vector<double>> const actual = result[i];
+    ASSERT_EQ(actual, expected);
+    ASSERT_EQ(lengths.rows(i), expected);
+  }
+}
+
+// Packed rows can be appended directly
+TEST(SmoothingLengths, PushBack) {
+  SmoothingLengthArray lengths(2);
+  double const values[] = {1., 2., 3., 4.};
+  lengths.push_back(values, 1);
+  lengths.push_back(values + 2, 1);
+  ASSERT_TRUE(lengths.fixed_stride());
+  ASSERT_DOUBLE_EQ(lengths(1, 0, 1), 4.);
+
+  lengths.push_back(values, 2);
+  ASSERT_FALSE(lengths.fixed_stride());
+  ASSERT_EQ(lengths.num_rows(2), 2);
+  ASSERT_DOUBLE_EQ(lengths(2, 1, 0), 3.);
+  ASSERT_DOUBLE_EQ(lengths(0, 0, 0), 1.);
+}
+
+// Elliptic and faceted particles have rows of different sizes
+TEST(SmoothingLengths, MixedRowSizes) {
+  Wonton::vector<std::vector<std::vector<double>>> nested(3);
+  nested[0] = {{.5, .5}};
+  nested[1] = {{1., 0., .25}, {0., 1., .25}};
+  nested[2] = {{.75, .25}};
+
+  SmoothingLengthArray lengths = nested;
+
+  ASSERT_EQ(lengths.size(), 3u);
+  ASSERT_EQ(lengths.row_size(), 3);
+  ASSERT_FALSE(lengths.fixed_stride());
+  ASSERT_EQ(lengths.row_size(0), 2);
+  ASSERT_EQ(lengths.row_size(1), 3);
+  ASSERT_EQ(lengths.row_size(2), 2);
+  ASSERT_EQ(lengths.num_rows(1), 2);
+  ASSERT_EQ(lengths.data_size(1), 6);
+  ASSERT_DOUBLE_EQ(lengths(1, 1, 2), .25);
+  ASSERT_DOUBLE_EQ(lengths(2, 0, 1), .25);
+
+  for (int i = 0; i < 3; i++) {
+    std::vector<std::vector<double>> const expected = nested[i];
+    ASSERT_EQ(lengths.rows(i), expected);
+  }
+
+  // same number of values, but not the same rows
+  SmoothingLengthArray packed(2);
+  double const values[] = {1., 2., 3., 4.};
+  packed.push_back(values, 2);
+  packed.push_back(values, 1, 4);
+  ASSERT_FALSE(packed.fixed_stride());
+  ASSERT_EQ(packed.num_rows(0), 2);
+  ASSERT_EQ(packed.num_rows(1), 1);
+  ASSERT_DOUBLE_EQ(packed(1, 0, 3), 4.);
+}
+
+// Rows of different sizes within a particle are rejected
+TEST(SmoothingLengths, RowSizeMismatch) {
+  SmoothingLengthArray lengths;
+  lengths.push_back({{1., 2.}});
+  ASSERT_NO_THROW(lengths.push_back({{1., 2., 3.}}));
+  ASSERT_THROW(lengths.push_back({{1., 2.}, {3.}}), std::runtime_error);
+}
@@ -5,6 +5,7 @@ Please see the license file at the root of this repository, or at:
 */
 #include <cmath>
 #include <ctime>
+#include <algorithm>
 
 #include "gtest/gtest.h"
 
@@ -187,3 +188,37 @@ INSTANTIATE_TEST_CASE_P(
 INSTANTIATE_TEST_CASE_P(FacetedSupport, WeightTest,
                         Combine(Values(FACETED), Values(POLYRAMP, STEP)));
 
+
+// Check that the statically dispatched evaluators match the generic interface
+TEST(Weight, evaluators) {
+
+  using Portage::Meshfree::Weight::visit;
+
+  Point<2> const x = {0.3, 0.4};
+  vector<vector<double>> const h = {{0.2, 0.25}};
+  vector<vector<double>> const facets = {{-1., 0., 0.2}, {1., 0., 0.2},
+                                         {0., -1., 0.25}, {0., 1., 0.25}};
+
+  for (auto geo : {ELLIPTIC, TENSOR, FACETED}) {
+    auto const& vh = (geo == FACETED ? facets : h);
+    vector<double> data;
+    for (auto const& row : vh)
+      data.insert(data.end(), row.begin(), row.end());
+
+    auto kernels = (geo == FACETED ? vector<Kernel>{POLYRAMP, STEP}
+                                   : vector<Kernel>{B4, SQUARE, EPANECHNIKOV,
+                                                    INVSQRT, COULOMB});
+    for (auto kernel : kernels) {
+      for (int i = 0; i < 100; i++) {
+        Point<2> const y = {x[0] + 0.012 * (i % 10) - 0.06,
+                            x[1] + 0.011 * (i / 10) - 0.05};
+        double const expected = eval<2>(geo, kernel, x, y, vh);
+        double const actual =
+          visit<2>(geo, kernel, [&](auto const& evaluator) {
+            return evaluator(x, y, data.data(), data.size());
+          });
+        ASSERT_NEAR(expected, actual, 1.e-12 * std::max(1., std::abs(expected)));
+      }
+    }
+  }
+}
@@ -10,6 +10,7 @@ Please see the license file at the root of this repository, or at:
 #include <array>
 #include <cassert>
 #include <limits>
+#include <stdexcept>
 #include <vector>
 
 #include "wonton/support/wonton.h"
@@ -478,20 +479,216 @@ double eval(Geometry const geo,
       return eval<dim>(geo, kern, x, y, h);
     }
     case FACETED: {
-      int const nsides = vh.size();
-      std::vector<FacetData<dim>> facets(nsides);
-      for (int i = 0; i < nsides; i++) {
+      assert(kern == POLYRAMP or kern == STEP);
+      double result = 1.;
+      for (auto const& facet : vh) {
+        double arg = 0.;
         for (int j = 0; j < dim; j++)
-          facets[i].normal[j] = vh[i][j];
-        facets[i].smoothing = vh[i][dim];
+          arg += facet[j] * (y[j] - x[j]);
+        result *= kernel(kern, arg / facet[dim]);
       }
-      return faceted<dim>(kern, x, y, facets, nsides);
+      return result;
     }
     default:
       throw std::runtime_error("invalid weight geometry");
   }
 }
 
+//\///////////////////////////////////////////////////////////////////////////
+// statically dispatched evaluation - what the accumulator uses
+//\///////////////////////////////////////////////////////////////////////////
+
+/**
+ * @brief Kernel function selected at compile time.
+ *
+ * @tparam kern: kernel type.
+ */
+template<Kernel kern>
+struct KernelFunction {};
+
+// piecewise form of 'b4' without calls to pow, so that it can be inlined
+template<> struct KernelFunction<B4> {
+  static double value(double x) {
+    double const ax = std::abs(x);
+    if (ax < 1.)
+      return 1. + x * x * (0.75 * ax - 1.5);
+    double const r = ax < 2. ? 2. - ax : 0.;
+    return 0.25 * r * r * r;
+  }
+};
+
+template<> struct KernelFunction<SQUARE> {
+  static double value(double x) { return square(x); }
+};
+
+template<> struct KernelFunction<EPANECHNIKOV> {
+  static double value(double x) { return epanechnikov(x); }
+};
+
+template<> struct KernelFunction<POLYRAMP> {
+  static double value(double x) { return polyramp(x); }
+};
+
+template<> struct KernelFunction<INVSQRT> {
+  static double value(double x) { return invsqrt(x); }
+};
+
+template<> struct KernelFunction<COULOMB> {
+  static double value(double x) { return coulomb(x); }
+};
+
+template<> struct KernelFunction<STEP> {
+  static double value(double x) { return step(x); }
+};
+
+/**
+ * @brief Weight function evaluator with kernel and geometry fixed at
+ *        compile time.
+ *
+ * It evaluates the weight function of a particle from its packed
+ * smoothing lengths rows, as stored in a 'SmoothingLengthArray': the
+ * 'dim' smoothing lengths for elliptic and tensor weights, or the normal
+ * and smoothing length of each facet for faceted ones. The kernel
+ * normalization is computed once on creation.
+ *
+ * @tparam dim: spatial dimension.
+ * @tparam kern: kernel type.
+ * @tparam geo: geometry type.
+ */
+template<int dim, Kernel kern, Geometry geo>
+class Evaluator {};
+
+template<int dim, Kernel kern>
+class Evaluator<dim, kern, ELLIPTIC> {
+public:
+  Evaluator() : scale_(1. / KernelFunction<kern>::value(0.)) {}
+
+  /**
+   * @brief Evaluate the weight function.
+   *
+   * @param x: first point.
+   * @param y: second point.
+   * @param h: packed smoothing lengths.
+   * @return evaluated kernel value.
+   */
+  double operator()(Wonton::Point<dim> const& x,
+                    Wonton::Point<dim> const& y,
+                    double const* h, int /* size */) const {
+    double distance = 0.;
+    for (int i = 0; i < dim; i++) {
+      double const delta = (x[i] - y[i]) / h[i];
+      distance += delta * delta;
+    }
+    return KernelFunction<kern>::value(std::sqrt(distance)) * scale_;
+  }
+
+private:
+  double scale_;
+};
+
+template<int dim, Kernel kern>
+class Evaluator<dim, kern, TENSOR> {
+public:
+  Evaluator() : scale_(1. / KernelFunction<kern>::value(0.)) {}
+
+  /**
+   * @brief Evaluate the weight function.
+   *
+   * @param x: first point.
+   * @param y: second point.
+   * @param h: packed smoothing lengths.
+   * @return evaluated kernel value.
+   */
+  double operator()(Wonton::Point<dim> const& x,
+                    Wonton::Point<dim> const& y,
+                    double const* h, int /* size */) const {
+    double result = 1.;
+    for (int i = 0; i < dim; i++)
+      result *= KernelFunction<kern>::value((x[i] - y[i]) / h[i]) * scale_;
+    return result;
+  }
+
+private:
+  double scale_;
+};
+
+template<int dim, Kernel kern>
+class Evaluator<dim, kern, FACETED> {
+public:
+  /**
+   * @brief Evaluate the weight function.
+   *
+   * @param x: first point.
+   * @param y: second point.
+   * @param facets: packed facets data.
+   * @param size: number of packed values.
+   * @return evaluated kernel value.
+   */
+  double operator()(Wonton::Point<dim> const& x,
+                    Wonton::Point<dim> const& y,
+                    double const* facets, int size) const {
+    double result = 1.;
+    for (int k = 0; k < size; k += dim + 1) {
+      double arg = 0.;
+      for (int j = 0; j < dim; j++)
+        arg += facets[k + j] * (y[j] - x[j]);
+      result *= KernelFunction<kern>::value(arg / facets[k + dim]);
+    }
+    return result;
+  }
+};
+
+/**
+ * @brief Call a visitor with the evaluator matching a kernel.
+ *
+ * @tparam dim: spatial dimension.
+ * @tparam geo: the geometry to consider.
+ * @tparam Visitor: generic functor taking an evaluator.
+ * @param kern: the kernel to consider.
+ * @param visitor: the functor.
+ * @return the value returned by the visitor.
+ */
+template<int dim, Geometry geo, class Visitor>
+auto visit(Kernel const kern, Visitor&& visitor)
+  -> decltype(visitor(Evaluator<dim, B4, geo>())) {
+  switch (kern) {
+    case B4:           return visitor(Evaluator<dim, B4, geo>());
+    case SQUARE:       return visitor(Evaluator<dim, SQUARE, geo>());
+    case EPANECHNIKOV: return visitor(Evaluator<dim, EPANECHNIKOV, geo>());
+    case POLYRAMP:     return visitor(Evaluator<dim, POLYRAMP, geo>());
+    case INVSQRT:      return visitor(Evaluator<dim, INVSQRT, geo>());
+    case COULOMB:      return visitor(Evaluator<dim, COULOMB, geo>());
+    case STEP:         return visitor(Evaluator<dim, STEP, geo>());
+    default:
+      throw std::runtime_error("invalid weight kernel");
+  }
+}
+
+/**
+ * @brief Call a visitor with the evaluator matching a geometry and a kernel.
+ *
+ * It is meant to be called once per run rather than per pair of points:
+ * the visitor then instantiates its loops for the selected evaluator.
+ *
+ * @tparam dim: spatial dimension.
+ * @tparam Visitor: generic functor taking an evaluator.
+ * @param geo: the geometry to consider.
+ * @param kern: the kernel to consider.
+ * @param visitor: the functor.
+ * @return the value returned by the visitor.
+ */
+template<int dim, class Visitor>
+auto visit(Geometry const geo, Kernel const kern, Visitor&& visitor)
+  -> decltype(visitor(Evaluator<dim, B4, ELLIPTIC>())) {
+  switch (geo) {
+    case ELLIPTIC: return visit<dim, ELLIPTIC>(kern, visitor);
+    case TENSOR:   return visit<dim, TENSOR>(kern, visitor);
+    case FACETED:  return visit<dim, FACETED>(kern, visitor);
+    default:
+      throw std::runtime_error("invalid weight geometry");
+  }
+}
+
 }}}  // namespace Portage::Meshfree::Weight
 
 #endif  // PORTAGE_SUPPORT_WEIGHT_H_